@@ -28,11 +28,10 @@ typedef struct
 
 typedef struct
 {
-    UWord32 ac_low_fx;
+    UWord64 ac_low_fx;     /* 24 bit coding window, pending bytes above it */
     UWord32 ac_range_fx;
-    Word16  ac_cache_fx;
-    Word16  ac_carry_fx;
-    Word16  ac_carry_count_fx;
+    Word16  ac_pending_fx; /* number of pending bytes in ac_low_fx */
+    Word16  ac_carry_fx;   /* carry out of the coding window since the last shift */
 } Encoder_State_fx;
 
 typedef struct
@@ -53,6 +52,8 @@ static __forceinline void pc_init_fx(Word16 n_pc, Word16 numbytes, Word16 be_bp_
 static __forceinline Word16 check_pc_bytes(Word16 *bp, Word16 *bp_side, Word16 *mask_side, Word16 cur_bin, Word16 from_left,
                                            Pc_State_fx *pc /* i/o: Pc State */
 );
+static __forceinline Word16 read_res_bit(Bitstream_Backward *bs, Word16 *bp, Word16 *bp_side, Word16 *mask_side,
+                                         Pc_State_fx *pc, Word16 *bit);
 
 static void ac_enc_init_fx(Encoder_State_fx *st_fx /* i/o: Encoder state       */
 );
@@ -60,6 +61,9 @@ static void ac_enc_init_fx(Encoder_State_fx *st_fx /* i/o: Encoder state       *
 static void ac_enc_shift_fx(UWord8 *ptr, Word16 *bp, Encoder_State_fx *st_fx /* i/o: Encoder state       */
 );
 
+static void ac_enc_flush_fx(UWord8 *ptr, Word16 *bp, Encoder_State_fx *st_fx /* i/o: Encoder state       */
+);
+
 static void write_indice_forward(UWord8 *ptr, Word16 bp, Word16 indice, Word16 numbits);
 
 static void ac_encode_fx(UWord8 *ptr, Word16 *bp, Encoder_State_fx *st_fx, /* i/o: Encoder state */
@@ -96,8 +100,9 @@ Word16 processAriEncoder_fx(UWord8 *bytes, Word16 bp_side_in, Word16 mask_side_i
     Dyn_Mem_Deluxe_In(
         Encoder_State_fx st;
         Word16           bp, bp_side, mask_side, extra_bits;
+        Bitstream_Backward bs;
         Word16           a1, b1, a1_i, b1_i;
-        Word16           lev1;
+        Word16           pki;
         Word16           nbits_side;
         Word16           fill_bits;
         UWord8 *         ptr;
@@ -115,11 +120,10 @@ Word16 processAriEncoder_fx(UWord8 *bytes, Word16 bp_side_in, Word16 mask_side_i
     numResBitsEnc = 0; 
     nlsbs         = 0; 
     ptr           = bytes;
-    bp_side       = bp_side_in; 
-    mask_side     = mask_side_in; 
 
     /*Start Encoding*/
     ac_enc_init_fx(&st);
+    bs_write_init(&bs, ptr, bp_side_in, mask_side_in);
 
     /* TNS data */
     FOR (n = 0; n < tns_numfilters; n++)
@@ -139,70 +143,26 @@ Word16 processAriEncoder_fx(UWord8 *bytes, Word16 bp_side_in, Word16 mask_side_i
     IF (lsbMode == 0)
     {
 
-        /*Main Loop through the 2-tuples*/
+        /*Main Loop through the 2-tuples, escapes and lsbs of each level, then the msbs and signs*/
         FOR (k = 0; k < lastnz; k += 2)
         {
-            IF (codingdata[1] < 0)
+            a1 = abs_s(xq[a1_i]);
+            b1 = abs_s(xq[b1_i]);
+            FOR (lev = 0; lev < codingdata[1]; lev++)
             {
-                ac_encode_fx(ptr, &bp, &st, ari_spec_cumfreq[ari_spec_lookup[codingdata[0]]][0],
-                             ari_spec_freq[ari_spec_lookup[codingdata[0]]][0]);
+                pki = ari_spec_lookup[codingdata[0] + Tab_esc_nb[s_min(lev, 3)]];
+                ac_encode_fx(ptr, &bp, &st, ari_spec_cumfreq[pki][VAL_ESC], ari_spec_freq[pki][VAL_ESC]);
+                bs_write(&bs, s_or(s_and(shr_pos(a1, lev), 1), shl_pos(s_and(shr_pos(b1, lev), 1), 1)), 2);
             }
-            ELSE IF (codingdata[1] == 0)
+            pki = ari_spec_lookup[codingdata[0] + Tab_esc_nb[s_min(s_max(codingdata[1], 0), 3)]];
+            ac_encode_fx(ptr, &bp, &st, ari_spec_cumfreq[pki][codingdata[2]], ari_spec_freq[pki][codingdata[2]]);
+            IF (xq[a1_i] != 0)
             {
-                ac_encode_fx(ptr, &bp, &st, ari_spec_cumfreq[ari_spec_lookup[codingdata[0]]][codingdata[2]],
-                             ari_spec_freq[ari_spec_lookup[codingdata[0]]][codingdata[2]]);
-                IF (xq[a1_i] != 0)
-                {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[a1_i], 15));
-                }
-                IF (xq[b1_i] != 0)
-                {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[b1_i], 15));
-                }
+                bs_write(&bs, lshr(xq[a1_i], 15), 1);
             }
-            ELSE IF (sub(codingdata[1], 1) == 0)
-            {
-                ac_encode_fx(ptr, &bp, &st, ari_spec_cumfreq[ari_spec_lookup[codingdata[0]]][VAL_ESC],
-                             ari_spec_freq[ari_spec_lookup[codingdata[0]]][VAL_ESC]);
-                ac_encode_fx(ptr, &bp, &st,
-                             ari_spec_cumfreq[ari_spec_lookup[codingdata[0] + Tab_esc_nb[1]]][codingdata[2]],
-                             ari_spec_freq[ari_spec_lookup[codingdata[0] + Tab_esc_nb[1]]][codingdata[2]]);
-                write_bit_backward(ptr, &bp_side, &mask_side, s_and(xq[a1_i], 1));
-                write_bit_backward(ptr, &bp_side, &mask_side, s_and(xq[b1_i], 1));
-                IF (xq[a1_i] != 0)
-                {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[a1_i], 15));
-                }
-                IF (xq[b1_i] != 0)
-                {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[b1_i], 15));
-                }
-            }
-            ELSE
+            IF (xq[b1_i] != 0)
             {
-                a1 = abs_s(xq[a1_i]);
-                b1 = abs_s(xq[b1_i]);
-                FOR (lev = 0; lev < codingdata[1]; lev++)
-                {
-                    lev1 = s_min(lev, 3);
-                    ac_encode_fx(ptr, &bp, &st,
-                                 ari_spec_cumfreq[ari_spec_lookup[codingdata[0] + Tab_esc_nb[lev1]]][VAL_ESC],
-                                 ari_spec_freq[ari_spec_lookup[codingdata[0] + Tab_esc_nb[lev1]]][VAL_ESC]);
-                    write_bit_backward(ptr, &bp_side, &mask_side, s_and(shr_pos(a1, lev), 1));
-                    write_bit_backward(ptr, &bp_side, &mask_side, s_and(shr_pos(b1, lev), 1));
-                }
-                lev1 = s_min(codingdata[1], 3);
-                ac_encode_fx(ptr, &bp, &st,
-                             ari_spec_cumfreq[ari_spec_lookup[codingdata[0] + Tab_esc_nb[lev1]]][codingdata[2]],
-                             ari_spec_freq[ari_spec_lookup[codingdata[0] + Tab_esc_nb[lev1]]][codingdata[2]]);
-                IF (xq[a1_i] != 0)
-                {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[a1_i], 15));
-                }
-                IF (xq[b1_i] != 0)
-                {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[b1_i], 15));
-                }
+                bs_write(&bs, lshr(xq[b1_i], 15), 1);
             }
 
             a1_i += 2;
@@ -216,7 +176,7 @@ Word16 processAriEncoder_fx(UWord8 *bytes, Word16 bp_side_in, Word16 mask_side_i
 #if BTLLC_5MS_MODE
 		ASSERT(0);
 #else
-		Word16           tmp, a1_msb, b1_msb;
+		Word16           tmp, a1_msb, b1_msb, lev1;
         /*Main Loop through the 2-tuples*/
         FOR (k = 0; k < lastnz; k += 2)
         {
@@ -231,11 +191,11 @@ Word16 processAriEncoder_fx(UWord8 *bytes, Word16 bp_side_in, Word16 mask_side_i
                              ari_spec_freq[ari_spec_lookup[codingdata[0]]][codingdata[2]]);
                 IF (xq[a1_i] != 0)
                 {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[a1_i], 15));
+                    bs_write(&bs, lshr(xq[a1_i], 15), 1);
                 }
                 IF (xq[b1_i] != 0)
                 {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[b1_i], 15));
+                    bs_write(&bs, lshr(xq[b1_i], 15), 1);
                 }
             }
             ELSE IF (sub(codingdata[1], 1) == 0)
@@ -262,7 +222,7 @@ Word16 processAriEncoder_fx(UWord8 *bytes, Word16 bp_side_in, Word16 mask_side_i
                 }
                 IF (a1_msb != 0)
                 {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[a1_i], 15));
+                    bs_write(&bs, lshr(xq[a1_i], 15), 1);
                 }
                 b1_msb       = shr_pos(codingdata[2], 2);
                 tmp          = s_and(xq[b1_i], 1);
@@ -281,7 +241,7 @@ Word16 processAriEncoder_fx(UWord8 *bytes, Word16 bp_side_in, Word16 mask_side_i
                 }
                 IF (b1_msb != 0)
                 {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[b1_i], 15));
+                    bs_write(&bs, lshr(xq[b1_i], 15), 1);
                 }
             }
             ELSE
@@ -326,8 +286,8 @@ Word16 processAriEncoder_fx(UWord8 *bytes, Word16 bp_side_in, Word16 mask_side_i
                     ac_encode_fx(ptr, &bp, &st,
                                  ari_spec_cumfreq[ari_spec_lookup[codingdata[0] + Tab_esc_nb[lev1]]][VAL_ESC],
                                  ari_spec_freq[ari_spec_lookup[codingdata[0] + Tab_esc_nb[lev1]]][VAL_ESC]);
-                    write_bit_backward(ptr, &bp_side, &mask_side, s_and(shr_pos(a1, lev), 1));
-                    write_bit_backward(ptr, &bp_side, &mask_side, s_and(shr_pos(b1, lev), 1));
+                    bs_write(&bs, s_and(shr_pos(a1, lev), 1), 1);
+                    bs_write(&bs, s_and(shr_pos(b1, lev), 1), 1);
                 }
                 lev1 = s_min(codingdata[1], 3);
                 ac_encode_fx(ptr, &bp, &st,
@@ -335,11 +295,11 @@ Word16 processAriEncoder_fx(UWord8 *bytes, Word16 bp_side_in, Word16 mask_side_i
                              ari_spec_freq[ari_spec_lookup[codingdata[0] + Tab_esc_nb[lev1]]][codingdata[2]]);
                 IF (a1_msb != 0)
                 {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[a1_i], 15));
+                    bs_write(&bs, lshr(xq[a1_i], 15), 1);
                 }
                 IF (b1_msb != 0)
                 {
-                    write_bit_backward(ptr, &bp_side, &mask_side, lshr(xq[b1_i], 15));
+                    bs_write(&bs, lshr(xq[b1_i], 15), 1);
                 }
             }
 
@@ -352,27 +312,21 @@ Word16 processAriEncoder_fx(UWord8 *bytes, Word16 bp_side_in, Word16 mask_side_i
     }
 
     /* Side bits (in sync with the decoder) */
+    bs_write_finish(&bs, &bp_side, &mask_side);
     nbits_side = sub(nbbits, add(shl_pos(bp_side, 3), sub(norm_s(mask_side), 6)));
 
     /* Residual bits (in sync with the decoder) */
-    extra_bits = sub(norm_ul(st.ac_range_fx), 6);
-    if (st.ac_cache_fx >= 0)
-    {
-        extra_bits = add(extra_bits, 8);
-    }
-    if (st.ac_carry_count_fx > 0)
-    {
-        extra_bits = add(extra_bits, shl_pos(st.ac_carry_count_fx, 3));
-    }
+    extra_bits = add(sub(norm_ul(st.ac_range_fx), 6), shl_pos(st.ac_pending_fx, 3));
     n = sub(nbbits, add(shl_pos(bp, 3), add(extra_bits, nbits_side))); 
     assert(n >= 0);
 
+    bs_write_init(&bs, ptr, bp_side, mask_side);
     IF (lsbMode == 0)
     {
         numResBitsEnc = s_min(numResBits, n);
         FOR (i = 0; i < numResBitsEnc; i++)
         {
-            write_bit_backward(ptr, &bp_side, &mask_side, (Word16)resBits[i]);
+            bs_write(&bs, (Word16)resBits[i], 1);
         }
     }
     ELSE
@@ -380,9 +334,10 @@ Word16 processAriEncoder_fx(UWord8 *bytes, Word16 bp_side_in, Word16 mask_side_i
         nlsbs = s_min(nlsbs, n);
         FOR (k = 0; k < nlsbs; k++)
         {
-            write_bit_backward(ptr, &bp_side, &mask_side, lsb[k]);
+            bs_write(&bs, lsb[k], 1);
         }
     }
+    bs_write_finish(&bs, &bp_side, &mask_side);
 
     /* End arithmetic coder, overflow management */
     extra_bits = ac_enc_finish_fx(ptr, &bp, &st);
@@ -419,6 +374,7 @@ void processAriDecoder_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wor
     Word16  tmp;
     Counter n, k, lev;
     Counter i;
+    Bitstream_Backward bs;
 
 #ifdef DYNMEM_COUNT
     struct _dynmem
@@ -439,6 +395,7 @@ void processAriDecoder_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wor
         Word16 *lsb_ind;
         Word16  tmp;
         Counter i, n, k, lev;
+        Bitstream_Backward bs;
     };
     Dyn_Mem_In("processAriDecoder_fx", sizeof(struct _dynmem));
 #endif
@@ -930,6 +887,7 @@ void processAriDecoder_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wor
         GOTO ber_detect;
     }
 
+    bs_read_init(&bs, ptr, *bp_side, *mask_side);
     IF (lsbMode == 0)
     {
         *resBits = n; 
@@ -941,11 +899,11 @@ void processAriDecoder_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wor
                 {
                     BREAK;
                 }
-                if (check_pc_bytes(&bp, bp_side, mask_side, st.pc.inv_bin, 0, &st.pc) != 0)
+                if (read_res_bit(&bs, &bp, bp_side, mask_side, &st.pc, &tmp) != 0)
                 {
                     GOTO ber_detect_res;
                 }
-                *resQdata++ = read_bit(ptr, bp_side, mask_side); 
+                *resQdata++ = tmp; 
                 n           = sub(n, 1);
             }
         }
@@ -961,11 +919,10 @@ void processAriDecoder_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wor
             {
                 BREAK;
             }
-            if (check_pc_bytes(&bp, bp_side, mask_side, st.pc.inv_bin, 0, &st.pc) != 0)
+            if (read_res_bit(&bs, &bp, bp_side, mask_side, &st.pc, &tmp) != 0)
             {
                 GOTO ber_detect_res;
             }
-            tmp = read_bit(ptr, bp_side, mask_side);
             n   = sub(n, 1);
             IF (tmp > 0)
             {
@@ -984,11 +941,11 @@ void processAriDecoder_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wor
                         BREAK;
                     }
                     a = 1;
-                    if (check_pc_bytes(&bp, bp_side, mask_side, st.pc.inv_bin, 0, &st.pc) != 0)
+                    if (read_res_bit(&bs, &bp, bp_side, mask_side, &st.pc, &tmp) != 0)
                     {
                         GOTO ber_detect_res;
                     }
-                    if (read_bit(ptr, bp_side, mask_side) != 0)
+                    if (tmp != 0)
                     {
                         a = negate(a);
                     }
@@ -1002,11 +959,10 @@ void processAriDecoder_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wor
             {
                 BREAK;
             }
-            if (check_pc_bytes(&bp, bp_side, mask_side, st.pc.inv_bin, 0, &st.pc) != 0)
+            if (read_res_bit(&bs, &bp, bp_side, mask_side, &st.pc, &tmp) != 0)
             {
                 GOTO ber_detect_res;
             }
-            tmp = read_bit(ptr, bp_side, mask_side);
             n   = sub(n, 1);
             IF (tmp > 0)
             {
@@ -1025,11 +981,11 @@ void processAriDecoder_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wor
                         BREAK;
                     }
                     b = 1;
-                    if (check_pc_bytes(&bp, bp_side, mask_side, st.pc.inv_bin, 0, &st.pc) != 0)
+                    if (read_res_bit(&bs, &bp, bp_side, mask_side, &st.pc, &tmp) != 0)
                     {
                         GOTO ber_detect_res;
                     }
-                    if (read_bit(ptr, bp_side, mask_side) != 0)
+                    if (tmp != 0)
                     {
                         b = negate(b);
                     }
@@ -1040,6 +996,12 @@ void processAriDecoder_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wor
         }
     }
 
+    /* with partial concealment the bits were read through bp_side and mask_side */
+    IF (st.pc.bytes == 0)
+    {
+        bs_read_finish(&bs, bp_side, mask_side);
+    }
+
     /* Noise Filling seed */
     tmp32 = L_deposit_l(0);
     FOR (i = 0; i < L_spec; i++)
@@ -1209,42 +1171,6 @@ Word16 find_last_nz_pair(const Word16 x[], Word16 length)
 }
 
 
-void write_bit_backward(UWord8 *ptr, Word16 *bp, Word16 *mask, Word16 bit)
-{
-    if (bit > 0)
-    {
-        ptr[*bp] = (UWord8)s_or((Word16)ptr[*bp], *mask); 
-    }
-    *mask = lshl_pos(*mask, 1); 
-    if (sub(*mask, 0x100) == 0)
-    {
-        *mask = 1; 
-    }
-    if (sub(*mask, 1) == 0)
-    {
-        *bp = sub(*bp, 1); 
-    }
-}
-
-
-void write_indice_backward(UWord8 *ptr, Word16 *bp, Word16 *mask, Word16 indice, Word16 numbits)
-{
-    Dyn_Mem_Deluxe_In(
-        Counter k;
-        Word16 bit;
-    );
-
-    FOR (k = 0; k < numbits; k++)
-    {
-        bit = s_and(indice, 1);
-        write_bit_backward(ptr, bp, mask, bit);
-        indice = lshr(indice, 1);
-    }
-
-    Dyn_Mem_Deluxe_Out();
-}
-
-
 static __forceinline void write_indice_forward(UWord8 *ptr, Word16 bp, Word16 indice, Word16 numbits)
 {
     Dyn_Mem_Deluxe_In(
@@ -1271,38 +1197,50 @@ static __forceinline void write_indice_forward(UWord8 *ptr, Word16 bp, Word16 in
 
 static __forceinline void ac_enc_init_fx(Encoder_State_fx *st_fx) /* i/o: Encoder state       */
 {
-    st_fx->ac_low_fx         = L_deposit_l(0); 
-    st_fx->ac_range_fx       = 0x00ffffff;     
-    st_fx->ac_cache_fx       = -1;             
-    st_fx->ac_carry_fx       = 0;              
-    st_fx->ac_carry_count_fx = 0;              
+    st_fx->ac_low_fx     = 0;          
+    st_fx->ac_range_fx   = 0x00ffffff; 
+    st_fx->ac_pending_fx = 0;          
+    st_fx->ac_carry_fx   = 0;          
 }
 
-static __forceinline void ac_enc_shift_fx(UWord8 *ptr, Word16 *bp, Encoder_State_fx *st_fx) /* i/o: Encoder state */
+/* Stores the pending bytes. A carry out of them is added to the bytes already stored */
+static __forceinline void ac_enc_flush_fx(UWord8 *ptr, Word16 *bp, Encoder_State_fx *st_fx) /* i/o: Encoder state */
 {
-    test();
-    L_sub(0, 0); /* For comparision in if */
-    IF (st_fx->ac_low_fx < (0x00ff0000UL) || sub(st_fx->ac_carry_fx, 1) == 0)
+    Dyn_Mem_Deluxe_In(
+        Counter k;
+    );
+
+    IF (st_fx->ac_low_fx >> add(24, shl_pos(st_fx->ac_pending_fx, 3)) != 0)
     {
-        IF (st_fx->ac_cache_fx >= 0)
+        FOR (k = sub(*bp, 1); k >= 0 && ptr[k] == 0xff; k--)
         {
-            ptr[(*bp)++] = (UWord8)add(st_fx->ac_cache_fx, st_fx->ac_carry_fx); 
+            ptr[k] = 0; 
         }
-
-        WHILE (st_fx->ac_carry_count_fx > 0)
+        if (k >= 0)
         {
-            ptr[(*bp)++]             = (UWord8)s_and(add(st_fx->ac_carry_fx, 0xff), 255); 
-            st_fx->ac_carry_count_fx = sub(st_fx->ac_carry_count_fx, 1);                  
+            ptr[k] = (UWord8)add(ptr[k], 1); 
         }
-
-        st_fx->ac_cache_fx = u_extract_l(UL_lshr_pos(st_fx->ac_low_fx, 16)); 
-        st_fx->ac_carry_fx = 0;                                              
     }
-    ELSE
+    FOR (k = sub(st_fx->ac_pending_fx, 1); k >= 0; k--)
     {
-        st_fx->ac_carry_count_fx = add(st_fx->ac_carry_count_fx, 1); 
+        ptr[(*bp)++] = (UWord8)(st_fx->ac_low_fx >> add(24, shl_pos(k, 3))); 
+    }
+    st_fx->ac_low_fx &= 0x00ffffff; 
+    st_fx->ac_pending_fx = 0;        
+
+    Dyn_Mem_Deluxe_Out();
+}
+
+/* Moves the top byte of the coding window to the pending bytes, which are stored 32 bits at a time */
+static __forceinline void ac_enc_shift_fx(UWord8 *ptr, Word16 *bp, Encoder_State_fx *st_fx) /* i/o: Encoder state */
+{
+    st_fx->ac_low_fx     = st_fx->ac_low_fx << 8;        
+    st_fx->ac_pending_fx = add(st_fx->ac_pending_fx, 1); 
+    st_fx->ac_carry_fx   = 0;                            
+    if (sub(st_fx->ac_pending_fx, 4) == 0)
+    {
+        ac_enc_flush_fx(ptr, bp, st_fx);
     }
-    st_fx->ac_low_fx = UL_and(UL_lshl_pos(st_fx->ac_low_fx, 8), 0x00ffffff); 
 }
 
 static __forceinline void ac_encode_fx(UWord8 *ptr, Word16 *bp, Encoder_State_fx *st_fx, /* i/o: Encoder state */
@@ -1311,7 +1249,6 @@ static __forceinline void ac_encode_fx(UWord8 *ptr, Word16 *bp, Encoder_State_fx
 {
     Dyn_Mem_Deluxe_In(
         UWord32 r, tmp;
-        UWord16 carry;
     );
 
     r   = UL_lshr_pos(st_fx->ac_range_fx, 10);
@@ -1320,17 +1257,16 @@ static __forceinline void ac_encode_fx(UWord8 *ptr, Word16 *bp, Encoder_State_fx
     assert(r < (1U << 24));
     assert(cum_freq < (1U << 24));
     assert(tmp < (1U << 24));
-    assert(st_fx->ac_low_fx < (1U << 24));
-    st_fx->ac_low_fx = UL_addNs24(st_fx->ac_low_fx, tmp, &carry); 
 
-    if (carry != 0)
+    /* a carry out of the coding window runs into the pending bytes */
+    st_fx->ac_low_fx += tmp; 
+    if (((UWord32)st_fx->ac_low_fx & 0x00ffffff) < tmp)
     {
-        st_fx->ac_carry_fx = carry; 
+        st_fx->ac_carry_fx = 1; 
     }
 
     st_fx->ac_range_fx = UL_Mpy_32_32(r, sym_freq); 
 
-    assert(cum_freq < (1U << 24));
     assert(st_fx->ac_range_fx < (1U << 24));
     WHILE (st_fx->ac_range_fx < (1U << 16))
     {
@@ -1348,18 +1284,21 @@ static __forceinline void ac_encode_fx(UWord8 *ptr, Word16 *bp, Encoder_State_fx
 static __forceinline Word16 ac_enc_finish_fx(UWord8 *ptr, Word16 *bp, Encoder_State_fx *st_fx) /* i/o: Encoder state */
 {
     Dyn_Mem_Deluxe_In(
-        UWord32 val, mask, high;
-        Word16  bits;
+        UWord32 low, val, mask, high;
+        Word16  bits, ff;
         UWord16 over1, over2;
+        Counter k;
     );
 
+    low = (UWord32)st_fx->ac_low_fx & 0x00ffffff;
+
     /*bits = 24 - log2_i(st->ac_range); */
     bits = sub(norm_ul(st_fx->ac_range_fx), 7);
 
     mask = UL_lshr(0x00ffffff, bits);
 
-    val  = UL_addNs24(st_fx->ac_low_fx, mask, &over1);
-    high = UL_addNs24(st_fx->ac_low_fx, st_fx->ac_range_fx, &over2);
+    val  = UL_addNs24(low, mask, &over1);
+    high = UL_addNs24(low, st_fx->ac_range_fx, &over2);
 
     L_xor(0, 0);    /* For bit not */
     UL_and(1U, 1U); /* added counters */
@@ -1373,40 +1312,50 @@ static __forceinline Word16 ac_enc_finish_fx(UWord8 *ptr, Word16 *bp, Encoder_St
         {
             bits = add(bits, 1);
             mask = UL_lshr_pos(mask, 1);
-            val  = UL_and(UL_addNsD(st_fx->ac_low_fx, mask), (~mask) & 0x00ffffff);
+            val  = UL_and(UL_addNsD(low, mask), (~mask) & 0x00ffffff);
             L_xor(0, 0);
             UL_and(1, 1); /* For bit not , mask */
         }
 
-        if (val < st_fx->ac_low_fx)
+        IF (val < low)
         {
-            st_fx->ac_carry_fx = 1; 
+            st_fx->ac_low_fx += 0x01000000; 
+            st_fx->ac_carry_fx = 1;          
         }
     }
 
-    st_fx->ac_low_fx = val; 
+    st_fx->ac_low_fx = st_fx->ac_low_fx - low + val; 
+
+    /* no more carries, the pending bytes are final */
+    ac_enc_flush_fx(ptr, bp, st_fx);
 
+    ff = 0; 
     FOR (; bits > 0; bits -= 8)
     {
+        ff = 0; 
+        test();
+        if (((UWord32)st_fx->ac_low_fx & 0x00ffffff) >= 0x00ff0000 && st_fx->ac_carry_fx == 0)
+        {
+            ff = 1; 
+        }
         ac_enc_shift_fx(ptr, bp, st_fx);
     }
     bits = add(bits, 8);
 
-    assert(st_fx->ac_carry_fx == 0);
-
-    IF (st_fx->ac_carry_count_fx > 0)
+    FOR (k = sub(st_fx->ac_pending_fx, 1); k > 0; k--)
     {
-        ptr[(*bp)++] = (UWord8)st_fx->ac_cache_fx; 
+        ptr[(*bp)++] = (UWord8)(st_fx->ac_low_fx >> add(24, shl_pos(k, 3))); 
+    }
 
-        FOR (; st_fx->ac_carry_count_fx > 1; st_fx->ac_carry_count_fx--)
-        {
-            ptr[(*bp)++] = 0xff; 
-        }
+    /* the 24 bit coder writes a last 0xff byte that was still waiting for a carry as lshr(0xff, 8 - bits),
+       which is kept for identical output */
+    IF (ff != 0)
+    {
         write_indice_forward(ptr, *bp, lshr(0xff, sub(8, bits)), bits);
     }
     ELSE
     {
-        write_indice_forward(ptr, *bp, st_fx->ac_cache_fx, bits);
+        write_indice_forward(ptr, *bp, (Word16)(UWord8)(st_fx->ac_low_fx >> 24), bits);
     }
 
     Dyn_Mem_Deluxe_Out();
@@ -1773,3 +1722,20 @@ static __forceinline Word16 check_pc_bytes(Word16 *bp, Word16 *bp_side, Word16 *
     return 0;
 }
 
+/* residual bit, from the bit buffer unless partial concealment has to follow the side position bit by bit */
+static __forceinline Word16 read_res_bit(Bitstream_Backward *bs, Word16 *bp, Word16 *bp_side, Word16 *mask_side,
+                                         Pc_State_fx *pc, Word16 *bit)
+{
+    IF (pc->bytes == 0)
+    {
+        *bit = bs_read(bs, 1); 
+        return 0;
+    }
+    if (check_pc_bytes(bp, bp_side, mask_side, pc->inv_bin, 0, pc) != 0)
+    {
+        return 1;
+    }
+    *bit = read_bit(bs->ptr, bp_side, mask_side); 
+    return 0;
+}
+
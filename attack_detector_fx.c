@@ -9,28 +9,28 @@
 
 #include "functions.h"
 
-void attack_detector_fx(LC3_Enc *enc, EncSetup *setup, Word16 *input, Word16 input_scaling, void *scratch)
+/* Attack detection on the 12.8 kHz signal of the pitch analysis, high pass filtering and block energies in one
+   pass. s_12k8 has to be the output of process_resamp12k8_fx() of the current frame. */
+void attack_detector_fx(EncSetup *setup, const Word16 *s_12k8, Word16 s_12k8_len)
 {
     Dyn_Mem_Deluxe_In(
-        int    i, position;
-        Word32 tmp, *block_energy;
-        Word16 h16, l16, new_scaling, rescale, input_delta_scaling;
-        Word16 scales[3], *input_16k;
+        Counter i, b;
+        Word32  tmp, block_energy;
+        Word16  h16, l16, new_scaling, rescale, n_blocks, position;
+        Word16  x0, x1, x2, filt;
+        Word16  scales[3];
     );
 
-    block_energy = scratchAlign(scratch, 0);              // 4 * 4
-    input_16k    = scratchAlign(block_energy, 4 * 4 + 4); // indexing from -2 to 159 (filter delay)
-
     IF (setup->attack_handling)
     {
         /* input scaling */
-        scales[0] = add(getScaleFactor16(input, enc->frame_length), input_scaling);
+        scales[0] = getScaleFactor16(s_12k8, s_12k8_len);
         scales[1] = add(getScaleFactor16_0(setup->attdec_filter_mem, 2), setup->attdec_scaling);
         scales[2] =
             shr(add(add(getScaleFactor32_0(&setup->attdec_acc_energy, 1), shl(setup->attdec_scaling, 1)), 1), 1);
         new_scaling = s_min(scales[0], s_min(scales[1], scales[2]));
 
-        new_scaling = sub(new_scaling, 2); /* add overhead for resampler*/
+        new_scaling = sub(new_scaling, 2); /* add overhead for block energies */
 
         /* memory re-scaling */
         rescale = sub(new_scaling, setup->attdec_scaling);
@@ -43,77 +43,52 @@ void attack_detector_fx(LC3_Enc *enc, EncSetup *setup, Word16 *input, Word16 inp
         }
         setup->attdec_scaling = new_scaling; 
 
-        // resampling to 16 kHz
-        SWITCH (enc->frame_length)
-        {
-        case 320:
-            input_delta_scaling = sub(1, sub(new_scaling, input_scaling));
-            FOR (i = 0; i < 160; i++)
-            {
-                input_16k[i] = add(shr(input[2 * i + 0], input_delta_scaling),
-                                   shr(input[2 * i + 1], input_delta_scaling)); 
-            }
-            break;
-        case 480:
-            input_delta_scaling = sub(2, sub(new_scaling, input_scaling));
-            FOR (i = 0; i < 160; i++)
-            {
-                input_16k[i] = add(shr(input[3 * i + 0], input_delta_scaling),
-                                   add(shr(input[3 * i + 1], input_delta_scaling),
-                                       shr(input[3 * i + 2], input_delta_scaling))); 
-            }
-            break;
-        default: ASSERT(!"sampling rate not supported in function attack_detector_fx!"); break;
-        }
+        x2 = setup->attdec_filter_mem[0]; 
+        x1 = setup->attdec_filter_mem[1]; 
 
-        // high pass filtering
-        input_16k[-2]               = setup->attdec_filter_mem[0]; 
-        input_16k[-1]               = setup->attdec_filter_mem[1]; 
-        setup->attdec_filter_mem[0] = input_16k[158];              
-        setup->attdec_filter_mem[1] = input_16k[159];              
+        /* an attack in the second half of the last frame is still signaled */
+        n_blocks               = shr_pos(s_12k8_len, 5);
+        setup->attdec_detected = setup->attdec_position >= shr_pos(n_blocks, 1);
+        test();        
+        position = -1; 
 
-        FOR (i = 159; i >= 0; i--)
+        FOR (b = 0; b < n_blocks; b++)
         {
-            tmp = L_mult(input_16k[i], 12288);
-            tmp = L_msu(tmp, input_16k[i - 1], 16384);
-            tmp = L_mac(tmp, input_16k[i - 2], 4096);
+            /* high pass filtering and energy of one block */
+            block_energy = L_deposit_l(0);
 
-            input_16k[i] = extract_h(tmp); 
-        }
+            FOR (i = 0; i < ATTDEC_BLOCK_LEN; i++)
+            {
+                x0 = shl(*s_12k8++, new_scaling);
 
-        // energy calculation
-        basop_memset(block_energy, 0, 4 * sizeof(Word32));
+                tmp  = L_mult(x0, 12288);
+                tmp  = L_msu(tmp, x1, 16384);
+                tmp  = L_mac(tmp, x2, 4096);
+                filt = extract_h(tmp);
 
-        FOR (i = 0; i < 40; i++)
-        {
-            block_energy[0] = L_mac(block_energy[0], input_16k[i + 0], input_16k[i + 0]);     
-            block_energy[1] = L_mac(block_energy[1], input_16k[i + 40], input_16k[i + 40]);   
-            block_energy[2] = L_mac(block_energy[2], input_16k[i + 80], input_16k[i + 80]);   
-            block_energy[3] = L_mac(block_energy[3], input_16k[i + 120], input_16k[i + 120]); 
-        }
+                block_energy = L_mac(block_energy, filt, filt);
 
-        // attack detection
-        setup->attdec_detected = setup->attdec_position >= 2;
-        test();        
-        position = -1; 
+                x2 = x1; 
+                x1 = x0; 
+            }
 
-        FOR (i = 0; i < 4; i++)
-        {
-            /* block_energy[i] / 8.5 */
-            l16 = extract_l(L_shr(block_energy[i], 1)); // block_energy[i] approx. h * 2^16 + l * 2.
+            /* attack detection, block_energy / 8.5 */
+            l16 = extract_l(L_shr(block_energy, 1)); // block_energy approx. h * 2^16 + l * 2.
             l16 = s_and(l16, 0x7fff);
-            h16 = extract_h(block_energy[i]);
+            h16 = extract_h(block_energy);
             tmp = L_shr(L_mult0(l16, 30840), 15);
             tmp = L_shr(L_mac0(tmp, h16, 30840), 2);
 
             IF (tmp > setup->attdec_acc_energy)
             {
-                position               = i; 
+                position               = b; 
                 setup->attdec_detected = 1; 
             }
-            setup->attdec_acc_energy = L_max(L_shr(setup->attdec_acc_energy, 2), block_energy[i]); 
+            setup->attdec_acc_energy = L_max(L_shr(setup->attdec_acc_energy, 2), block_energy); 
         }
-        setup->attdec_position = position; 
+        setup->attdec_filter_mem[0] = x2; 
+        setup->attdec_filter_mem[1] = x1; 
+        setup->attdec_position      = position; 
     }
 
     Dyn_Mem_Deluxe_Out();
@@ -393,6 +393,17 @@ void Reset_all_WMOPS_counter (void);
 Word32 BASOP_get_wops (void);
 /*! Returns the total min/max/avg WMOPS values like printed in BASOP_end(). */
 void BASOP_get_total_wmops(double *min, double *max, double *avg);
+#elif defined(LC3_STAGE_TIMERS)
+/* wall clock time per BASOP_sub_start() label, implemented by lc3bench (bench/lc3bench.c) */
+void lc3_stage_start(const char *label);
+void lc3_stage_end(void);
+#define BASOP_sub_start(label) { lc3_stage_start(label); }
+#define BASOP_sub_end()        { lc3_stage_end(); }
+#define BASOP_sub_sub_start(msg)
+#define BASOP_sub_sub_end()
+#define BASOP_push_wmops(label)
+#define BASOP_pop_wmops()
+#define BASOP_frame_update()
 #else
 #define BASOP_sub_start(label)
 #define BASOP_sub_end()
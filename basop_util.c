@@ -26,7 +26,8 @@ extern const Word16 ISqrtDiffTable[32];
 extern const Word32 InvTable[32];
 extern const Word16 InvDiffTable[32];
 
-Word32 BASOP_Util_Log2(Word32 x)
+/* shared by BASOP_Util_Log2() and BASOP_Util_Log2_vec(), inlined into the batched loop */
+static __inline Word32 Log2_core(Word32 x)
 {
     Word32 exp;
     Word16 exp_e;
@@ -89,6 +90,18 @@ Word32 BASOP_Util_Log2(Word32 x)
     return (accuRes);
 }
 
+Word32 BASOP_Util_Log2(Word32 x) { return Log2_core(x); }
+
+void BASOP_Util_Log2_vec(const Word32 *x, Word32 *y, Word16 len)
+{
+    Counter i;
+
+    FOR (i = 0; i < len; i++)
+    {
+        y[i] = Log2_core(x[i]);
+    }
+}
+
 Word32 BASOP_Util_InvLog2(Word32 x)
 {
     Word16  frac;
@@ -880,7 +893,7 @@ Word32 Isqrt(Word32  x,  /* mantissa */
     return y;
 }
 
-Word16 BASOP_Util_Log2_16(Word32 x, Word16 x_e)
+static __inline Word16 Log2_16_core(Word32 x, Word16 x_e)
 {
     Word16 shift, tmp1, tmp2;
     Word16 outInt, outFrac, out;
@@ -910,6 +923,18 @@ Word16 BASOP_Util_Log2_16(Word32 x, Word16 x_e)
     return out;
 }
 
+Word16 BASOP_Util_Log2_16(Word32 x, Word16 x_e) { return Log2_16_core(x, x_e); }
+
+void BASOP_Util_Log2_16_vec(const Word32 *x, const Word16 *x_e, Word16 *y, Word16 len)
+{
+    Counter i;
+
+    FOR (i = 0; i < len; i++)
+    {
+        y[i] = Log2_16_core(x[i], x_e[i]);
+    }
+}
+
 Word16 BASOP_Util_InvLog2_16(Word16 x, Word16 *y_e)
 {
     Word16 tmp1, tmp2, y;
@@ -921,3 +946,17 @@ Word16 BASOP_Util_InvLog2_16(Word16 x, Word16 *y_e)
 
     return y;
 }
+
+void BASOP_Util_InvLog2_16_vec(const Word16 *x, Word16 *y, Word16 *y_e, Word16 len)
+{
+    Counter i;
+    Word16  tmp1, tmp2;
+
+    FOR (i = 0; i < len; i++)
+    {
+        tmp1   = shr(s_and(x[i], 2047), 5);
+        tmp2   = shl(s_and(x[i], 31), 4);
+        y_e[i] = add(shr_pos(x[i], 11), 1);
+        y[i]   = mac_r(InvLog2_16_table1[tmp1], InvLog2_16_table2[tmp1], tmp2);
+    }
+}
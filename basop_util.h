@@ -187,6 +187,9 @@ Word16 BASOP_Util_Divide1616_Scale(Word16  x,  /*!< i  : Numerator*/
 /************************************************************************/
 Word32 BASOP_Util_Log2(Word32 x);
 
+/* BASOP_Util_Log2() of len values, y[i] = log2(x[i])/64, in-place (y == x) allowed */
+void BASOP_Util_Log2_vec(const Word32 *x, Word32 *y, Word16 len);
+
 /************************************************************************/
 /*!
   \brief 	Binary power
@@ -288,6 +291,10 @@ Word16 BASOP_Util_Log2_16(Word32 x, Word16 x_e);
 
 Word16 BASOP_Util_InvLog2_16(Word16 x, Word16 *y_e);
 
+/* batched versions of BASOP_Util_Log2_16() and BASOP_Util_InvLog2_16() for len values, bit exact */
+void BASOP_Util_Log2_16_vec(const Word32 *x, const Word16 *x_e, Word16 *y, Word16 len);
+void BASOP_Util_InvLog2_16_vec(const Word16 *x, Word16 *y, Word16 *y_e, Word16 len);
+
 #ifdef USE_KISS_FFT
 void fft16(Word32 *re, Word32 *im, Word16 s);
 #endif
@@ -0,0 +1,721 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+/* Wall clock benchmark of the codec, built with "make lc3bench".
+
+   Every configuration is run twice on a synthetic signal. The first pass times the full
+   lc3_enc16() / lc3_dec16() calls, the second one the stages between BASOP_sub_start() and
+   BASOP_sub_end() (the library is built with LC3_STAGE_TIMERS for this binary). Stage times are
+   inclusive, so "Encoder" and "Decoder" contain all other stages of a channel. Lost frames are
+   timed separately as "plc". The report is written as JSON, with one result per line:
+
+     {"name": "enc/48000/5.0/64000/ep0", "frames": 500, "ns_per_frame": ..., "median_ns": ...,
+      "p99_ns": ..., "frames_per_s": ...}
+
+   ns_per_frame is the mean and frames_per_s the resulting throughput of one core. In compare mode
+   the median of every result is checked against a stored report and all results slower than the
+   threshold are listed. */
+
+#define _POSIX_C_SOURCE 199309L /* clock_gettime() */
+
+#include "functions.h"
+#include "lc3.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#undef exit /* stl.h stubs it for the target, this is a host tool */
+
+#define MAX_STAGES 64
+#define MAX_DEPTH 16
+#define MAX_BASELINE 8192
+#define MAX_NAME 96
+#define WARMUP_FRAMES 16
+#define LOSS_PERIOD 32 /* LOSS_BURST frames out of every LOSS_PERIOD are lost */
+#define LOSS_BURST 3
+#define MIN_DIFF_NS 50 /* differences below timer resolution are never reported */
+
+/* struct to hold command line arguments */
+typedef struct
+{
+    int   frames;
+    int   channels;
+    char *filter;
+    char *outputFilename;
+    char *compareFilename;
+    float threshold;
+} Arguments;
+
+/* configuration matrix, combinations rejected by the library are skipped */
+#if BTLLC_5MS_MODE
+static const int   samplerates[] = {44100, 48000};
+static const float frame_sizes[] = {5};
+#else
+static const int   samplerates[] = {8000, 16000, 24000, 32000, 44100, 48000};
+static const float frame_sizes[] = {2.5, 5, 10};
+#endif
+static const int         bitrates[]  = {32000, 64000, 96000, 128000, 240000};
+static const LC3_EpMode  ep_modes[]  = {LC3_EP_OFF, LC3_EP_ZERO, LC3_EP_LOW, LC3_EP_MEDIUM, LC3_EP_HIGH};
+static const LC3_PlcMode plc_modes[] = {LC3_PLC_ADVANCED};
+
+#define COUNT(x) ((int)(sizeof(x) / sizeof((x)[0])))
+
+/* stage timers */
+typedef struct
+{
+    const char *label;
+    uint64_t    frame_ns; /* time spent in the current frame */
+    int         hit;      /* stage ran in the current frame */
+    int         count;    /* frames in samples */
+    double *    samples;
+} Stage;
+
+static Stage stages[MAX_STAGES];
+static int   n_stages;
+static int   stack_idx[MAX_DEPTH];
+static uint64_t stack_t0[MAX_DEPTH];
+static int   depth;
+static int   stage_timing; /* hooks return at once while full calls are timed */
+
+/* baseline of compare mode */
+static char * base_names[MAX_BASELINE];
+static double base_ns[MAX_BASELINE];
+static int    n_base;
+
+static FILE *output_file;
+static int   first_result = 1;
+static int   regressions;
+
+static Arguments arg;
+
+static void parseCmdl(int ac, char **av, Arguments *arg);
+static void exit_if(int condition, const char *message);
+static void load_baseline(const char *file);
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void lc3_stage_start(const char *label)
+{
+    int i;
+    if (!stage_timing)
+    {
+        return;
+    }
+    for (i = 0; i < n_stages; i++)
+    {
+        if (stages[i].label == label || !strcmp(stages[i].label, label))
+        {
+            break;
+        }
+    }
+    if (i == n_stages)
+    {
+        exit_if(n_stages == MAX_STAGES, "Too many stages!");
+        stages[i].label   = label;
+        stages[i].samples = malloc(arg.frames * sizeof(double));
+        exit_if(!stages[i].samples, "Out of memory!");
+        n_stages++;
+    }
+    exit_if(depth == MAX_DEPTH, "Stages nested too deep!");
+    stack_idx[depth] = i;
+    stack_t0[depth]  = now_ns();
+    depth++;
+}
+
+void lc3_stage_end(void)
+{
+    uint64_t t = now_ns();
+    if (!stage_timing)
+    {
+        return;
+    }
+    exit_if(depth == 0, "BASOP_sub_start/BASOP_sub_end imbalance!");
+    depth--;
+    stages[stack_idx[depth]].frame_ns += t - stack_t0[depth];
+    stages[stack_idx[depth]].hit = 1;
+}
+
+/* close the stage timers of one frame, only timed frames are kept */
+static void stage_frame_end(int timed)
+{
+    int i;
+    for (i = 0; i < n_stages; i++)
+    {
+        if (timed && stages[i].hit)
+        {
+            stages[i].samples[stages[i].count++] = (double)stages[i].frame_ns;
+        }
+        stages[i].frame_ns = 0;
+        stages[i].hit      = 0;
+    }
+}
+
+static void stage_reset(void)
+{
+    int i;
+    for (i = 0; i < n_stages; i++)
+    {
+        free(stages[i].samples);
+    }
+    memset(stages, 0, sizeof(stages));
+    n_stages = 0;
+    depth    = 0;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static int wanted(const char *name)
+{
+    return !arg.filter || strstr(name, arg.filter) != NULL;
+}
+
+/* print one result and check it against the baseline, samples are sorted in place */
+static void report(const char *name, double *samples, int n)
+{
+    double mean = 0, median = 0, p99 = 0;
+    int    i;
+
+    if (n == 0)
+    {
+        return;
+    }
+    for (i = 0; i < n; i++)
+    {
+        mean += samples[i];
+    }
+    mean /= n;
+    qsort(samples, n, sizeof(double), compare_double);
+    median = samples[n / 2];
+    p99    = samples[(n * 99) / 100];
+
+    fprintf(output_file,
+            "%s    {\"name\": \"%s\", \"frames\": %d, \"ns_per_frame\": %.1f, \"median_ns\": %.1f, \"p99_ns\": %.1f, "
+            "\"frames_per_s\": %.1f}",
+            first_result ? "" : ",\n", name, n, mean, median, p99, 1e9 / mean);
+    first_result = 0;
+
+    /* the median is compared, it is far less affected by other load on the host than the mean */
+    for (i = 0; i < n_base; i++)
+    {
+        if (!strcmp(base_names[i], name))
+        {
+            if (median > base_ns[i] * (1 + arg.threshold / 100) && median - base_ns[i] > MIN_DIFF_NS)
+            {
+                fprintf(stderr, "REGRESSION %s: median %.1f -> %.1f ns (%+.1f%%)\n", name, base_ns[i], median,
+                        100 * (median / base_ns[i] - 1));
+                regressions++;
+            }
+            break;
+        }
+    }
+}
+
+static void report_stages(const char *prefix)
+{
+    char name[2 * MAX_NAME + 64];
+    int  i;
+    for (i = 0; i < n_stages; i++)
+    {
+        sprintf(name, "%s/stage/%s", prefix, stages[i].label);
+        report(name, stages[i].samples, stages[i].count);
+    }
+    stage_reset();
+}
+
+/* deterministic test signal: two swept tones, noise and a short burst every 100 ms */
+static void make_frame(int16_t **pcm, int channels, int frame_length, int samplerate, long frame)
+{
+    static uint32_t seed = 12345;
+    int             ch, i;
+    for (ch = 0; ch < channels; ch++)
+    {
+        for (i = 0; i < frame_length; i++)
+        {
+            double t   = (double)(frame * frame_length + i) / samplerate;
+            double env = fmod(t, 0.1) < 0.005 ? 1.0 : 0.25;
+            double x   = 6000 * sin(2 * 3.14159265 * (300 + 200 * ch) * t * (1 + 0.5 * sin(t))) +
+                       3000 * sin(2 * 3.14159265 * 2500 * t);
+            seed = seed * 1664525u + 1013904223u;
+            x    = env * (x + (double)((int32_t)seed >> 20));
+            pcm[ch][i] = (int16_t)(x > 32767 ? 32767 : x < -32768 ? -32768 : x);
+        }
+    }
+}
+
+static int is_lost(long frame)
+{
+    return frame >= WARMUP_FRAMES && frame % LOSS_PERIOD >= LOSS_PERIOD - LOSS_BURST;
+}
+
+/* encode all frames, timing full calls (pass 0) or stages (pass 1), packets are kept for decoding */
+static void run_encoder(int samplerate, float frame_ms, int bitrate, LC3_EpMode epmode, int pass, uint8_t *packets,
+                        int *packet_bytes, double *samples, LC3_ScratchArena *arena)
+{
+    LC3_Enc *encoder = malloc(lc3_enc_get_size(samplerate, arg.channels));
+    int16_t  buf[LC3_MAX_CHANNELS][LC3_MAX_SAMPLES];
+    int16_t *input16[] = {buf[0], buf[1]};
+    long     frame;
+    int      nbytes;
+
+    exit_if(!encoder, "Out of memory!");
+    exit_if(lc3_enc_init(encoder, samplerate, arg.channels), "Encoder init failed!");
+    exit_if(lc3_enc_set_frame_ms(encoder, frame_ms), "Encoder init failed!");
+    exit_if(lc3_enc_set_ep_mode(encoder, epmode), "Encoder init failed!");
+    exit_if(lc3_enc_set_bitrate(encoder, bitrate), "Encoder init failed!");
+
+    stage_timing = pass;
+    for (frame = 0; frame < WARMUP_FRAMES + arg.frames; frame++)
+    {
+        void *   scratch = lc3_scratch_arena_get(arena);
+        uint64_t t0      = 0;
+        make_frame(input16, arg.channels, encoder->frame_length, samplerate, frame);
+        nbytes = 0;
+        t0     = now_ns();
+        exit_if(lc3_enc16(encoder, input16, packets + frame * LC3_MAX_BYTES, &nbytes, scratch), "Encoding failed!");
+        t0 = now_ns() - t0;
+        exit_if(lc3_scratch_arena_check(arena), "Scratch memory overrun!");
+        packet_bytes[frame] = nbytes;
+        if (frame >= WARMUP_FRAMES && pass == 0)
+        {
+            samples[frame - WARMUP_FRAMES] = (double)t0;
+        }
+        stage_frame_end(frame >= WARMUP_FRAMES);
+    }
+    stage_timing = 0;
+    free(encoder);
+}
+
+/* decode all packets with periodic burst losses, good and lost frames are timed separately */
+static void run_decoder(int samplerate, float frame_ms, LC3_EpMode epmode, LC3_PlcMode plc_mode, int pass,
+                        uint8_t *packets, const int *packet_bytes, double *good, int *n_good, double *lost,
+                        int *n_lost, LC3_ScratchArena *arena)
+{
+    LC3_Dec * decoder = malloc(lc3_dec_get_size(samplerate, arg.channels, plc_mode));
+    int16_t   buf[LC3_MAX_CHANNELS][LC3_MAX_SAMPLES];
+    int16_t * output16[] = {buf[0], buf[1]};
+    long      frame;
+    LC3_Error err;
+
+    exit_if(!decoder, "Out of memory!");
+    exit_if(lc3_dec_init(decoder, samplerate, arg.channels, plc_mode), "Decoder init failed!");
+    exit_if(lc3_dec_set_frame_ms(decoder, frame_ms), "Decoder init failed!");
+    exit_if(lc3_dec_set_ep_enabled(decoder, epmode != LC3_EP_OFF), "Decoder init failed!");
+
+    *n_good = *n_lost = 0;
+    stage_timing      = pass;
+    for (frame = 0; frame < WARMUP_FRAMES + arg.frames; frame++)
+    {
+        void *   scratch = lc3_scratch_arena_get(arena);
+        int      loss    = is_lost(frame);
+        uint64_t t0      = now_ns();
+        err              = lc3_dec16(decoder, packets + frame * LC3_MAX_BYTES, loss ? 0 : packet_bytes[frame],
+                                     output16, scratch, 0);
+        t0               = now_ns() - t0;
+        exit_if(err && err != LC3_DECODE_ERROR, "Decoding failed!");
+        exit_if(lc3_scratch_arena_check(arena), "Scratch memory overrun!");
+        if (frame >= WARMUP_FRAMES && pass == 0)
+        {
+            if (loss)
+            {
+                lost[(*n_lost)++] = (double)t0;
+            }
+            else
+            {
+                good[(*n_good)++] = (double)t0;
+            }
+        }
+        stage_frame_end(frame >= WARMUP_FRAMES);
+    }
+    stage_timing = 0;
+    free(decoder);
+}
+
+static void bench_codec(LC3_ScratchArena *arena)
+{
+    uint8_t *packets      = malloc((WARMUP_FRAMES + arg.frames) * LC3_MAX_BYTES);
+    int *    packet_bytes = malloc((WARMUP_FRAMES + arg.frames) * sizeof(int));
+    double * samples      = malloc(arg.frames * sizeof(double));
+    double * lost         = malloc(arg.frames * sizeof(double));
+    int      f, m, b, e, p, n_good, n_lost;
+
+    exit_if(!packets || !packet_bytes || !samples || !lost, "Out of memory!");
+
+    for (f = 0; f < COUNT(samplerates); f++)
+    {
+        for (m = 0; m < COUNT(frame_sizes); m++)
+        {
+            for (b = 0; b < COUNT(bitrates); b++)
+            {
+                for (e = 0; e < COUNT(ep_modes); e++)
+                {
+                    char     enc_name[MAX_NAME], dec_name[COUNT(plc_modes)][MAX_NAME], name[MAX_NAME];
+                    int      want_dec = 0;
+                    LC3_Enc *probe    = malloc(lc3_enc_get_size(samplerates[f], arg.channels));
+
+                    /* skip combinations the library rejects */
+                    exit_if(!probe, "Out of memory!");
+                    if (lc3_enc_init(probe, samplerates[f], arg.channels) ||
+                        lc3_enc_set_frame_ms(probe, frame_sizes[m]) || lc3_enc_set_ep_mode(probe, ep_modes[e]) ||
+                        lc3_enc_set_bitrate(probe, bitrates[b]))
+                    {
+                        free(probe);
+                        continue;
+                    }
+                    free(probe);
+
+                    sprintf(enc_name, "enc/%d/%.1f/%d/ep%d", samplerates[f], frame_sizes[m], bitrates[b], ep_modes[e]);
+                    for (p = 0; p < COUNT(plc_modes); p++)
+                    {
+                        sprintf(dec_name[p], "dec/%d/%.1f/%d/ep%d/plc%d", samplerates[f], frame_sizes[m], bitrates[b],
+                                ep_modes[e], plc_modes[p]);
+                        sprintf(name, "plc%s", dec_name[p] + 3);
+                        want_dec |= wanted(dec_name[p]) || wanted(name);
+                    }
+                    if (!wanted(enc_name) && !want_dec)
+                    {
+                        continue;
+                    }
+
+                    run_encoder(samplerates[f], frame_sizes[m], bitrates[b], ep_modes[e], 0, packets, packet_bytes,
+                                samples, arena);
+                    if (wanted(enc_name))
+                    {
+                        report(enc_name, samples, arg.frames);
+                        run_encoder(samplerates[f], frame_sizes[m], bitrates[b], ep_modes[e], 1, packets,
+                                    packet_bytes, samples, arena);
+                        report_stages(enc_name);
+                    }
+
+                    for (p = 0; p < COUNT(plc_modes); p++)
+                    {
+                        sprintf(name, "plc%s", dec_name[p] + 3);
+                        if (!wanted(dec_name[p]) && !wanted(name))
+                        {
+                            continue;
+                        }
+                        run_decoder(samplerates[f], frame_sizes[m], ep_modes[e], plc_modes[p], 0, packets,
+                                    packet_bytes, samples, &n_good, lost, &n_lost, arena);
+                        report(dec_name[p], samples, n_good);
+                        report(name, lost, n_lost);
+                        run_decoder(samplerates[f], frame_sizes[m], ep_modes[e], plc_modes[p], 1, packets,
+                                    packet_bytes, samples, &n_good, lost, &n_lost, arena);
+                        report_stages(dec_name[p]);
+                    }
+                }
+            }
+        }
+    }
+
+    free(packets);
+    free(packet_bytes);
+    free(samples);
+    free(lost);
+}
+
+/* kernels outside of the frame loop: dct_IV() of every frame length and the channel coder */
+static void bench_kernels(LC3_ScratchArena *arena)
+{
+    Word32   data[LC3_MAX_SAMPLES], work[LC3_MAX_SAMPLES], ref[LC3_MAX_SAMPLES];
+    UWord8   slot[FEC_SLOT_BYTES_MAX], coded[FEC_SLOT_BYTES_MAX];
+    double * samples = malloc(arg.frames * sizeof(double));
+    char     name[MAX_NAME];
+    int      lengths[COUNT(samplerates) * COUNT(frame_sizes)], n_lengths = 0;
+    int      f, m, i, k, b, mode;
+    uint32_t seed = 1;
+
+    exit_if(!samples, "Out of memory!");
+
+    for (f = 0; f < COUNT(samplerates); f++)
+    {
+        for (m = 0; m < COUNT(frame_sizes); m++)
+        {
+            LC3_Enc *encoder = malloc(lc3_enc_get_size(samplerates[f], 1));
+            exit_if(!encoder, "Out of memory!");
+            if (!lc3_enc_init(encoder, samplerates[f], 1) && !lc3_enc_set_frame_ms(encoder, frame_sizes[m]))
+            {
+                for (k = 0; k < n_lengths && lengths[k] != encoder->frame_length; k++)
+                    ;
+                if (k == n_lengths)
+                {
+                    lengths[n_lengths++] = encoder->frame_length;
+                }
+            }
+            free(encoder);
+        }
+    }
+
+    for (k = 0; k < n_lengths; k++)
+    {
+        sprintf(name, "dct_IV/%d", lengths[k]);
+        if (!wanted(name))
+        {
+            continue;
+        }
+        for (i = 0; i < lengths[k]; i++)
+        {
+            seed   = seed * 1664525u + 1013904223u;
+            ref[i] = (Word32)seed >> 4; /* headroom as after windowing */
+        }
+        for (i = 0; i < WARMUP_FRAMES + arg.frames; i++)
+        {
+            Word16   exp = 0;
+            uint64_t t0;
+            memcpy(data, ref, lengths[k] * sizeof(Word32));
+            t0 = now_ns();
+            dct_IV(data, &exp, lengths[k], work);
+            t0 = now_ns() - t0;
+            if (i >= WARMUP_FRAMES)
+            {
+                samples[i - WARMUP_FRAMES] = (double)t0;
+            }
+        }
+        report(name, samples, arg.frames);
+    }
+
+    /* slot sizes of the benchmarked bitrates at 5 ms, first with clean slots then with one corrupted
+       byte that the stronger modes have to correct */
+    for (b = 0; b < COUNT(bitrates); b++)
+    {
+        int slot_bytes = bitrates[b] / 1600;
+        if (slot_bytes < FEC_SLOT_BYTES_MIN || slot_bytes > FEC_SLOT_BYTES_MAX)
+        {
+            continue;
+        }
+        for (mode = LC3_EP_ZERO; mode <= LC3_EP_HIGH; mode++)
+        {
+            int    data_bytes = fec_get_data_size(mode, 0, slot_bytes);
+            Word16 n_pccw     = fec_get_n_pccw(slot_bytes, mode, 0);
+            int    errors;
+
+            sprintf(name, "fec_encoder/%d/ep%d", slot_bytes, mode);
+            for (i = 0; i < WARMUP_FRAMES + arg.frames; i++)
+            {
+                uint64_t t0;
+                for (k = 0; k < data_bytes; k++)
+                {
+                    seed    = seed * 1664525u + 1013904223u;
+                    slot[k] = (UWord8)(seed >> 24);
+                }
+                t0 = now_ns();
+                fec_encoder(mode, 0, slot, data_bytes, slot_bytes, n_pccw, lc3_scratch_arena_get(arena));
+                t0 = now_ns() - t0;
+                if (i >= WARMUP_FRAMES)
+                {
+                    samples[i - WARMUP_FRAMES] = (double)t0;
+                }
+            }
+            if (wanted(name))
+            {
+                report(name, samples, arg.frames);
+            }
+
+            for (errors = 0; errors <= (mode > LC3_EP_ZERO); errors++)
+            {
+                sprintf(name, "fec_decoder/%d/ep%d/err%d", slot_bytes, mode, errors);
+                if (!wanted(name))
+                {
+                    continue;
+                }
+                for (i = 0; i < WARMUP_FRAMES + arg.frames; i++)
+                {
+                    int      bfi = 0, out_bytes = 0;
+                    Word16   epmr = 0, pccw = 0, bp_left = 0, bp_right = 0, n_pc = 0, m_fec = 0;
+                    uint64_t t0;
+                    memcpy(coded, slot, slot_bytes);
+                    if (errors)
+                    {
+                        coded[i % slot_bytes] ^= 0x5A;
+                    }
+                    t0 = now_ns();
+                    fec_decoder(coded, slot_bytes, &out_bytes, &epmr, 0, &pccw, &bfi, &bp_left, &bp_right, &n_pc,
+                                &m_fec, lc3_scratch_arena_get(arena));
+                    t0 = now_ns() - t0;
+                    if (i >= WARMUP_FRAMES)
+                    {
+                        samples[i - WARMUP_FRAMES] = (double)t0;
+                    }
+                }
+                report(name, samples, arg.frames);
+            }
+        }
+    }
+
+    free(samples);
+}
+
+int main(int ac, char **av)
+{
+    LC3_ScratchArena *arena = NULL;
+    int               f, size = 0;
+
+    parseCmdl(ac, av, &arg);
+
+    if (arg.compareFilename)
+    {
+        load_baseline(arg.compareFilename);
+    }
+
+    output_file = stdout;
+    if (arg.outputFilename)
+    {
+        output_file = fopen(arg.outputFilename, "w");
+        exit_if(!output_file, "Error creating output file!");
+    }
+
+    /* one arena, large enough for every benchmarked sample rate */
+    for (f = 0; f < COUNT(samplerates); f++)
+    {
+        if (lc3_scratch_arena_get_size(samplerates[f], arg.channels) > size)
+        {
+            size = lc3_scratch_arena_get_size(samplerates[f], arg.channels);
+            free(arena);
+            arena = malloc(size);
+            exit_if(!arena, "Out of memory!");
+            exit_if(lc3_scratch_arena_init(arena, samplerates[f], arg.channels), "Scratch arena init failed!");
+        }
+    }
+
+    fprintf(output_file, "{\n  \"version\": \"%d.%d.%d\",\n  \"frames\": %d,\n  \"channels\": %d,\n",
+            LC3_VERSION >> 16, (LC3_VERSION >> 8) & 255, LC3_VERSION & 255, arg.frames, arg.channels);
+    fprintf(output_file, "  \"results\": [\n");
+    bench_codec(arena);
+    bench_kernels(arena);
+    fprintf(output_file, "\n  ]\n}\n");
+
+    if (output_file != stdout)
+    {
+        fclose(output_file);
+    }
+    free(arena);
+
+    if (arg.compareFilename)
+    {
+        fprintf(stderr, "%d regression%s against %s (threshold %.1f%%)\n", regressions, regressions == 1 ? "" : "s",
+                arg.compareFilename, arg.threshold);
+    }
+    for (f = 0; f < n_base; f++)
+    {
+        free(base_names[f]);
+    }
+    return regressions ? 1 : 0;
+}
+
+/* read name and median_ns of every result of a report written by this program */
+static void load_baseline(const char *file)
+{
+    FILE *f = fopen(file, "r");
+    char  line[1024];
+
+    exit_if(!f, "Error opening baseline file!");
+    while (fgets(line, sizeof(line), f))
+    {
+        char *name = strstr(line, "\"name\": \"");
+        char *ns   = strstr(line, "\"median_ns\": ");
+        char *end  = NULL;
+        if (!name || !ns)
+        {
+            continue;
+        }
+        name += strlen("\"name\": \"");
+        end = strchr(name, '"');
+        exit_if(!end || end - name >= MAX_NAME * 2, "Malformed baseline file!");
+        exit_if(n_base == MAX_BASELINE, "Too many results in baseline file!");
+        base_names[n_base] = malloc(end - name + 1);
+        exit_if(!base_names[n_base], "Out of memory!");
+        memcpy(base_names[n_base], name, end - name);
+        base_names[n_base][end - name] = 0;
+        base_ns[n_base++]              = atof(ns + strlen("\"median_ns\": "));
+    }
+    fclose(f);
+    exit_if(n_base == 0, "No results in baseline file!");
+}
+
+static const char *const USAGE_MESSAGE =
+    "Usage: lc3bench [OPTIONS]\n"
+    "\n"
+    "  -frames NUM             Timed frames per configuration, default: 500\n"
+    "  -channels NUM           Number of channels, default: 1\n"
+    "  -filter STR             Only run results whose name contains STR, e.g. enc/48000 or stage/Ari\n"
+    "  -o FILE                 Write the JSON report to FILE instead of stdout\n"
+    "  -compare FILE           Compare against a stored report, list results that got slower on stderr\n"
+    "                          and exit with 1 if there are any\n"
+    "  -threshold PCT          Allowed slowdown in percent for -compare, default: 10\n";
+
+static void parseCmdl(int ac, char **av, Arguments *arg)
+{
+    int pos = 1;
+    memset(arg, 0, sizeof(*arg));
+    arg->frames    = 500;
+    arg->channels  = 1;
+    arg->threshold = 10;
+
+    while (pos < ac)
+    {
+        if (!strcmp(av[pos], "-h") || !strcmp(av[pos], "-help"))
+        {
+            puts(USAGE_MESSAGE);
+            exit(0);
+        }
+        else if (!strcmp(av[pos], "-frames") && pos + 1 < ac)
+        {
+            arg->frames = atoi(av[++pos]);
+            exit_if(arg->frames < 1, "frames must be positive");
+        }
+        else if (!strcmp(av[pos], "-channels") && pos + 1 < ac)
+        {
+            arg->channels = atoi(av[++pos]);
+            exit_if(!lc3_channels_supported(arg->channels), "Number of channels not supported!");
+        }
+        else if (!strcmp(av[pos], "-filter") && pos + 1 < ac)
+        {
+            arg->filter = av[++pos];
+        }
+        else if (!strcmp(av[pos], "-o") && pos + 1 < ac)
+        {
+            arg->outputFilename = av[++pos];
+        }
+        else if (!strcmp(av[pos], "-compare") && pos + 1 < ac)
+        {
+            arg->compareFilename = av[++pos];
+        }
+        else if (!strcmp(av[pos], "-threshold") && pos + 1 < ac)
+        {
+            arg->threshold = (float)atof(av[++pos]);
+            exit_if(arg->threshold < 0, "threshold must not be negative");
+        }
+        else
+        {
+            fprintf(stderr, "%s", USAGE_MESSAGE);
+            exit_if(1, "Unknown option!");
+        }
+        pos++;
+    }
+}
+
+static void exit_if(int condition, const char *message)
+{
+    if (condition)
+    {
+        fprintf(stderr, "%s\n", message);
+        exit(2);
+    }
+}
@@ -18,6 +18,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 /* struct to hold command line arguments */
 typedef struct
@@ -35,6 +39,12 @@ typedef struct
     int   hide_counter;
     int   verbose;
     int   plcMeth;
+    int   speculate;
+    int   parallel;
+    int   snapshot;
+    int   plc_bench;
+    char *mix;
+    int   transrate;
     char *epf;
     int   epmode;
     char *epmode_file;
@@ -43,6 +53,8 @@ typedef struct
     int   hrmode;
     int   dc;
     char *bandwidth;
+    int   complexity;
+    int   silence_cache;
     char *channel_coder_vars_file;
 } Arguments;
 
@@ -63,12 +75,18 @@ static void    scale_24_to_16(const int32_t *in, int16_t *out, int n);
 static void    scale_16_to_24(const int16_t *in, int32_t *out, int n);
 static void    interleave(int32_t **in, int32_t *out, int n, int channels);
 static void    deinterleave(int32_t *in, int32_t **out, int n, int channels);
+static int     run_mix(const Arguments *arg);
+static int     run_transrate(const Arguments *arg);
+static LC3_Dec *open_decoder(const Arguments *arg, uint32_t sampleRate, short nChannels, void **spec_buf);
+static LC3_Error enc_round_trip(LC3_Enc **encoder, LC3_Enc **spare, void *snapshot, int size);
+static LC3_Error dec_round_trip(LC3_Dec **decoder, LC3_Dec **spare, void *snapshot, int size);
 
 /* needed by cleanup function */
 static WAVEFILEIN * input_wav;
 static WAVEFILEOUT *output_wav;
 static FILE *       output_bitstream;
 static FILE *       input_bitstream;
+static FILE *       mix_bitstream;
 static FILE *       error_pattern_file;
 static FILE *       error_detection_file;
 static FILE *       bitrate_switching_file;
@@ -78,6 +96,100 @@ static FILE *channel_decoder_debug_file_bfi;
 static FILE *channel_decoder_debug_file_epmr;
 static FILE *channel_decoder_debug_file_error_report;
 
+#ifndef _WIN32
+/* worker threads for -parallel, job 0 runs on the calling thread and job i on worker i */
+typedef struct
+{
+    pthread_t       thread[LC3_MAX_CHANNELS];
+    pthread_mutex_t lock;
+    pthread_cond_t  start, done;
+    void (*job)(void *ctx, int index);
+    void *ctx;
+    int   workers, njobs, pending, generation, quit;
+} WorkerPool;
+
+static WorkerPool worker_pool;
+
+static void *worker_main(void *arg)
+{
+    int index = (int)(intptr_t)arg, generation = 0;
+
+    pthread_mutex_lock(&worker_pool.lock);
+    for (;;)
+    {
+        while (!worker_pool.quit && worker_pool.generation == generation)
+            pthread_cond_wait(&worker_pool.start, &worker_pool.lock);
+        if (worker_pool.quit)
+            break;
+        generation = worker_pool.generation;
+        if (index < worker_pool.njobs)
+        {
+            pthread_mutex_unlock(&worker_pool.lock);
+            worker_pool.job(worker_pool.ctx, index);
+            pthread_mutex_lock(&worker_pool.lock);
+            if (--worker_pool.pending == 0)
+                pthread_cond_signal(&worker_pool.done);
+        }
+    }
+    pthread_mutex_unlock(&worker_pool.lock);
+    return NULL;
+}
+
+/* LC3_ParallelFor on the worker threads */
+static void parallel_for(void *user, void (*job)(void *ctx, int index), void *ctx, int njobs)
+{
+    WorkerPool *pool = (WorkerPool *)user;
+
+    exit_if(njobs > pool->workers + 1, "Not enough worker threads!");
+    pthread_mutex_lock(&pool->lock);
+    pool->job     = job;
+    pool->ctx     = ctx;
+    pool->njobs   = njobs;
+    pool->pending = njobs - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    job(ctx, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0)
+        pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void start_workers(int workers)
+{
+    pthread_mutex_init(&worker_pool.lock, NULL);
+    pthread_cond_init(&worker_pool.start, NULL);
+    pthread_cond_init(&worker_pool.done, NULL);
+    for (; worker_pool.workers < workers; worker_pool.workers++)
+    {
+        exit_if(pthread_create(&worker_pool.thread[worker_pool.workers], NULL, worker_main,
+                               (void *)(intptr_t)(worker_pool.workers + 1)),
+                "Error creating worker thread!");
+    }
+}
+
+static void stop_workers(void)
+{
+    int i = 0;
+
+    if (!worker_pool.workers)
+        return;
+    pthread_mutex_lock(&worker_pool.lock);
+    worker_pool.quit = 1;
+    pthread_cond_broadcast(&worker_pool.start);
+    pthread_mutex_unlock(&worker_pool.lock);
+    for (i = 0; i < worker_pool.workers; i++)
+        pthread_join(worker_pool.thread[i], NULL);
+    worker_pool.workers = 0;
+    pthread_cond_destroy(&worker_pool.done);
+    pthread_cond_destroy(&worker_pool.start);
+    pthread_mutex_destroy(&worker_pool.lock);
+}
+#endif
+
 #include "license.h" /* provides LICENSE string */
 
 static const char *const USAGE_MESSAGE =
@@ -99,6 +211,8 @@ static const char *const USAGE_MESSAGE =
     "  -frame_ms               NUM Frame length in ms. NUM must be 10 (default), 5 or 2.5.\n"
     "  -bandwidth NUM|FILE     Select audio bandwidth limitation via value in Hz or switching file.\n"
     "                          NUM can be any integer value describing the bandwidth; max NUM=20000 Hz\n"
+    "  -complexity NUM         Encoder complexity level. NUM must be 0 (full, default) to 2 (minimal).\n"
+    "  -silence_cache          Repeat the last frame on steady digital silence without encoding it.\n"
     "  -q                      Disable frame counter printout\n"
     "  -v                      Verbose switching commands\n"
     "\nFormat options:\n"
@@ -110,6 +224,18 @@ static const char *const USAGE_MESSAGE =
     "  -ept                    Use together with -E -epf FILE to create bitstream triggering\n"
     "                          PLC via special value of lastnz\n"
     "  -edf FILE               Write error detection pattern to FILE.\n"
+    "  -speculate              Conceal a loss of the next frame ahead of time after each frame.\n"
+    "  -parallel               Decode the channels of a frame on parallel threads.\n"
+    "  -plc_bench NUM          Drop bursts of NUM frames out of every 32 and report the time\n"
+    "                          spent in concealment only. NUM must be in range [1-31].\n"
+    "\nState options:\n"
+    "  -snapshot               Save the encoder and decoder state after each frame and continue\n"
+    "                          on a second instance restored from the snapshot.\n"
+    "\nBridge options:\n"
+    "  -mix FILE               Mix bitstream FILE into INPUT in the MDCT domain. INPUT and\n"
+    "                          OUTPUT are binary files, OUTPUT is coded at BITRATE.\n"
+    "  -transrate              Convert INPUT to BITRATE without decoding it to PCM. INPUT and\n"
+    "                          OUTPUT are binary files, lost frames stay lost.\n"
     "\nChannel coder options:\n"
     "  -epmode NUM|FILE        Error protection mode. NUM must be one of the following:\n"
     "                          0: Error protection disabled\n"
@@ -154,13 +280,25 @@ int main(int ac, char **av)
     int       encoder_size = 0, decoder_size = 0, scratch_size = 0;
     LC3_Enc * encoder = NULL;
     LC3_Dec * decoder = NULL;
+    void *       spec_buf = NULL;
+    LC3_Enc *    spare_enc = NULL;
+    LC3_Dec *    spare_dec = NULL;
+    void *       spare_spec_buf = NULL;
+    void *       silence_buf = NULL;
+    void *       spare_silence_buf = NULL;
+    void *       snapshot = NULL;
+    int          snapshot_size = 0;
+    int          snapshot_failed = 0;
     void *    scratch = NULL;
+    LC3_ScratchArena *scratch_arena = NULL;
     LC3_Error err     = LC3_OK;
     int32_t   sample_buf[LC3_MAX_CHANNELS * LC3_MAX_SAMPLES];
     int32_t   buf_24[LC3_MAX_CHANNELS * LC3_MAX_SAMPLES];
     int16_t   buf_16[LC3_MAX_CHANNELS * LC3_MAX_SAMPLES];
     uint8_t   bytes[LC3_MAX_BYTES];
     int       dc2_extra_frame = 0;
+    int       plc_frames = 0;
+    clock_t   plc_clock = 0, t0 = 0;
 
     /* Parse Command-line */
     printf(LICENSE, LC3_VERSION >> 16, (LC3_VERSION >> 8) & 255, LC3_VERSION & 255);
@@ -176,6 +314,15 @@ int main(int ac, char **av)
     /* exit handler to clean up resources */
     atexit(cleanup);
 
+    if (arg.mix)
+    {
+        return run_mix(&arg);
+    }
+
+    if (arg.transrate)
+    {
+        return run_transrate(&arg);
+    }
 
     if (!arg.decoder_only)
     {
@@ -198,6 +345,32 @@ int main(int ac, char **av)
         err = lc3_enc_set_bitrate(encoder, arg.bitrate);
         exit_if(err, ERROR_MESSAGE[err]);
 
+        err = lc3_enc_set_complexity(encoder, (LC3_EncComplexity)arg.complexity);
+        exit_if(err, ERROR_MESSAGE[err]);
+
+        if (arg.silence_cache)
+        {
+            silence_buf = malloc(lc3_enc_get_silence_cache_size(encoder));
+            err         = lc3_enc_set_silence_cache(encoder, silence_buf);
+            exit_if(err, ERROR_MESSAGE[err]);
+        }
+
+        if (arg.snapshot)
+        {
+            /* the settings are part of the snapshot */
+            spare_enc = malloc(encoder_size);
+            err       = lc3_enc_init(spare_enc, sampleRate, nChannels);
+            exit_if(err, ERROR_MESSAGE[err]);
+            if (arg.silence_cache)
+            {
+                /* the silence cache is not part of the snapshot */
+                spare_silence_buf = malloc(lc3_enc_get_silence_cache_size(spare_enc));
+                err               = lc3_enc_set_silence_cache(spare_enc, spare_silence_buf);
+                exit_if(err, ERROR_MESSAGE[err]);
+            }
+            snapshot_size = lc3_enc_get_snapshot_size(encoder);
+        }
+
         delay        = arg.dc ? lc3_enc_get_delay(encoder) / arg.dc : 0;
 		nSamples = encoder->frame_length;// lc3_enc_get_input_samples(encoder);
         real_bitrate = lc3_enc_get_real_bitrate(encoder);
@@ -222,16 +395,23 @@ int main(int ac, char **av)
     if (!arg.encoder_only)
     {
         /* Setup Decoder */
-        decoder_size = lc3_dec_get_size(sampleRate, nChannels, (LC3_PlcMode)arg.plcMeth);
-        decoder      = malloc(decoder_size);
-        err          = lc3_dec_init(decoder, sampleRate, nChannels, (LC3_PlcMode)arg.plcMeth);
-        exit_if(err, ERROR_MESSAGE[err]);
+        if (arg.parallel)
+        {
+#ifndef _WIN32
+            start_workers(nChannels - 1);
+#else
+            exit_if(1, "Parallel decoding is not supported on this platform!");
+#endif
+        }
 
-        err = lc3_dec_set_frame_ms(decoder, arg.frame_ms);
-        exit_if(err, ERROR_MESSAGE[err]);
+        decoder_size = lc3_dec_get_size(sampleRate, nChannels, (LC3_PlcMode)arg.plcMeth);
+        decoder      = open_decoder(&arg, sampleRate, nChannels, &spec_buf);
 
-        err = lc3_dec_set_ep_enabled(decoder, arg.epmode != 0);
-        exit_if(err, ERROR_MESSAGE[err]);
+        if (arg.snapshot)
+        {
+            spare_dec     = open_decoder(&arg, sampleRate, nChannels, &spare_spec_buf);
+            snapshot_size = MAX(snapshot_size, lc3_dec_get_snapshot_size(decoder));
+        }
 
         delay    = arg.dc ? lc3_dec_get_delay(decoder) / arg.dc : 0;
 		nSamples = decoder->frame_length;// lc3_dec_get_output_samples(decoder);
@@ -279,9 +459,18 @@ int main(int ac, char **av)
                 "Error creating channel decoder debug files!");
     }
 
-    scratch_size = MAX(lc3_dec_get_scratch_size(decoder), lc3_enc_get_scratch_size(encoder));
-    scratch      = malloc(scratch_size);
-    exit_if(!scratch, "Failed to allocate scratch memory!");
+    if (arg.snapshot)
+    {
+        snapshot = malloc(snapshot_size);
+        exit_if(!snapshot, "Failed to allocate snapshot memory!");
+    }
+
+    /* one arena serves the encoder and the decoder */
+    scratch_size  = lc3_scratch_arena_get_size(sampleRate, nChannels);
+    scratch_arena = malloc(scratch_size);
+    exit_if(!scratch_arena, "Failed to allocate scratch memory!");
+    err = lc3_scratch_arena_init(scratch_arena, sampleRate, nChannels);
+    exit_if(err, ERROR_MESSAGE[err]);
 
 #ifdef STAMEM_COUNT
     Sta_Mem_Add("Encoder", encoder_size);
@@ -291,6 +480,10 @@ int main(int ac, char **av)
     /* Print info */
     printf("Encoder size:     %i\n", encoder_size);
     printf("Decoder size:     %i\n", decoder_size);
+    if (arg.snapshot)
+    {
+        printf("Snapshot size:    %i\n", snapshot_size);
+    }
     printf("Scratch size:     %i\n", scratch_size);
     printf("Sample rate:      %i\n", sampleRate);
     printf("Channels:         %i\n", nChannels);
@@ -344,7 +537,13 @@ int main(int ac, char **av)
 			}
             //err = lc3_enc16(encoder, input16, bytes, &nBytes, scratch);
 			err = LC3_OK;
-			nBytes = Enc_LC3(encoder, input16, 16, bytes, scratch, 0);
+			scratch = lc3_scratch_arena_get(scratch_arena);
+			nBytes = Enc_LC3(encoder, input16, 16, NULL, bytes, scratch, 0);
+			exit_if(lc3_scratch_arena_check(scratch_arena), "Scratch memory overrun!");
+			if (arg.snapshot) {
+				err = enc_round_trip(&encoder, &spare_enc, snapshot, snapshot_size);
+				snapshot_failed |= err != LC3_OK;
+			}
 			/*static LC3_Error lc3_enc(LC3_Enc * encoder, void** input_samples, int bitdepth, void* output_bytes, int* num_bytes,
 				void* scratch)
 			{
@@ -379,6 +578,9 @@ int main(int ac, char **av)
         {	/* Decoder */
 			// plc....
             //nBytes = 0; /* tell decoder packet is lost and needs to be concealed */
+			if (error_pattern_file && loopy_read16(error_pattern_file) == 1) {
+				nBytes = 0; /* lost according to error pattern, 16 bit words, 1 = lost */
+			}
 			if (arg.ept) {
 				static int frame_pos = 0;
 				frame_pos++;
@@ -386,10 +588,37 @@ int main(int ac, char **av)
 					nBytes = 0; // tell decoder packet is lost and needs to be concealed
 				}
 			}
+			if (arg.plc_bench) {
+				static int bench_pos = 0;
+				if (bench_pos++ % 32 >= 32 - arg.plc_bench) {
+					nBytes = 0; /* burst loss, only these frames are timed */
+				}
+			}
             /* Run Decoder */
             int16_t *output16[] = {buf_16, buf_16 + nSamples};
-			err = Dec_LC3(decoder, bytes, nBytes, output16, 16, scratch, 0);
+			scratch = lc3_scratch_arena_get(scratch_arena);
+			t0 = clock();
+			err = Dec_LC3(decoder, bytes, nBytes, output16, 16, NULL, scratch, 0);
+			if (nBytes == 0) {
+				plc_clock += clock() - t0;
+				plc_frames++;
+			}
+			exit_if(lc3_scratch_arena_check(scratch_arena), "Scratch memory overrun!");
             exit_if(err && err != LC3_DECODE_ERROR, ERROR_MESSAGE[err]);
+            if (arg.snapshot)
+            {
+                err = dec_round_trip(&decoder, &spare_dec, snapshot, snapshot_size);
+                snapshot_failed |= err != LC3_OK;
+                exit_if(err, ERROR_MESSAGE[err]);
+            }
+            if (arg.speculate)
+            {
+                /* deferred work, a real application would run this when idle */
+                scratch = lc3_scratch_arena_get(scratch_arena);
+                err     = lc3_dec16_speculate(decoder, scratch);
+                exit_if(lc3_scratch_arena_check(scratch_arena), "Scratch memory overrun!");
+                exit_if(err, ERROR_MESSAGE[err]);
+            }
 			for (ch = 0; ch < nChannels; ch++) {
 				for (i = 0; i < nSamples; i++) {
 					sample_buf[i * nChannels + ch] = output16[ch][i];
@@ -425,10 +654,22 @@ int main(int ac, char **av)
     {
         printf("%i samples clipped!\n", output_wav->clipCount);
     }
+    if (arg.plc_bench && plc_frames > 0)
+    {
+        printf("Concealed frames: %i, %.2f us/frame\n", plc_frames,
+               1e6 * (double)plc_clock / CLOCKS_PER_SEC / plc_frames);
+    }
 
     free(encoder);
     free(decoder);
-    free(scratch);
+    free(spare_enc);
+    free(spare_dec);
+    free(spec_buf);
+    free(spare_spec_buf);
+    free(silence_buf);
+    free(spare_silence_buf);
+    free(snapshot);
+    free(scratch_arena);
 
 #if WMOPS
     BASOP_end;
@@ -441,6 +682,12 @@ int main(int ac, char **av)
 #ifdef DYNMEM_COUNT
     Dyn_Mem_Exit();
 #endif
+    if (snapshot_failed)
+    {
+        puts("Snapshot round trip failed!");
+        return 1;
+    }
+    return 0;
 }
 
 /* open file with extra extension */
@@ -468,6 +715,7 @@ void cleanup(void)
     CloseWav(output_wav);
     safe_fclose(output_bitstream);
     safe_fclose(input_bitstream);
+    safe_fclose(mix_bitstream);
     safe_fclose(error_pattern_file);
     safe_fclose(error_detection_file);
     safe_fclose(bitrate_switching_file);
@@ -476,6 +724,9 @@ void cleanup(void)
     safe_fclose(channel_decoder_debug_file_bfi);
     safe_fclose(channel_decoder_debug_file_epmr);
     safe_fclose(channel_decoder_debug_file_error_report);
+#ifndef _WIN32
+    stop_workers();
+#endif
 }
 
 static void parseCmdl(int ac, char **av, Arguments *arg)
@@ -537,6 +788,43 @@ static void parseCmdl(int ac, char **av, Arguments *arg)
             arg->ept = 1;
             puts("Simulating frame loss by writing special values into lastnz variable!");
         }
+        /* speculative concealment */
+        if (!strcmp(av[pos], "-speculate"))
+        {
+            arg->speculate = 1;
+            puts("Using speculative concealment!");
+        }
+        /* parallel channel decoding */
+        if (!strcmp(av[pos], "-parallel"))
+        {
+            arg->parallel = 1;
+            puts("Decoding channels in parallel!");
+        }
+        /* state snapshot round trips */
+        if (!strcmp(av[pos], "-snapshot"))
+        {
+            arg->snapshot = 1;
+            puts("Moving the state through a snapshot after each frame!");
+        }
+        /* concealment benchmark */
+        if (!strcmp(av[pos], "-plc_bench") && pos + 1 < ac)
+        {
+            arg->plc_bench = atoi(av[++pos]);
+            exit_if(arg->plc_bench < 1 || arg->plc_bench > 31, "plc_bench must be in range [1-31]");
+            puts("Timing concealment of frame loss bursts!");
+        }
+        /* MDCT domain mix of two bitstreams */
+        if (!strcmp(av[pos], "-mix") && pos + 1 < ac)
+        {
+            arg->mix = av[++pos];
+            puts("Mixing bitstreams in the MDCT domain!");
+        }
+        /* compressed domain bitrate conversion */
+        if (!strcmp(av[pos], "-transrate"))
+        {
+            arg->transrate = 1;
+            puts("Transrating without decoding to PCM!");
+        }
         /* Bits per sample */
         if (!strcmp(av[pos], "-bps") && pos + 1 < ac)
         {
@@ -555,6 +843,18 @@ static void parseCmdl(int ac, char **av, Arguments *arg)
         {
             arg->bandwidth = av[++pos];
         }
+        /* encoder complexity level */
+        if (!strcmp(av[pos], "-complexity") && pos + 1 < ac)
+        {
+            arg->complexity = atoi(av[++pos]);
+            exit_if((unsigned)arg->complexity > LC3_ENC_COMPLEXITY_MINIMAL, "Complexity must be in range [0-2]");
+        }
+        /* encoder silence cache */
+        if (!strcmp(av[pos], "-silence_cache"))
+        {
+            arg->silence_cache = 1;
+            puts("Repeating the last frame on digital silence!");
+        }
         /* frame length in ms */
         if (!strcmp(av[pos ], "-frame_ms") && pos + 1 < ac)
         {
@@ -599,6 +899,9 @@ static void parseCmdl(int ac, char **av, Arguments *arg)
 
     exit_if(arg->encoder_only && arg->decoder_only, "Enocder and decoder modes are exclusive!");
     exit_if(arg->ept && (!arg->epf && arg->encoder_only), "Use -ept only with -E -epf FILE!");
+    exit_if(arg->mix && (arg->encoder_only || arg->decoder_only), "Use -mix without -E and -D!");
+    exit_if(arg->transrate && (arg->encoder_only || arg->decoder_only || arg->mix),
+            "Use -transrate without -E, -D and -mix!");
     exit_if(pos + 1 >= ac, MISSING_ARGUMENT_MESSAGE);
 
     arg->inputFilename  = av[pos++];
@@ -705,6 +1008,21 @@ static int read_bitstream_frame(FILE *bitstream_file, uint8_t *bytes, int size)
 	return nbytes;
 }
 
+/* read next value, restart at the beginning of the file when the end is reached */
+static int16_t loopy_read16(FILE *f)
+{
+    int16_t value = 0;
+    if (fread(&value, sizeof(value), 1, f) != 1)
+    {
+        rewind(f);
+        if (fread(&value, sizeof(value), 1, f) != 1)
+        {
+            value = 0;
+        }
+    }
+    return value;
+}
+
 
 static void scale_24_to_16(const int32_t *in, int16_t *out, int n)
 {
@@ -748,3 +1066,276 @@ static void deinterleave(int32_t *in, int32_t **out, int n, int channels)
     }
 }
 
+/* -mix: decode INPUT and the mix file to MDCT spectra, add them and code the sum at BITRATE. The mix
+   of every frame is also started from a different exponent, which must not change the result */
+/* exit_if() does not stop with basic_op, so mix errors are returned to main */
+static int run_mix(const Arguments *arg)
+{
+    uint32_t          samplerate[2] = {0}, signal_len[2] = {0};
+    int               bitrate[2] = {0}, epmode[2] = {0}, hrmode[2] = {0}, nbytes[2] = {0};
+    short             channels[2] = {0};
+    float             frame_ms[2] = {0};
+    int               i = 0, k = 0, ch = 0, n = 0, result = 0, zero = 0, exponent[2][LC3_MAX_CHANNELS], mix_exp[LC3_MAX_CHANNELS], check_exp = 0;
+    LC3_Dec *         decoder[2] = {NULL, NULL};
+    LC3_Enc *         encoder    = NULL;
+    LC3_ScratchArena *arena      = NULL;
+    LC3_Error         err        = LC3_OK;
+    static int32_t    spec_buf[2][LC3_MAX_CHANNELS][LC3_MAX_SAMPLES], mix_buf[LC3_MAX_CHANNELS][LC3_MAX_SAMPLES];
+    static int32_t    check_buf[LC3_MAX_SAMPLES];
+    static uint8_t    bytes[2][LC3_MAX_BYTES], out_bytes[LC3_MAX_BYTES];
+    int32_t *         spectrum[2][LC3_MAX_CHANNELS], *mix[LC3_MAX_CHANNELS];
+    FILE **           input[2] = {&input_bitstream, &mix_bitstream};
+    const char *      file[2];
+
+    file[0] = arg->inputFilename;
+    file[1] = arg->mix;
+    for (i = 0; i < 2; i++)
+    {
+        *input[i] = open_bitstream_reader(file[i], &samplerate[i], &bitrate[i], &channels[i], &signal_len[i],
+                                          &frame_ms[i], &epmode[i], &hrmode[i]);
+        exit_if(!*input[i], "Error opening bitstream file!");
+        exit_if(hrmode[i], "HR bitstreams not supported!");
+    }
+    exit_if(samplerate[0] != samplerate[1] || channels[0] != channels[1] || frame_ms[0] != frame_ms[1],
+            "Bitstreams to mix must have the same sample rate, channels and frame length!");
+
+    for (i = 0; i < 2; i++)
+    {
+        decoder[i] = malloc(lc3_dec_get_size(samplerate[0], channels[0], LC3_PLC_ADVANCED));
+        exit_if(!decoder[i], "Failed to allocate decoder memory!");
+        err = lc3_dec_init(decoder[i], samplerate[0], channels[0], LC3_PLC_ADVANCED);
+        exit_if(err, ERROR_MESSAGE[err]);
+        err = lc3_dec_set_frame_ms(decoder[i], frame_ms[0]);
+        exit_if(err, ERROR_MESSAGE[err]);
+        err = lc3_dec_set_ep_enabled(decoder[i], epmode[i] != 0);
+        exit_if(err, ERROR_MESSAGE[err]);
+        for (ch = 0; ch < channels[0]; ch++)
+        {
+            spectrum[i][ch] = spec_buf[i][ch];
+        }
+    }
+    for (ch = 0; ch < channels[0]; ch++)
+    {
+        mix[ch] = mix_buf[ch];
+    }
+
+    encoder = malloc(lc3_enc_get_size(samplerate[0], channels[0]));
+    exit_if(!encoder, "Failed to allocate encoder memory!");
+    err = lc3_enc_init(encoder, samplerate[0], channels[0]);
+    exit_if(err, ERROR_MESSAGE[err]);
+    err = lc3_enc_set_frame_ms(encoder, frame_ms[0]);
+    exit_if(err, ERROR_MESSAGE[err]);
+    err = lc3_enc_set_ep_mode(encoder, (LC3_EpMode)arg->epmode);
+    exit_if(err, ERROR_MESSAGE[err]);
+    err = lc3_enc_set_bitrate(encoder, arg->bitrate);
+    exit_if(err, ERROR_MESSAGE[err]);
+    n = encoder->frame_length;
+
+    arena = malloc(lc3_scratch_arena_get_size(samplerate[0], channels[0]));
+    exit_if(!arena, "Failed to allocate scratch memory!");
+    err = lc3_scratch_arena_init(arena, samplerate[0], channels[0]);
+    exit_if(err, ERROR_MESSAGE[err]);
+
+    output_bitstream = open_bitstream_writer(arg->outputFilename, samplerate[0], arg->bitrate, channels[0],
+                                             MIN(signal_len[0], signal_len[1]), frame_ms[0], arg->epmode);
+    exit_if(!output_bitstream, "Error creating bitstream file!");
+
+    /* up to the end of the shorter bitstream */
+    while (!result && (nbytes[0] = read_bitstream_frame(input_bitstream, bytes[0], LC3_MAX_BYTES)) >= 0 &&
+           (nbytes[1] = read_bitstream_frame(mix_bitstream, bytes[1], LC3_MAX_BYTES)) >= 0)
+    {
+        for (i = 0; i < 2; i++)
+        {
+            err = lc3_dec_spectrum(decoder[i], bytes[i], nbytes[i], spectrum[i], exponent[i],
+                                   lc3_scratch_arena_get(arena));
+            exit_if(lc3_scratch_arena_check(arena), "Scratch memory overrun!");
+            exit_if(err && err != LC3_DECODE_ERROR, ERROR_MESSAGE[err]);
+        }
+
+        for (ch = 0; ch < channels[0]; ch++)
+        {
+            memset(mix[ch], 0, n * sizeof(*mix[ch]));
+            memset(check_buf, 0, n * sizeof(*check_buf));
+            mix_exp[ch] = 0;
+            check_exp   = 128;
+            for (i = 0; i < 2; i++)
+            {
+                err = lc3_spectrum_mix(mix[ch], &mix_exp[ch], spectrum[i][ch], exponent[i][ch], 1.0f, n);
+                exit_if(err, ERROR_MESSAGE[err]);
+                err = lc3_spectrum_mix(check_buf, &check_exp, spectrum[i][ch], exponent[i][ch], 1.0f, n);
+                exit_if(err, ERROR_MESSAGE[err]);
+            }
+            /* the exponent of a zero mix does not matter */
+            for (k = 0, zero = 1; k < n; k++)
+            {
+                zero = zero && !mix[ch][k];
+            }
+            if ((!zero && check_exp != mix_exp[ch]) || memcmp(check_buf, mix[ch], n * sizeof(*check_buf)))
+            {
+                puts("Mix depends on its start exponent!");
+                result = 1;
+            }
+        }
+
+        err = lc3_enc_spectrum(encoder, mix, mix_exp, out_bytes, &nbytes[0], lc3_scratch_arena_get(arena));
+        exit_if(lc3_scratch_arena_check(arena), "Scratch memory overrun!");
+        if (err)
+        {
+            puts(ERROR_MESSAGE[err]);
+            result = 1;
+        }
+        write_bitstream_frame(output_bitstream, out_bytes, nbytes[0]);
+    }
+
+    if (!result)
+    {
+        puts("\nProcessing done!");
+    }
+    free(decoder[0]);
+    free(decoder[1]);
+    free(encoder);
+    free(arena);
+    return result;
+}
+
+/* -transrate: requantize the spectrum of every INPUT frame at BITRATE, the side information is carried
+   over. A lost or broken input frame is written as a lost frame */
+static int run_transrate(const Arguments *arg)
+{
+    uint32_t          samplerate = 0, signal_len = 0;
+    int               bitrate = 0, epmode = 0, hrmode = 0, nbytes = 0, nbytes_out = 0, result = 0;
+    short             channels = 0;
+    float             frame_ms = 0;
+    LC3_Dec *         decoder = NULL;
+    LC3_Enc *         encoder = NULL;
+    LC3_ScratchArena *arena   = NULL;
+    LC3_Error         err     = LC3_OK;
+    static uint8_t    bytes[LC3_MAX_BYTES], out_bytes[LC3_MAX_BYTES];
+
+    input_bitstream = open_bitstream_reader(arg->inputFilename, &samplerate, &bitrate, &channels, &signal_len,
+                                            &frame_ms, &epmode, &hrmode);
+    exit_if(!input_bitstream, "Error opening bitstream file!");
+    exit_if(hrmode, "HR bitstreams not supported!");
+
+    decoder = malloc(lc3_dec_get_size(samplerate, channels, LC3_PLC_ADVANCED));
+    exit_if(!decoder, "Failed to allocate decoder memory!");
+    err = lc3_dec_init(decoder, samplerate, channels, LC3_PLC_ADVANCED);
+    exit_if(err, ERROR_MESSAGE[err]);
+    err = lc3_dec_set_frame_ms(decoder, frame_ms);
+    exit_if(err, ERROR_MESSAGE[err]);
+    err = lc3_dec_set_ep_enabled(decoder, epmode != 0);
+    exit_if(err, ERROR_MESSAGE[err]);
+
+    encoder = malloc(lc3_enc_get_size(samplerate, channels));
+    exit_if(!encoder, "Failed to allocate encoder memory!");
+    err = lc3_enc_init(encoder, samplerate, channels);
+    exit_if(err, ERROR_MESSAGE[err]);
+    err = lc3_enc_set_frame_ms(encoder, frame_ms);
+    exit_if(err, ERROR_MESSAGE[err]);
+    err = lc3_enc_set_ep_mode(encoder, (LC3_EpMode)arg->epmode);
+    exit_if(err, ERROR_MESSAGE[err]);
+    err = lc3_enc_set_bitrate(encoder, arg->bitrate);
+    exit_if(err, ERROR_MESSAGE[err]);
+
+    arena = malloc(lc3_scratch_arena_get_size(samplerate, channels));
+    exit_if(!arena, "Failed to allocate scratch memory!");
+    err = lc3_scratch_arena_init(arena, samplerate, channels);
+    exit_if(err, ERROR_MESSAGE[err]);
+
+    output_bitstream = open_bitstream_writer(arg->outputFilename, samplerate, arg->bitrate, channels, signal_len,
+                                             frame_ms, arg->epmode);
+    exit_if(!output_bitstream, "Error creating bitstream file!");
+
+    while (!result && (nbytes = read_bitstream_frame(input_bitstream, bytes, LC3_MAX_BYTES)) >= 0)
+    {
+        err = lc3_transrate(encoder, decoder, bytes, nbytes, out_bytes, &nbytes_out, lc3_scratch_arena_get(arena));
+        exit_if(lc3_scratch_arena_check(arena), "Scratch memory overrun!");
+        if (err && err != LC3_DECODE_ERROR)
+        {
+            puts(ERROR_MESSAGE[err]);
+            result = 1;
+        }
+        write_bitstream_frame(output_bitstream, out_bytes, nbytes_out);
+    }
+
+    if (!result)
+    {
+        puts("\nProcessing done!");
+    }
+    free(decoder);
+    free(encoder);
+    free(arena);
+    return result;
+}
+
+/* decoder with the options of the command line, the workers are shared */
+static LC3_Dec *open_decoder(const Arguments *arg, uint32_t sampleRate, short nChannels, void **spec_buf)
+{
+    LC3_Error err     = LC3_OK;
+    LC3_Dec * decoder = malloc(lc3_dec_get_size(sampleRate, nChannels, (LC3_PlcMode)arg->plcMeth));
+
+    exit_if(!decoder, "Failed to allocate decoder memory!");
+    err = lc3_dec_init(decoder, sampleRate, nChannels, (LC3_PlcMode)arg->plcMeth);
+    exit_if(err, ERROR_MESSAGE[err]);
+
+    err = lc3_dec_set_frame_ms(decoder, arg->frame_ms);
+    exit_if(err, ERROR_MESSAGE[err]);
+
+    err = lc3_dec_set_ep_enabled(decoder, arg->epmode != 0);
+    exit_if(err, ERROR_MESSAGE[err]);
+
+    if (arg->speculate)
+    {
+        *spec_buf = malloc(lc3_dec_get_speculation_size(decoder));
+        err       = lc3_dec_set_speculation(decoder, *spec_buf);
+        exit_if(err, ERROR_MESSAGE[err]);
+    }
+
+#ifndef _WIN32
+    if (arg->parallel)
+    {
+        err = lc3_dec_set_parallel(decoder, parallel_for, &worker_pool);
+        exit_if(err, ERROR_MESSAGE[err]);
+    }
+#endif
+
+    return decoder;
+}
+
+/* -snapshot: continue the stream on the spare encoder, restored from a snapshot of the state */
+static LC3_Error enc_round_trip(LC3_Enc **encoder, LC3_Enc **spare, void *snapshot, int size)
+{
+    LC3_Enc * tmp = NULL;
+    LC3_Error err = lc3_enc_snapshot(*encoder, snapshot, size);
+
+    if (err == LC3_OK)
+    {
+        err = lc3_enc_restore(*spare, snapshot, size);
+    }
+    if (err == LC3_OK)
+    {
+        tmp      = *encoder;
+        *encoder = *spare;
+        *spare   = tmp;
+    }
+    return err;
+}
+
+/* -snapshot: continue the stream on the spare decoder, restored from a snapshot of the state */
+static LC3_Error dec_round_trip(LC3_Dec **decoder, LC3_Dec **spare, void *snapshot, int size)
+{
+    LC3_Dec * tmp = NULL;
+    LC3_Error err = lc3_dec_snapshot(*decoder, snapshot, size);
+
+    if (err == LC3_OK)
+    {
+        err = lc3_dec_restore(*spare, snapshot, size);
+    }
+    if (err == LC3_OK)
+    {
+        tmp      = *decoder;
+        *decoder = *spare;
+        *spare   = tmp;
+    }
+    return err;
+}
@@ -0,0 +1,210 @@
+#!/bin/sh
+#  /******************************************************************************
+#  *                        ETSI TS 103 634 V1.1.1                               *
+#  *              Low Complexity Communication Codec Plus (LC3plus)              *
+#  *                                                                             *
+#  * Copyright licence is solely granted through ETSI Intellectual Property      *
+#  * Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+#  * estoppel or otherwise.                                                      *
+#  ******************************************************************************/
+
+# Bit-exact conformance check, run with "make conformance".
+#
+# Usage: conformance.sh REF_BIN TEST_BIN SIGGEN_BIN [WORK_DIR [SELF_BIN [VECTOR_BIN]]]
+#
+# Every test signal is encoded by both binaries for all bitrates and EP modes and the bitstreams
+# are compared byte for byte. Every bitstream is then decoded by both binaries without loss, with
+# the error pattern of siggen (-epf), with -ept and with burst losses (-plc_bench), and the PCM
+# outputs are compared byte for byte. REF_BIN may predate -epf and -plc_bench while decoding, so
+# it decodes copies of the bitstream with the lost frames emptied by siggen -drop instead.
+# TEST_BIN has to decode with -parallel, also with frame loss and bit errors, what REF_BIN decodes
+# sequentially. It also has to give the same bitstreams and PCM outputs when the state goes
+# through a snapshot round trip after each frame (-snapshot), and the same bitstreams with the
+# silence cache attached (-silence_cache). VECTOR_BIN, TEST_BIN if not given, has to reproduce the
+# reference vectors in msvc/.
+# Combinations that neither binary can run are skipped.
+#
+# The API modes of codec_exe that REF_BIN may predate (-mix, -transrate) are compared against
+# SELF_BIN, an unoptimized build of the same sources as TEST_BIN. TEST_BIN has to run them and exit
+# with 0.
+#
+# The matrix can be narrowed with the environment variables FRAME_MS, BITRATES and EPMODES.
+# Exit status is 0 if all outputs match.
+
+REF=$1
+TEST=$2
+SIGGEN=$3
+WORK=${4:-build_conf}
+SELF=$5
+VECTOR=${6:-$TEST}
+
+FRAME_MS=${FRAME_MS:-5}
+BITRATES=${BITRATES:-"32000 64000 128000 240000"}
+EPMODES=${EPMODES:-"0 1 2 3 4"}
+
+checks=0
+failed=0
+skipped=0
+
+fail()
+{
+    echo "FAIL $1"
+    failed=$((failed + 1))
+}
+
+# compare two outputs, both missing means the combination is not supported
+compare()
+{
+    checks=$((checks + 1))
+    if [ ! -s "$1" ] && [ ! -s "$2" ]; then
+        skipped=$((skipped + 1))
+        return 1
+    fi
+    if ! cmp -s "$1" "$2"; then
+        fail "$3"
+        return 1
+    fi
+    return 0
+}
+
+# compare an output of an API mode, TEST has to produce it whenever SELF does
+compare_api()
+{
+    checks=$((checks + 1))
+    if [ ! -s "$1" ]; then
+        skipped=$((skipped + 1))
+        return 1
+    fi
+    if [ ! -s "$2" ] || ! cmp -s "$1" "$2"; then
+        fail "$3"
+        return 1
+    fi
+    return 0
+}
+
+rm -rf "$WORK/sig" "$WORK/ref" "$WORK/test" "$WORK/self"
+mkdir -p "$WORK/sig" "$WORK/ref" "$WORK/test" "$WORK/self" || exit 2
+"$SIGGEN" "$WORK/sig" || exit 2
+cp msvc/Test.wav "$WORK/sig/test_48000_2.wav" || exit 2
+
+# stored reference vectors
+"$VECTOR" -q -E -frame_ms 5 msvc/Test.wav "$WORK/test/vector.lc3" 240000 >/dev/null 2>&1
+"$VECTOR" -q -D "$WORK/test/vector.lc3" "$WORK/test/vector.wav" >/dev/null 2>&1
+checks=$((checks + 2))
+cmp -s "$WORK/test/vector.lc3" msvc/test.lc3 || fail "msvc/test.lc3"
+cmp -s "$WORK/test/vector.wav" msvc/Testout.wav || fail "msvc/Testout.wav"
+
+for sig in "$WORK"/sig/*.wav; do
+    name=$(basename "$sig" .wav)
+    for ms in $FRAME_MS; do
+        for br in $BITRATES; do
+            for ep in $EPMODES; do
+                tag=${name}_${ms}_${br}_ep${ep}
+                for bin in ref test; do
+                    [ $bin = ref ] && exe=$REF || exe=$TEST
+                    "$exe" -q -E -frame_ms "$ms" -epmode "$ep" "$sig" "$WORK/$bin/$tag.lc3" "$br" >/dev/null 2>&1
+                done
+                compare "$WORK/ref/$tag.lc3" "$WORK/test/$tag.lc3" "$tag.lc3" || continue
+
+                "$TEST" -q -E -snapshot -frame_ms "$ms" -epmode "$ep" "$sig" "$WORK/test/${tag}_snap.lc3" "$br" \
+                    >/dev/null 2>&1 || rm -f "$WORK/test/${tag}_snap.lc3"
+                compare "$WORK/ref/$tag.lc3" "$WORK/test/${tag}_snap.lc3" "${tag}_snap.lc3"
+
+                for opts in "-silence_cache" "-silence_cache -snapshot"; do
+                    out="$WORK/test/${tag}_sil$(echo $opts | tr -d ' ').lc3"
+                    "$TEST" -q -E $opts -frame_ms "$ms" -epmode "$ep" "$sig" "$out" "$br" >/dev/null 2>&1 || rm -f "$out"
+                    compare "$WORK/ref/$tag.lc3" "$out" "$(basename "$out")"
+                done
+
+                "$SIGGEN" -drop "$WORK/sig/loss.epf" "$WORK/ref/$tag.lc3" "$WORK/ref/${tag}_epf.lc3" || exit 2
+                "$SIGGEN" -drop "$WORK/sig/burst.epf" "$WORK/ref/$tag.lc3" "$WORK/ref/${tag}_burst.lc3" || exit 2
+
+                for loss in none epf ept burst; do
+                    case $loss in
+                    none) opts= ref_opts= in=$tag ;;
+                    epf) opts="-epf $WORK/sig/loss.epf" ref_opts= in=${tag}_epf ;;
+                    ept) opts=-ept ref_opts=-ept in=$tag ;;
+                    burst) opts="-plc_bench 4" ref_opts= in=${tag}_burst ;;
+                    esac
+                    # decode the reference bitstream, so a decoder mismatch is reported on its own
+                    "$REF" -q -D $ref_opts "$WORK/ref/$in.lc3" "$WORK/ref/${tag}_$loss.wav" >/dev/null 2>&1
+                    "$TEST" -q -D $opts "$WORK/ref/$tag.lc3" "$WORK/test/${tag}_$loss.wav" >/dev/null 2>&1
+                    compare "$WORK/ref/${tag}_$loss.wav" "$WORK/test/${tag}_$loss.wav" "${tag}_$loss.wav"
+                done
+
+                for loss in none epf; do
+                    case $loss in
+                    none) opts= ;;
+                    epf) opts="-epf $WORK/sig/loss.epf" ;;
+                    esac
+                    "$TEST" -q -D -snapshot $opts "$WORK/ref/$tag.lc3" "$WORK/test/${tag}_snap_$loss.wav" \
+                        >/dev/null 2>&1 || rm -f "$WORK/test/${tag}_snap_$loss.wav"
+                    compare "$WORK/ref/${tag}_$loss.wav" "$WORK/test/${tag}_snap_$loss.wav" "${tag}_snap_$loss.wav"
+                done
+
+                # overwrite a byte every 1000 bytes, the first channel with a detected bit error
+                # conceals the following channels of its frame
+                cp "$WORK/ref/$tag.lc3" "$WORK/ref/${tag}_bad.lc3"
+                size=$(wc -c <"$WORK/ref/$tag.lc3")
+                pos=500
+                while [ $pos -lt "$size" ]; do
+                    printf '\245' | dd of="$WORK/ref/${tag}_bad.lc3" bs=1 seek=$pos conv=notrunc 2>/dev/null
+                    pos=$((pos + 1000))
+                done
+                "$REF" -q -D "$WORK/ref/${tag}_bad.lc3" "$WORK/ref/${tag}_bad.wav" >/dev/null 2>&1
+
+                for loss in none epf bad; do
+                    case $loss in
+                    none) opts= in=$tag ;;
+                    epf) opts="-epf $WORK/sig/loss.epf" in=$tag ;;
+                    bad) opts= in=${tag}_bad ;;
+                    esac
+                    "$TEST" -q -D -parallel $opts "$WORK/ref/$in.lc3" "$WORK/test/${tag}_par_$loss.wav" >/dev/null 2>&1
+                    compare "$WORK/ref/${tag}_$loss.wav" "$WORK/test/${tag}_par_$loss.wav" "${tag}_par_$loss.wav"
+                done
+            done
+        done
+    done
+done
+
+# MDCT domain mix of two bitstreams, which also checks that the mix does not depend on its start
+# exponent
+if [ -n "$SELF" ]; then
+    for ms in $FRAME_MS; do
+        for br in $BITRATES; do
+            for ep in $EPMODES; do
+                tag=mix_${ms}_${br}_ep${ep}
+                for bin in self test; do
+                    [ $bin = self ] && exe=$SELF || exe=$TEST
+                    "$exe" -q -mix "$WORK/ref/noise_48000_2_${ms}_${br}_ep${ep}.lc3" -epmode "$ep" \
+                        "$WORK/ref/test_48000_2_${ms}_${br}_ep${ep}.lc3" "$WORK/$bin/$tag.lc3" "$br" \
+                        >/dev/null 2>&1 || rm -f "$WORK/$bin/$tag.lc3"
+                done
+                compare_api "$WORK/self/$tag.lc3" "$WORK/test/$tag.lc3" "$tag.lc3"
+            done
+        done
+    done
+fi
+
+# compressed domain transrating of the highest bitrate to every bitrate, lost frames included
+if [ -n "$SELF" ]; then
+    for br in $BITRATES; do
+        top=$br
+    done
+    for ms in $FRAME_MS; do
+        for br in $BITRATES; do
+            for ep in $EPMODES; do
+                tag=transrate_${ms}_${br}_ep${ep}
+                for bin in self test; do
+                    [ $bin = self ] && exe=$SELF || exe=$TEST
+                    "$exe" -q -transrate -epmode "$ep" "$WORK/ref/test_48000_2_${ms}_${top}_ep${ep}_bad.lc3" \
+                        "$WORK/$bin/$tag.lc3" "$br" >/dev/null 2>&1 || rm -f "$WORK/$bin/$tag.lc3"
+                done
+                compare_api "$WORK/self/$tag.lc3" "$WORK/test/$tag.lc3" "$tag.lc3"
+            done
+        done
+    done
+fi
+
+echo "conformance: $checks checks, $failed failed, $skipped skipped (not supported by either build)"
+[ $failed -eq 0 ]
@@ -0,0 +1,258 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+/* Synthetic test signals and an error pattern for the conformance check (conformance.sh).
+
+   Usage: siggen DIR
+          siggen -drop EPF IN OUT
+
+   Writes NAME_RATE_CHANNELS.wav files of one second each and loss.epf, a packet loss pattern of
+   16 bit words (1 = lost) with single losses and bursts as read by LC3plus -epf. burst.epf loses
+   the same frames as LC3plus -plc_bench 4. The signals are chosen to reach the corner cases of the
+   fixed point code: full scale and clipped input, digital silence, signals just above silence,
+   strong transients and wideband noise.
+
+   With -drop the bitstream IN is copied to OUT with the frames that EPF marks as lost emptied.
+   Frames of 0 bytes are concealed by every LC3plus version, also by those that ignore -epf. */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tinywaveout_c.h"
+
+#define DURATION_MS 1000
+#define PI 3.14159265358979
+
+typedef enum
+{
+    SWEEP,
+    NOISE,
+    TRANSIENTS,
+    SQUARE,
+    SILENCE,
+    LOWLEVEL,
+    TONES
+} Signal;
+
+static const struct
+{
+    const char *name;
+    Signal      signal;
+    int         samplerate;
+    int         channels;
+} signals[] = {
+    {"sweep", SWEEP, 48000, 1},           {"sweep", SWEEP, 44100, 2},  {"noise", NOISE, 48000, 2},
+    {"transients", TRANSIENTS, 48000, 2}, {"square", SQUARE, 48000, 2}, {"silence", SILENCE, 48000, 2},
+    {"lowlevel", LOWLEVEL, 48000, 2},     {"tones", TONES, 44100, 1},
+};
+
+static uint32_t seed = 1;
+
+/* uniform in [-1, 1) */
+static double noise(void)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (double)(int32_t)seed / 2147483648.0;
+}
+
+static double sample(Signal signal, int ch, long n, int samplerate)
+{
+    double t = (double)n / samplerate;
+
+    switch (signal)
+    {
+    case SWEEP: /* exponential 20 Hz to 20 kHz, -6 dBFS */
+        return 0.5 * sin(2 * PI * 20 * DURATION_MS / 1000.0 / log(1000) * (pow(1000, t * 1000 / DURATION_MS) - 1) +
+                         ch * PI / 2);
+    case NOISE: /* white, -6 dBFS peak */
+        return 0.5 * noise();
+    case TRANSIENTS: /* decaying noise bursts every 150 ms, offset between channels */
+    {
+        double u = fmod(t + ch * 0.07, 0.15);
+        return 0.9 * exp(-u * 200) * noise();
+    }
+    case SQUARE: /* 1 kHz, clipped at full scale */
+        return sin(2 * PI * (1000 + 100 * ch) * t) >= 0 ? 1.5 : -1.5;
+    case SILENCE: return 0;
+    case LOWLEVEL: /* a few LSB of noise */
+        return 4.0 / 32768 * noise();
+    case TONES: /* harmonic complex with vibrato */
+    {
+        double x = 0;
+        int    k;
+        for (k = 1; k <= 8; k++)
+        {
+            x += 0.1 / k * sin(2 * PI * 220 * k * (t + 0.002 * sin(2 * PI * 5 * t)));
+        }
+        return x;
+    }
+    }
+    return 0;
+}
+
+static void write_signal(const char *dir, int idx)
+{
+    char         file[1024];
+    WAVEFILEOUT *wav;
+    int          buf[2];
+    long         n, len = (long)signals[idx].samplerate * DURATION_MS / 1000;
+    int          ch;
+
+    sprintf(file, "%s/%s_%d_%d.wav", dir, signals[idx].name, signals[idx].samplerate, signals[idx].channels);
+    wav = CreateWav(file, signals[idx].samplerate, signals[idx].channels, 16);
+    if (!wav)
+    {
+        fprintf(stderr, "Error creating %s\n", file);
+        exit(1);
+    }
+    for (n = 0; n < len; n++)
+    {
+        for (ch = 0; ch < signals[idx].channels; ch++)
+        {
+            double x = 32768 * sample(signals[idx].signal, ch, n, signals[idx].samplerate);
+            buf[ch]  = (int)(x > 32767 ? 32767 : x < -32768 ? -32768 : x);
+        }
+        WriteWavLong(wav, buf, signals[idx].channels);
+    }
+    CloseWav(wav);
+}
+
+/* about 10% loss, half of it in bursts of up to 6 frames */
+static void write_error_pattern(const char *dir)
+{
+    char  file[1024];
+    FILE *f;
+    int   i, burst = 0;
+
+    sprintf(file, "%s/loss.epf", dir);
+    f = fopen(file, "wb");
+    if (!f)
+    {
+        fprintf(stderr, "Error creating %s\n", file);
+        exit(1);
+    }
+    for (i = 0; i < 400; i++)
+    {
+        int16_t lost = 0;
+        double  r    = noise();
+        if (burst > 0)
+        {
+            burst--;
+            lost = 1;
+        }
+        else if (r > 0.95)
+        {
+            lost = 1;
+        }
+        else if (r < -0.985)
+        {
+            burst = 1 + (int)(5 * (noise() + 1) / 2);
+            lost  = 1;
+        }
+        fwrite(&lost, sizeof(lost), 1, f);
+    }
+    fclose(f);
+
+    sprintf(file, "%s/burst.epf", dir);
+    f = fopen(file, "wb");
+    if (!f)
+    {
+        fprintf(stderr, "Error creating %s\n", file);
+        exit(1);
+    }
+    for (i = 0; i < 32; i++)
+    {
+        int16_t lost = i >= 32 - 4;
+        fwrite(&lost, sizeof(lost), 1, f);
+    }
+    fclose(f);
+}
+
+/* next word of the error pattern, it restarts at the end like in LC3plus */
+static int16_t read_loss(FILE *f)
+{
+    int16_t lost = 0;
+    if (fread(&lost, sizeof(lost), 1, f) != 1)
+    {
+        rewind(f);
+        if (fread(&lost, sizeof(lost), 1, f) != 1)
+        {
+            lost = 0;
+        }
+    }
+    return lost;
+}
+
+/* copy a bitstream file (header, then 16 bit length and payload per frame) emptying lost frames */
+static int drop_frames(const char *epf, const char *in, const char *out)
+{
+    FILE *   p = fopen(epf, "rb"), *fi = fopen(in, "rb"), *fo = fopen(out, "wb");
+    uint8_t  buf[2048];
+    uint16_t header[2], len = 0, empty = 0;
+
+    if (!p || !fi || !fo || fread(header, sizeof(header), 1, fi) != 1 || header[1] < sizeof(header) ||
+        header[1] > sizeof(buf))
+    {
+        fprintf(stderr, "Error opening %s, %s or %s\n", epf, in, out);
+        return 1;
+    }
+    memcpy(buf, header, sizeof(header));
+    if (fread(buf + sizeof(header), 1, header[1] - sizeof(header), fi) != header[1] - sizeof(header))
+    {
+        fprintf(stderr, "Error reading %s\n", in);
+        return 1;
+    }
+    fwrite(buf, 1, header[1], fo);
+
+    while (fread(&len, sizeof(len), 1, fi) == 1)
+    {
+        if (len > sizeof(buf) || fread(buf, 1, len, fi) != len)
+        {
+            fprintf(stderr, "Error reading %s\n", in);
+            return 1;
+        }
+        if (read_loss(p) == 1)
+        {
+            fwrite(&empty, sizeof(empty), 1, fo);
+        }
+        else
+        {
+            fwrite(&len, sizeof(len), 1, fo);
+            fwrite(buf, 1, len, fo);
+        }
+    }
+    fclose(p);
+    fclose(fi);
+    fclose(fo);
+    return 0;
+}
+
+int main(int ac, char **av)
+{
+    int i;
+
+    if (ac == 5 && !strcmp(av[1], "-drop"))
+    {
+        return drop_frames(av[2], av[3], av[4]);
+    }
+    if (ac != 2)
+    {
+        fprintf(stderr, "Usage: siggen DIR\n       siggen -drop EPF IN OUT\n");
+        return 1;
+    }
+    for (i = 0; i < (int)(sizeof(signals) / sizeof(signals[0])); i++)
+    {
+        write_signal(av[1], i);
+    }
+    write_error_pattern(av[1]);
+    return 0;
+}
@@ -2382,59 +2382,26 @@ RAM_ALIGN const Word16 st1SCF8_15_base5_32x8_Q14[256] = {
 
 /*  tables for   MPVQ pulse enumeration  */
 
-/* N=16, K=12  31.74 bits */
-RAM_ALIGN const UWord32 h_memN16K12[12 + 2] = {
-    0U,       1U,       31U,       481U,      4991U,      39041U,     246047U,
-    1303777U, 5984767U, 24331777U, 89129247U, 298199265U, 921406335U, /*U*/ 1326824512U};
-
-/*N=16,K=8,h_memN16K8={0U,1U,31U,481U,4991U,39041U,246047U,1303777U,5984767U,  12165888U,}; */
-
-/*N=10, K=20
-UWord32 h_memN10K20[20+2] =
-{
-    0U,1U,19U,181U,1159U,5641U,22363U,75517U,224143U,598417U,1462563U,
-    3317445U,7059735U,14218905U,27298155U,50250765U,89129247U,152951073U,254831667U,413442773U,654862247U,
-    507444884U
-};
-*/
-/*N=10, K=22  31.84 bits */
-RAM_ALIGN const UWord32 h_memN10K22[22 + 2] = {0U,
-                                               1U,
-                                               19U,
-                                               181U,
-                                               1159U,
-                                               5641U,
-                                               22363U,
-                                               75517U,
-                                               224143U,
-                                               598417U,
-                                               1462563U,
-                                               3317445U,
-                                               7059735U,
-                                               14218905U,
-                                               27298155U,
-                                               50250765U,
-                                               89129247U,
-                                               152951073U,
-                                               254831667U,
-                                               413442773U,
-                                               654862247U,
-                                               1014889769U,
-                                               1541911931U,
-                                               /*U*/ 1150204814U};
-/* N=10,K=10,h_memN10K10={0U,1U,19U,181U,1159U,5641U,22363U,75517U,224143U,598417U,1462563U,1658722U,};  */
-
-/* N=6,K=2,*/
-RAM_ALIGN const UWord32 h_memN6K2[2 + 2] = {0U, 1U, 11U, /*U*/ 30U};
-/*N=6,K=1, h_memN6K1={0U,1U, 5U,};  */
-
-RAM_ALIGN const UWord32 *const MPVQ_offs_ptr[M + 1] = {NULL /*0*/, NULL, NULL, NULL, NULL,        NULL,
-                                                       h_memN6K2,  NULL, NULL, NULL, h_memN10K22, NULL,
-                                                       NULL,       NULL, NULL, NULL, h_memN16K12};
-
-/*maxK coefficents for MPVQ de-indexing lookup */
-RAM_ALIGN const Word16 tabledKMAX[M + 1] = {
-    0, 0, 0, 0, 0, 0, 2 /*N=6*/, 0, 0, 0, 22 /*N=10*/, 0, 0, 0, 0, 0, 12 /*N=16*/
+/* MPVQ offsets A(N,K) for N = 0..16 and K = 0..KMAX_FX+1, A(N,K) = A(N-1,K) + A(N-1,K-1) + A(N,K-1), A(1,K) = 1.
+   Row N holds the offsets of the remaining N positions, U(N,K+1) = A(N,K+1) >> 1 */
+RAM_ALIGN const UWord32 mpvq_offsets[M + 1][KMAX_FX + 2] = {
+    {0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U}, /* N=0 */
+    {0U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U}, /* N=1 */
+    {0U, 1U, 3U, 5U, 7U, 9U, 11U, 13U, 15U, 17U, 19U, 21U}, /* N=2 */
+    {0U, 1U, 5U, 13U, 25U, 41U, 61U, 85U, 113U, 145U, 181U, 221U}, /* N=3 */
+    {0U, 1U, 7U, 25U, 63U, 129U, 231U, 377U, 575U, 833U, 1159U, 1561U}, /* N=4 */
+    {0U, 1U, 9U, 41U, 129U, 321U, 681U, 1289U, 2241U, 3649U, 5641U, 8361U}, /* N=5 */
+    {0U, 1U, 11U, 61U, 231U, 681U, 1683U, 3653U, 7183U, 13073U, 22363U, 36365U}, /* N=6 */
+    {0U, 1U, 13U, 85U, 377U, 1289U, 3653U, 8989U, 19825U, 40081U, 75517U, 134245U}, /* N=7 */
+    {0U, 1U, 15U, 113U, 575U, 2241U, 7183U, 19825U, 48639U, 108545U, 224143U, 433905U}, /* N=8 */
+    {0U, 1U, 17U, 145U, 833U, 3649U, 13073U, 40081U, 108545U, 265729U, 598417U, 1256465U}, /* N=9 */
+    {0U, 1U, 19U, 181U, 1159U, 5641U, 22363U, 75517U, 224143U, 598417U, 1462563U, 3317445U}, /* N=10 */
+    {0U, 1U, 21U, 221U, 1561U, 8361U, 36365U, 134245U, 433905U, 1256465U, 3317445U, 8097453U}, /* N=11 */
+    {0U, 1U, 23U, 265U, 2047U, 11969U, 56695U, 227305U, 795455U, 2485825U, 7059735U, 18474633U}, /* N=12 */
+    {0U, 1U, 25U, 313U, 2625U, 16641U, 85305U, 369305U, 1392065U, 4673345U, 14218905U, 39753273U}, /* N=13 */
+    {0U, 1U, 27U, 365U, 3303U, 22569U, 124515U, 579125U, 2340495U, 8405905U, 27298155U, 81270333U}, /* N=14 */
+    {0U, 1U, 29U, 421U, 4089U, 29961U, 177045U, 880685U, 3800305U, 14546705U, 50250765U, 158819253U}, /* N=15 */
+    {0U, 1U, 31U, 481U, 4991U, 39041U, 246047U, 1303777U, 5984767U, 24331777U, 89129247U, 298199265U}, /* N=16 */
 };
 
 RAM_ALIGN const Word16 isqrt_Q16tab[1 + 64] = {/*table generated using ISqrt16 function + shift to Q16 */
@@ -2452,3 +2419,250 @@ RAM_ALIGN const Word16 adjust_global_gain_tables[5][5] = {{80, 230, 380, 530, 68
                                                           {189, 164, 155, 151, 148},
                                                           {1310, 3241, 5268, 7326, 9400}};
 
+
+#ifdef LC3_FLOAT_ANALYSIS
+/* exp(-2*pi*i*k/FL_TW_LEN), twiddles of the float analysis fft */
+RAM_ALIGN const float fl_twiddle_re[FL_TW_LEN] = {
+    1.0f, 0.999978602f, 0.999914348f, 0.999807239f, 0.999657333f, 0.999464571f, 0.999229014f, 0.99895066f,
+    0.99862951f, 0.998265624f, 0.997858942f, 0.997409463f, 0.996917307f, 0.996382475f, 0.995804906f, 0.99518472f,
+    0.994521916f, 0.993816435f, 0.993068457f, 0.99227792f, 0.991444886f, 0.990569353f, 0.989651382f, 0.988691032f,
+    0.987688363f, 0.986643314f, 0.985556066f, 0.984426558f, 0.98325491f, 0.982041121f, 0.980785251f, 0.979487419f,
+    0.978147626f, 0.976765871f, 0.975342333f, 0.973876953f, 0.972369909f, 0.970821202f, 0.96923089f, 0.967599094f,
+    0.965925813f, 0.964211166f, 0.962455213f, 0.960658073f, 0.958819747f, 0.956940353f, 0.955019951f, 0.95305866f,
+    0.95105654f, 0.94901365f, 0.94693011f, 0.944806039f, 0.942641497f, 0.940436542f, 0.938191354f, 0.935905933f,
+    0.933580399f, 0.931214929f, 0.928809524f, 0.926364362f, 0.923879504f, 0.921355128f, 0.918791234f, 0.916187942f,
+    0.91354543f, 0.910863817f, 0.908143163f, 0.905383646f, 0.902585268f, 0.899748266f, 0.896872759f, 0.893958807f,
+    0.891006529f, 0.888016105f, 0.884987652f, 0.881921291f, 0.878817141f, 0.875675321f, 0.872496009f, 0.869279325f,
+    0.866025388f, 0.862734377f, 0.859406412f, 0.85604161f, 0.852640152f, 0.849202156f, 0.845727801f, 0.842217207f,
+    0.838670552f, 0.835087955f, 0.831469595f, 0.827815652f, 0.824126184f, 0.82040143f, 0.816641569f, 0.812846661f,
+    0.809017003f, 0.805152655f, 0.801253796f, 0.797320664f, 0.793353319f, 0.789352059f, 0.785316944f, 0.781248152f,
+    0.777145982f, 0.773010433f, 0.768841803f, 0.764640272f, 0.760405958f, 0.7561391f, 0.751839817f, 0.747508347f,
+    0.74314481f, 0.738749504f, 0.734322488f, 0.729864061f, 0.725374401f, 0.720853567f, 0.716301918f, 0.711719632f,
+    0.707106769f, 0.702463686f, 0.697790444f, 0.693087339f, 0.688354552f, 0.683592319f, 0.678800762f, 0.673980117f,
+    0.669130623f, 0.66425246f, 0.659345806f, 0.654410958f, 0.649448037f, 0.64445734f, 0.639438987f, 0.634393275f,
+    0.629320383f, 0.62422055f, 0.619093955f, 0.613940835f, 0.60876143f, 0.603555918f, 0.598324597f, 0.593067646f,
+    0.587785244f, 0.582477689f, 0.577145219f, 0.571787953f, 0.56640625f, 0.561000228f, 0.555570245f, 0.55011642f,
+    0.544639051f, 0.539138317f, 0.533614516f, 0.528067827f, 0.522498548f, 0.516906917f, 0.511293113f, 0.505657375f,
+    0.5f, 0.494321197f, 0.488621235f, 0.482900351f, 0.477158755f, 0.471396744f, 0.465614527f, 0.459812373f,
+    0.453990489f, 0.448149204f, 0.442288697f, 0.436409235f, 0.430511087f, 0.424594522f, 0.418659747f, 0.412707031f,
+    0.406736642f, 0.400748819f, 0.39474386f, 0.388721973f, 0.382683426f, 0.376628488f, 0.370557427f, 0.364470512f,
+    0.35836795f, 0.35225004f, 0.346117049f, 0.339969248f, 0.333806872f, 0.327630192f, 0.321439475f, 0.315234989f,
+    0.309017003f, 0.302785784f, 0.296541572f, 0.290284663f, 0.284015357f, 0.277733833f, 0.271440446f, 0.265135437f,
+    0.258819044f, 0.252491564f, 0.246153295f, 0.239804462f, 0.233445361f, 0.227076262f, 0.220697433f, 0.214309156f,
+    0.207911685f, 0.201505318f, 0.195090324f, 0.18866697f, 0.182235524f, 0.175796285f, 0.169349506f, 0.162895471f,
+    0.156434461f, 0.149966761f, 0.143492624f, 0.137012348f, 0.130526185f, 0.124034449f, 0.117537394f, 0.11103531f,
+    0.104528464f, 0.0980171412f, 0.0915016159f, 0.0849821791f, 0.0784590989f, 0.0719326511f, 0.0654031262f, 0.0588708036f,
+    0.0523359552f, 0.0457988679f, 0.0392598175f, 0.0327190831f, 0.0261769481f, 0.0196336918f, 0.0130895954f, 0.00654493785f,
+    2.83276934e-16f, -0.00654493785f, -0.0130895954f, -0.0196336918f, -0.0261769481f, -0.0327190831f, -0.0392598175f, -0.0457988679f,
+    -0.0523359552f, -0.0588708036f, -0.0654031262f, -0.0719326511f, -0.0784590989f, -0.0849821791f, -0.0915016159f, -0.0980171412f,
+    -0.104528464f, -0.11103531f, -0.117537394f, -0.124034449f, -0.130526185f, -0.137012348f, -0.143492624f, -0.149966761f,
+    -0.156434461f, -0.162895471f, -0.169349506f, -0.175796285f, -0.182235524f, -0.18866697f, -0.195090324f, -0.201505318f,
+    -0.207911685f, -0.214309156f, -0.220697433f, -0.227076262f, -0.233445361f, -0.239804462f, -0.246153295f, -0.252491564f,
+    -0.258819044f, -0.265135437f, -0.271440446f, -0.277733833f, -0.284015357f, -0.290284663f, -0.296541572f, -0.302785784f,
+    -0.309017003f, -0.315234989f, -0.321439475f, -0.327630192f, -0.333806872f, -0.339969248f, -0.346117049f, -0.35225004f,
+    -0.35836795f, -0.364470512f, -0.370557427f, -0.376628488f, -0.382683426f, -0.388721973f, -0.39474386f, -0.400748819f,
+    -0.406736642f, -0.412707031f, -0.418659747f, -0.424594522f, -0.430511087f, -0.436409235f, -0.442288697f, -0.448149204f,
+    -0.453990489f, -0.459812373f, -0.465614527f, -0.471396744f, -0.477158755f, -0.482900351f, -0.488621235f, -0.494321197f,
+    -0.5f, -0.505657375f, -0.511293113f, -0.516906917f, -0.522498548f, -0.528067827f, -0.533614516f, -0.539138317f,
+    -0.544639051f, -0.55011642f, -0.555570245f, -0.561000228f, -0.56640625f, -0.571787953f, -0.577145219f, -0.582477689f,
+    -0.587785244f, -0.593067646f, -0.598324597f, -0.603555918f, -0.60876143f, -0.613940835f, -0.619093955f, -0.62422055f,
+    -0.629320383f, -0.634393275f, -0.639438987f, -0.64445734f, -0.649448037f, -0.654410958f, -0.659345806f, -0.66425246f,
+    -0.669130623f, -0.673980117f, -0.678800762f, -0.683592319f, -0.688354552f, -0.693087339f, -0.697790444f, -0.702463686f,
+    -0.707106769f, -0.711719632f, -0.716301918f, -0.720853567f, -0.725374401f, -0.729864061f, -0.734322488f, -0.738749504f,
+    -0.74314481f, -0.747508347f, -0.751839817f, -0.7561391f, -0.760405958f, -0.764640272f, -0.768841803f, -0.773010433f,
+    -0.777145982f, -0.781248152f, -0.785316944f, -0.789352059f, -0.793353319f, -0.797320664f, -0.801253796f, -0.805152655f,
+    -0.809017003f, -0.812846661f, -0.816641569f, -0.82040143f, -0.824126184f, -0.827815652f, -0.831469595f, -0.835087955f,
+    -0.838670552f, -0.842217207f, -0.845727801f, -0.849202156f, -0.852640152f, -0.85604161f, -0.859406412f, -0.862734377f,
+    -0.866025388f, -0.869279325f, -0.872496009f, -0.875675321f, -0.878817141f, -0.881921291f, -0.884987652f, -0.888016105f,
+    -0.891006529f, -0.893958807f, -0.896872759f, -0.899748266f, -0.902585268f, -0.905383646f, -0.908143163f, -0.910863817f,
+    -0.91354543f, -0.916187942f, -0.918791234f, -0.921355128f, -0.923879504f, -0.926364362f, -0.928809524f, -0.931214929f,
+    -0.933580399f, -0.935905933f, -0.938191354f, -0.940436542f, -0.942641497f, -0.944806039f, -0.94693011f, -0.94901365f,
+    -0.95105654f, -0.95305866f, -0.955019951f, -0.956940353f, -0.958819747f, -0.960658073f, -0.962455213f, -0.964211166f,
+    -0.965925813f, -0.967599094f, -0.96923089f, -0.970821202f, -0.972369909f, -0.973876953f, -0.975342333f, -0.976765871f,
+    -0.978147626f, -0.979487419f, -0.980785251f, -0.982041121f, -0.98325491f, -0.984426558f, -0.985556066f, -0.986643314f,
+    -0.987688363f, -0.988691032f, -0.989651382f, -0.990569353f, -0.991444886f, -0.99227792f, -0.993068457f, -0.993816435f,
+    -0.994521916f, -0.99518472f, -0.995804906f, -0.996382475f, -0.996917307f, -0.997409463f, -0.997858942f, -0.998265624f,
+    -0.99862951f, -0.99895066f, -0.999229014f, -0.999464571f, -0.999657333f, -0.999807239f, -0.999914348f, -0.999978602f,
+    -1.0f, -0.999978602f, -0.999914348f, -0.999807239f, -0.999657333f, -0.999464571f, -0.999229014f, -0.99895066f,
+    -0.99862951f, -0.998265624f, -0.997858942f, -0.997409463f, -0.996917307f, -0.996382475f, -0.995804906f, -0.99518472f,
+    -0.994521916f, -0.993816435f, -0.993068457f, -0.99227792f, -0.991444886f, -0.990569353f, -0.989651382f, -0.988691032f,
+    -0.987688363f, -0.986643314f, -0.985556066f, -0.984426558f, -0.98325491f, -0.982041121f, -0.980785251f, -0.979487419f,
+    -0.978147626f, -0.976765871f, -0.975342333f, -0.973876953f, -0.972369909f, -0.970821202f, -0.96923089f, -0.967599094f,
+    -0.965925813f, -0.964211166f, -0.962455213f, -0.960658073f, -0.958819747f, -0.956940353f, -0.955019951f, -0.95305866f,
+    -0.95105654f, -0.94901365f, -0.94693011f, -0.944806039f, -0.942641497f, -0.940436542f, -0.938191354f, -0.935905933f,
+    -0.933580399f, -0.931214929f, -0.928809524f, -0.926364362f, -0.923879504f, -0.921355128f, -0.918791234f, -0.916187942f,
+    -0.91354543f, -0.910863817f, -0.908143163f, -0.905383646f, -0.902585268f, -0.899748266f, -0.896872759f, -0.893958807f,
+    -0.891006529f, -0.888016105f, -0.884987652f, -0.881921291f, -0.878817141f, -0.875675321f, -0.872496009f, -0.869279325f,
+    -0.866025388f, -0.862734377f, -0.859406412f, -0.85604161f, -0.852640152f, -0.849202156f, -0.845727801f, -0.842217207f,
+    -0.838670552f, -0.835087955f, -0.831469595f, -0.827815652f, -0.824126184f, -0.82040143f, -0.816641569f, -0.812846661f,
+    -0.809017003f, -0.805152655f, -0.801253796f, -0.797320664f, -0.793353319f, -0.789352059f, -0.785316944f, -0.781248152f,
+    -0.777145982f, -0.773010433f, -0.768841803f, -0.764640272f, -0.760405958f, -0.7561391f, -0.751839817f, -0.747508347f,
+    -0.74314481f, -0.738749504f, -0.734322488f, -0.729864061f, -0.725374401f, -0.720853567f, -0.716301918f, -0.711719632f,
+    -0.707106769f, -0.702463686f, -0.697790444f, -0.693087339f, -0.688354552f, -0.683592319f, -0.678800762f, -0.673980117f,
+    -0.669130623f, -0.66425246f, -0.659345806f, -0.654410958f, -0.649448037f, -0.64445734f, -0.639438987f, -0.634393275f,
+    -0.629320383f, -0.62422055f, -0.619093955f, -0.613940835f, -0.60876143f, -0.603555918f, -0.598324597f, -0.593067646f,
+    -0.587785244f, -0.582477689f, -0.577145219f, -0.571787953f, -0.56640625f, -0.561000228f, -0.555570245f, -0.55011642f,
+    -0.544639051f, -0.539138317f, -0.533614516f, -0.528067827f, -0.522498548f, -0.516906917f, -0.511293113f, -0.505657375f,
+    -0.5f, -0.494321197f, -0.488621235f, -0.482900351f, -0.477158755f, -0.471396744f, -0.465614527f, -0.459812373f,
+    -0.453990489f, -0.448149204f, -0.442288697f, -0.436409235f, -0.430511087f, -0.424594522f, -0.418659747f, -0.412707031f,
+    -0.406736642f, -0.400748819f, -0.39474386f, -0.388721973f, -0.382683426f, -0.376628488f, -0.370557427f, -0.364470512f,
+    -0.35836795f, -0.35225004f, -0.346117049f, -0.339969248f, -0.333806872f, -0.327630192f, -0.321439475f, -0.315234989f,
+    -0.309017003f, -0.302785784f, -0.296541572f, -0.290284663f, -0.284015357f, -0.277733833f, -0.271440446f, -0.265135437f,
+    -0.258819044f, -0.252491564f, -0.246153295f, -0.239804462f, -0.233445361f, -0.227076262f, -0.220697433f, -0.214309156f,
+    -0.207911685f, -0.201505318f, -0.195090324f, -0.18866697f, -0.182235524f, -0.175796285f, -0.169349506f, -0.162895471f,
+    -0.156434461f, -0.149966761f, -0.143492624f, -0.137012348f, -0.130526185f, -0.124034449f, -0.117537394f, -0.11103531f,
+    -0.104528464f, -0.0980171412f, -0.0915016159f, -0.0849821791f, -0.0784590989f, -0.0719326511f, -0.0654031262f, -0.0588708036f,
+    -0.0523359552f, -0.0457988679f, -0.0392598175f, -0.0327190831f, -0.0261769481f, -0.0196336918f, -0.0130895954f, -0.00654493785f,
+    -1.83697015e-16f, 0.00654493785f, 0.0130895954f, 0.0196336918f, 0.0261769481f, 0.0327190831f, 0.0392598175f, 0.0457988679f,
+    0.0523359552f, 0.0588708036f, 0.0654031262f, 0.0719326511f, 0.0784590989f, 0.0849821791f, 0.0915016159f, 0.0980171412f,
+    0.104528464f, 0.11103531f, 0.117537394f, 0.124034449f, 0.130526185f, 0.137012348f, 0.143492624f, 0.149966761f,
+    0.156434461f, 0.162895471f, 0.169349506f, 0.175796285f, 0.182235524f, 0.18866697f, 0.195090324f, 0.201505318f,
+    0.207911685f, 0.214309156f, 0.220697433f, 0.227076262f, 0.233445361f, 0.239804462f, 0.246153295f, 0.252491564f,
+    0.258819044f, 0.265135437f, 0.271440446f, 0.277733833f, 0.284015357f, 0.290284663f, 0.296541572f, 0.302785784f,
+    0.309017003f, 0.315234989f, 0.321439475f, 0.327630192f, 0.333806872f, 0.339969248f, 0.346117049f, 0.35225004f,
+    0.35836795f, 0.364470512f, 0.370557427f, 0.376628488f, 0.382683426f, 0.388721973f, 0.39474386f, 0.400748819f,
+    0.406736642f, 0.412707031f, 0.418659747f, 0.424594522f, 0.430511087f, 0.436409235f, 0.442288697f, 0.448149204f,
+    0.453990489f, 0.459812373f, 0.465614527f, 0.471396744f, 0.477158755f, 0.482900351f, 0.488621235f, 0.494321197f,
+    0.5f, 0.505657375f, 0.511293113f, 0.516906917f, 0.522498548f, 0.528067827f, 0.533614516f, 0.539138317f,
+    0.544639051f, 0.55011642f, 0.555570245f, 0.561000228f, 0.56640625f, 0.571787953f, 0.577145219f, 0.582477689f,
+    0.587785244f, 0.593067646f, 0.598324597f, 0.603555918f, 0.60876143f, 0.613940835f, 0.619093955f, 0.62422055f,
+    0.629320383f, 0.634393275f, 0.639438987f, 0.64445734f, 0.649448037f, 0.654410958f, 0.659345806f, 0.66425246f,
+    0.669130623f, 0.673980117f, 0.678800762f, 0.683592319f, 0.688354552f, 0.693087339f, 0.697790444f, 0.702463686f,
+    0.707106769f, 0.711719632f, 0.716301918f, 0.720853567f, 0.725374401f, 0.729864061f, 0.734322488f, 0.738749504f,
+    0.74314481f, 0.747508347f, 0.751839817f, 0.7561391f, 0.760405958f, 0.764640272f, 0.768841803f, 0.773010433f,
+    0.777145982f, 0.781248152f, 0.785316944f, 0.789352059f, 0.793353319f, 0.797320664f, 0.801253796f, 0.805152655f,
+    0.809017003f, 0.812846661f, 0.816641569f, 0.82040143f, 0.824126184f, 0.827815652f, 0.831469595f, 0.835087955f,
+    0.838670552f, 0.842217207f, 0.845727801f, 0.849202156f, 0.852640152f, 0.85604161f, 0.859406412f, 0.862734377f,
+    0.866025388f, 0.869279325f, 0.872496009f, 0.875675321f, 0.878817141f, 0.881921291f, 0.884987652f, 0.888016105f,
+    0.891006529f, 0.893958807f, 0.896872759f, 0.899748266f, 0.902585268f, 0.905383646f, 0.908143163f, 0.910863817f,
+    0.91354543f, 0.916187942f, 0.918791234f, 0.921355128f, 0.923879504f, 0.926364362f, 0.928809524f, 0.931214929f,
+    0.933580399f, 0.935905933f, 0.938191354f, 0.940436542f, 0.942641497f, 0.944806039f, 0.94693011f, 0.94901365f,
+    0.95105654f, 0.95305866f, 0.955019951f, 0.956940353f, 0.958819747f, 0.960658073f, 0.962455213f, 0.964211166f,
+    0.965925813f, 0.967599094f, 0.96923089f, 0.970821202f, 0.972369909f, 0.973876953f, 0.975342333f, 0.976765871f,
+    0.978147626f, 0.979487419f, 0.980785251f, 0.982041121f, 0.98325491f, 0.984426558f, 0.985556066f, 0.986643314f,
+    0.987688363f, 0.988691032f, 0.989651382f, 0.990569353f, 0.991444886f, 0.99227792f, 0.993068457f, 0.993816435f,
+    0.994521916f, 0.99518472f, 0.995804906f, 0.996382475f, 0.996917307f, 0.997409463f, 0.997858942f, 0.998265624f,
+    0.99862951f, 0.99895066f, 0.999229014f, 0.999464571f, 0.999657333f, 0.999807239f, 0.999914348f, 0.999978602f};
+
+RAM_ALIGN const float fl_twiddle_im[FL_TW_LEN] = {
+    -0.0f, -0.00654493785f, -0.0130895954f, -0.0196336918f, -0.0261769481f, -0.0327190831f, -0.0392598175f, -0.0457988679f,
+    -0.0523359552f, -0.0588708036f, -0.0654031262f, -0.0719326511f, -0.0784590989f, -0.0849821791f, -0.0915016159f, -0.0980171412f,
+    -0.104528464f, -0.11103531f, -0.117537394f, -0.124034449f, -0.130526185f, -0.137012348f, -0.143492624f, -0.149966761f,
+    -0.156434461f, -0.162895471f, -0.169349506f, -0.175796285f, -0.182235524f, -0.18866697f, -0.195090324f, -0.201505318f,
+    -0.207911685f, -0.214309156f, -0.220697433f, -0.227076262f, -0.233445361f, -0.239804462f, -0.246153295f, -0.252491564f,
+    -0.258819044f, -0.265135437f, -0.271440446f, -0.277733833f, -0.284015357f, -0.290284663f, -0.296541572f, -0.302785784f,
+    -0.309017003f, -0.315234989f, -0.321439475f, -0.327630192f, -0.333806872f, -0.339969248f, -0.346117049f, -0.35225004f,
+    -0.35836795f, -0.364470512f, -0.370557427f, -0.376628488f, -0.382683426f, -0.388721973f, -0.39474386f, -0.400748819f,
+    -0.406736642f, -0.412707031f, -0.418659747f, -0.424594522f, -0.430511087f, -0.436409235f, -0.442288697f, -0.448149204f,
+    -0.453990489f, -0.459812373f, -0.465614527f, -0.471396744f, -0.477158755f, -0.482900351f, -0.488621235f, -0.494321197f,
+    -0.5f, -0.505657375f, -0.511293113f, -0.516906917f, -0.522498548f, -0.528067827f, -0.533614516f, -0.539138317f,
+    -0.544639051f, -0.55011642f, -0.555570245f, -0.561000228f, -0.56640625f, -0.571787953f, -0.577145219f, -0.582477689f,
+    -0.587785244f, -0.593067646f, -0.598324597f, -0.603555918f, -0.60876143f, -0.613940835f, -0.619093955f, -0.62422055f,
+    -0.629320383f, -0.634393275f, -0.639438987f, -0.64445734f, -0.649448037f, -0.654410958f, -0.659345806f, -0.66425246f,
+    -0.669130623f, -0.673980117f, -0.678800762f, -0.683592319f, -0.688354552f, -0.693087339f, -0.697790444f, -0.702463686f,
+    -0.707106769f, -0.711719632f, -0.716301918f, -0.720853567f, -0.725374401f, -0.729864061f, -0.734322488f, -0.738749504f,
+    -0.74314481f, -0.747508347f, -0.751839817f, -0.7561391f, -0.760405958f, -0.764640272f, -0.768841803f, -0.773010433f,
+    -0.777145982f, -0.781248152f, -0.785316944f, -0.789352059f, -0.793353319f, -0.797320664f, -0.801253796f, -0.805152655f,
+    -0.809017003f, -0.812846661f, -0.816641569f, -0.82040143f, -0.824126184f, -0.827815652f, -0.831469595f, -0.835087955f,
+    -0.838670552f, -0.842217207f, -0.845727801f, -0.849202156f, -0.852640152f, -0.85604161f, -0.859406412f, -0.862734377f,
+    -0.866025388f, -0.869279325f, -0.872496009f, -0.875675321f, -0.878817141f, -0.881921291f, -0.884987652f, -0.888016105f,
+    -0.891006529f, -0.893958807f, -0.896872759f, -0.899748266f, -0.902585268f, -0.905383646f, -0.908143163f, -0.910863817f,
+    -0.91354543f, -0.916187942f, -0.918791234f, -0.921355128f, -0.923879504f, -0.926364362f, -0.928809524f, -0.931214929f,
+    -0.933580399f, -0.935905933f, -0.938191354f, -0.940436542f, -0.942641497f, -0.944806039f, -0.94693011f, -0.94901365f,
+    -0.95105654f, -0.95305866f, -0.955019951f, -0.956940353f, -0.958819747f, -0.960658073f, -0.962455213f, -0.964211166f,
+    -0.965925813f, -0.967599094f, -0.96923089f, -0.970821202f, -0.972369909f, -0.973876953f, -0.975342333f, -0.976765871f,
+    -0.978147626f, -0.979487419f, -0.980785251f, -0.982041121f, -0.98325491f, -0.984426558f, -0.985556066f, -0.986643314f,
+    -0.987688363f, -0.988691032f, -0.989651382f, -0.990569353f, -0.991444886f, -0.99227792f, -0.993068457f, -0.993816435f,
+    -0.994521916f, -0.99518472f, -0.995804906f, -0.996382475f, -0.996917307f, -0.997409463f, -0.997858942f, -0.998265624f,
+    -0.99862951f, -0.99895066f, -0.999229014f, -0.999464571f, -0.999657333f, -0.999807239f, -0.999914348f, -0.999978602f,
+    -1.0f, -0.999978602f, -0.999914348f, -0.999807239f, -0.999657333f, -0.999464571f, -0.999229014f, -0.99895066f,
+    -0.99862951f, -0.998265624f, -0.997858942f, -0.997409463f, -0.996917307f, -0.996382475f, -0.995804906f, -0.99518472f,
+    -0.994521916f, -0.993816435f, -0.993068457f, -0.99227792f, -0.991444886f, -0.990569353f, -0.989651382f, -0.988691032f,
+    -0.987688363f, -0.986643314f, -0.985556066f, -0.984426558f, -0.98325491f, -0.982041121f, -0.980785251f, -0.979487419f,
+    -0.978147626f, -0.976765871f, -0.975342333f, -0.973876953f, -0.972369909f, -0.970821202f, -0.96923089f, -0.967599094f,
+    -0.965925813f, -0.964211166f, -0.962455213f, -0.960658073f, -0.958819747f, -0.956940353f, -0.955019951f, -0.95305866f,
+    -0.95105654f, -0.94901365f, -0.94693011f, -0.944806039f, -0.942641497f, -0.940436542f, -0.938191354f, -0.935905933f,
+    -0.933580399f, -0.931214929f, -0.928809524f, -0.926364362f, -0.923879504f, -0.921355128f, -0.918791234f, -0.916187942f,
+    -0.91354543f, -0.910863817f, -0.908143163f, -0.905383646f, -0.902585268f, -0.899748266f, -0.896872759f, -0.893958807f,
+    -0.891006529f, -0.888016105f, -0.884987652f, -0.881921291f, -0.878817141f, -0.875675321f, -0.872496009f, -0.869279325f,
+    -0.866025388f, -0.862734377f, -0.859406412f, -0.85604161f, -0.852640152f, -0.849202156f, -0.845727801f, -0.842217207f,
+    -0.838670552f, -0.835087955f, -0.831469595f, -0.827815652f, -0.824126184f, -0.82040143f, -0.816641569f, -0.812846661f,
+    -0.809017003f, -0.805152655f, -0.801253796f, -0.797320664f, -0.793353319f, -0.789352059f, -0.785316944f, -0.781248152f,
+    -0.777145982f, -0.773010433f, -0.768841803f, -0.764640272f, -0.760405958f, -0.7561391f, -0.751839817f, -0.747508347f,
+    -0.74314481f, -0.738749504f, -0.734322488f, -0.729864061f, -0.725374401f, -0.720853567f, -0.716301918f, -0.711719632f,
+    -0.707106769f, -0.702463686f, -0.697790444f, -0.693087339f, -0.688354552f, -0.683592319f, -0.678800762f, -0.673980117f,
+    -0.669130623f, -0.66425246f, -0.659345806f, -0.654410958f, -0.649448037f, -0.64445734f, -0.639438987f, -0.634393275f,
+    -0.629320383f, -0.62422055f, -0.619093955f, -0.613940835f, -0.60876143f, -0.603555918f, -0.598324597f, -0.593067646f,
+    -0.587785244f, -0.582477689f, -0.577145219f, -0.571787953f, -0.56640625f, -0.561000228f, -0.555570245f, -0.55011642f,
+    -0.544639051f, -0.539138317f, -0.533614516f, -0.528067827f, -0.522498548f, -0.516906917f, -0.511293113f, -0.505657375f,
+    -0.5f, -0.494321197f, -0.488621235f, -0.482900351f, -0.477158755f, -0.471396744f, -0.465614527f, -0.459812373f,
+    -0.453990489f, -0.448149204f, -0.442288697f, -0.436409235f, -0.430511087f, -0.424594522f, -0.418659747f, -0.412707031f,
+    -0.406736642f, -0.400748819f, -0.39474386f, -0.388721973f, -0.382683426f, -0.376628488f, -0.370557427f, -0.364470512f,
+    -0.35836795f, -0.35225004f, -0.346117049f, -0.339969248f, -0.333806872f, -0.327630192f, -0.321439475f, -0.315234989f,
+    -0.309017003f, -0.302785784f, -0.296541572f, -0.290284663f, -0.284015357f, -0.277733833f, -0.271440446f, -0.265135437f,
+    -0.258819044f, -0.252491564f, -0.246153295f, -0.239804462f, -0.233445361f, -0.227076262f, -0.220697433f, -0.214309156f,
+    -0.207911685f, -0.201505318f, -0.195090324f, -0.18866697f, -0.182235524f, -0.175796285f, -0.169349506f, -0.162895471f,
+    -0.156434461f, -0.149966761f, -0.143492624f, -0.137012348f, -0.130526185f, -0.124034449f, -0.117537394f, -0.11103531f,
+    -0.104528464f, -0.0980171412f, -0.0915016159f, -0.0849821791f, -0.0784590989f, -0.0719326511f, -0.0654031262f, -0.0588708036f,
+    -0.0523359552f, -0.0457988679f, -0.0392598175f, -0.0327190831f, -0.0261769481f, -0.0196336918f, -0.0130895954f, -0.00654493785f,
+    -5.66553869e-16f, 0.00654493785f, 0.0130895954f, 0.0196336918f, 0.0261769481f, 0.0327190831f, 0.0392598175f, 0.0457988679f,
+    0.0523359552f, 0.0588708036f, 0.0654031262f, 0.0719326511f, 0.0784590989f, 0.0849821791f, 0.0915016159f, 0.0980171412f,
+    0.104528464f, 0.11103531f, 0.117537394f, 0.124034449f, 0.130526185f, 0.137012348f, 0.143492624f, 0.149966761f,
+    0.156434461f, 0.162895471f, 0.169349506f, 0.175796285f, 0.182235524f, 0.18866697f, 0.195090324f, 0.201505318f,
+    0.207911685f, 0.214309156f, 0.220697433f, 0.227076262f, 0.233445361f, 0.239804462f, 0.246153295f, 0.252491564f,
+    0.258819044f, 0.265135437f, 0.271440446f, 0.277733833f, 0.284015357f, 0.290284663f, 0.296541572f, 0.302785784f,
+    0.309017003f, 0.315234989f, 0.321439475f, 0.327630192f, 0.333806872f, 0.339969248f, 0.346117049f, 0.35225004f,
+    0.35836795f, 0.364470512f, 0.370557427f, 0.376628488f, 0.382683426f, 0.388721973f, 0.39474386f, 0.400748819f,
+    0.406736642f, 0.412707031f, 0.418659747f, 0.424594522f, 0.430511087f, 0.436409235f, 0.442288697f, 0.448149204f,
+    0.453990489f, 0.459812373f, 0.465614527f, 0.471396744f, 0.477158755f, 0.482900351f, 0.488621235f, 0.494321197f,
+    0.5f, 0.505657375f, 0.511293113f, 0.516906917f, 0.522498548f, 0.528067827f, 0.533614516f, 0.539138317f,
+    0.544639051f, 0.55011642f, 0.555570245f, 0.561000228f, 0.56640625f, 0.571787953f, 0.577145219f, 0.582477689f,
+    0.587785244f, 0.593067646f, 0.598324597f, 0.603555918f, 0.60876143f, 0.613940835f, 0.619093955f, 0.62422055f,
+    0.629320383f, 0.634393275f, 0.639438987f, 0.64445734f, 0.649448037f, 0.654410958f, 0.659345806f, 0.66425246f,
+    0.669130623f, 0.673980117f, 0.678800762f, 0.683592319f, 0.688354552f, 0.693087339f, 0.697790444f, 0.702463686f,
+    0.707106769f, 0.711719632f, 0.716301918f, 0.720853567f, 0.725374401f, 0.729864061f, 0.734322488f, 0.738749504f,
+    0.74314481f, 0.747508347f, 0.751839817f, 0.7561391f, 0.760405958f, 0.764640272f, 0.768841803f, 0.773010433f,
+    0.777145982f, 0.781248152f, 0.785316944f, 0.789352059f, 0.793353319f, 0.797320664f, 0.801253796f, 0.805152655f,
+    0.809017003f, 0.812846661f, 0.816641569f, 0.82040143f, 0.824126184f, 0.827815652f, 0.831469595f, 0.835087955f,
+    0.838670552f, 0.842217207f, 0.845727801f, 0.849202156f, 0.852640152f, 0.85604161f, 0.859406412f, 0.862734377f,
+    0.866025388f, 0.869279325f, 0.872496009f, 0.875675321f, 0.878817141f, 0.881921291f, 0.884987652f, 0.888016105f,
+    0.891006529f, 0.893958807f, 0.896872759f, 0.899748266f, 0.902585268f, 0.905383646f, 0.908143163f, 0.910863817f,
+    0.91354543f, 0.916187942f, 0.918791234f, 0.921355128f, 0.923879504f, 0.926364362f, 0.928809524f, 0.931214929f,
+    0.933580399f, 0.935905933f, 0.938191354f, 0.940436542f, 0.942641497f, 0.944806039f, 0.94693011f, 0.94901365f,
+    0.95105654f, 0.95305866f, 0.955019951f, 0.956940353f, 0.958819747f, 0.960658073f, 0.962455213f, 0.964211166f,
+    0.965925813f, 0.967599094f, 0.96923089f, 0.970821202f, 0.972369909f, 0.973876953f, 0.975342333f, 0.976765871f,
+    0.978147626f, 0.979487419f, 0.980785251f, 0.982041121f, 0.98325491f, 0.984426558f, 0.985556066f, 0.986643314f,
+    0.987688363f, 0.988691032f, 0.989651382f, 0.990569353f, 0.991444886f, 0.99227792f, 0.993068457f, 0.993816435f,
+    0.994521916f, 0.99518472f, 0.995804906f, 0.996382475f, 0.996917307f, 0.997409463f, 0.997858942f, 0.998265624f,
+    0.99862951f, 0.99895066f, 0.999229014f, 0.999464571f, 0.999657333f, 0.999807239f, 0.999914348f, 0.999978602f,
+    1.0f, 0.999978602f, 0.999914348f, 0.999807239f, 0.999657333f, 0.999464571f, 0.999229014f, 0.99895066f,
+    0.99862951f, 0.998265624f, 0.997858942f, 0.997409463f, 0.996917307f, 0.996382475f, 0.995804906f, 0.99518472f,
+    0.994521916f, 0.993816435f, 0.993068457f, 0.99227792f, 0.991444886f, 0.990569353f, 0.989651382f, 0.988691032f,
+    0.987688363f, 0.986643314f, 0.985556066f, 0.984426558f, 0.98325491f, 0.982041121f, 0.980785251f, 0.979487419f,
+    0.978147626f, 0.976765871f, 0.975342333f, 0.973876953f, 0.972369909f, 0.970821202f, 0.96923089f, 0.967599094f,
+    0.965925813f, 0.964211166f, 0.962455213f, 0.960658073f, 0.958819747f, 0.956940353f, 0.955019951f, 0.95305866f,
+    0.95105654f, 0.94901365f, 0.94693011f, 0.944806039f, 0.942641497f, 0.940436542f, 0.938191354f, 0.935905933f,
+    0.933580399f, 0.931214929f, 0.928809524f, 0.926364362f, 0.923879504f, 0.921355128f, 0.918791234f, 0.916187942f,
+    0.91354543f, 0.910863817f, 0.908143163f, 0.905383646f, 0.902585268f, 0.899748266f, 0.896872759f, 0.893958807f,
+    0.891006529f, 0.888016105f, 0.884987652f, 0.881921291f, 0.878817141f, 0.875675321f, 0.872496009f, 0.869279325f,
+    0.866025388f, 0.862734377f, 0.859406412f, 0.85604161f, 0.852640152f, 0.849202156f, 0.845727801f, 0.842217207f,
+    0.838670552f, 0.835087955f, 0.831469595f, 0.827815652f, 0.824126184f, 0.82040143f, 0.816641569f, 0.812846661f,
+    0.809017003f, 0.805152655f, 0.801253796f, 0.797320664f, 0.793353319f, 0.789352059f, 0.785316944f, 0.781248152f,
+    0.777145982f, 0.773010433f, 0.768841803f, 0.764640272f, 0.760405958f, 0.7561391f, 0.751839817f, 0.747508347f,
+    0.74314481f, 0.738749504f, 0.734322488f, 0.729864061f, 0.725374401f, 0.720853567f, 0.716301918f, 0.711719632f,
+    0.707106769f, 0.702463686f, 0.697790444f, 0.693087339f, 0.688354552f, 0.683592319f, 0.678800762f, 0.673980117f,
+    0.669130623f, 0.66425246f, 0.659345806f, 0.654410958f, 0.649448037f, 0.64445734f, 0.639438987f, 0.634393275f,
+    0.629320383f, 0.62422055f, 0.619093955f, 0.613940835f, 0.60876143f, 0.603555918f, 0.598324597f, 0.593067646f,
+    0.587785244f, 0.582477689f, 0.577145219f, 0.571787953f, 0.56640625f, 0.561000228f, 0.555570245f, 0.55011642f,
+    0.544639051f, 0.539138317f, 0.533614516f, 0.528067827f, 0.522498548f, 0.516906917f, 0.511293113f, 0.505657375f,
+    0.5f, 0.494321197f, 0.488621235f, 0.482900351f, 0.477158755f, 0.471396744f, 0.465614527f, 0.459812373f,
+    0.453990489f, 0.448149204f, 0.442288697f, 0.436409235f, 0.430511087f, 0.424594522f, 0.418659747f, 0.412707031f,
+    0.406736642f, 0.400748819f, 0.39474386f, 0.388721973f, 0.382683426f, 0.376628488f, 0.370557427f, 0.364470512f,
+    0.35836795f, 0.35225004f, 0.346117049f, 0.339969248f, 0.333806872f, 0.327630192f, 0.321439475f, 0.315234989f,
+    0.309017003f, 0.302785784f, 0.296541572f, 0.290284663f, 0.284015357f, 0.277733833f, 0.271440446f, 0.265135437f,
+    0.258819044f, 0.252491564f, 0.246153295f, 0.239804462f, 0.233445361f, 0.227076262f, 0.220697433f, 0.214309156f,
+    0.207911685f, 0.201505318f, 0.195090324f, 0.18866697f, 0.182235524f, 0.175796285f, 0.169349506f, 0.162895471f,
+    0.156434461f, 0.149966761f, 0.143492624f, 0.137012348f, 0.130526185f, 0.124034449f, 0.117537394f, 0.11103531f,
+    0.104528464f, 0.0980171412f, 0.0915016159f, 0.0849821791f, 0.0784590989f, 0.0719326511f, 0.0654031262f, 0.0588708036f,
+    0.0523359552f, 0.0457988679f, 0.0392598175f, 0.0327190831f, 0.0261769481f, 0.0196336918f, 0.0130895954f, 0.00654493785f};
+#endif
@@ -182,12 +182,8 @@ extern RAM_ALIGN const UWord32 sns_MPVQ_Sz[4][2];
 extern RAM_ALIGN const Word16 st1SCF0_7_base5_32x8_Q14[256];
 extern RAM_ALIGN const Word16 st1SCF8_15_base5_32x8_Q14[256];
 
-/* PVQ deindexing tables */
-extern RAM_ALIGN const UWord32 h_memN16K12[12 + 2];
-extern RAM_ALIGN const UWord32 h_memN10K22[22 + 2];
-extern RAM_ALIGN const UWord32 h_memN6K2[2 + 2];
-extern RAM_ALIGN const Word16 tabledKMAX[16 + 1];
-extern RAM_ALIGN const UWord32 *const MPVQ_offs_ptr[16 + 1];
+/* PVQ indexing and deindexing table */
+extern RAM_ALIGN const UWord32 mpvq_offsets[16 + 1][10 + 2];
 
 extern RAM_ALIGN const Word16 isqrt_Q16tab[1 + SQRT_EN_MAX_FX];
 
@@ -243,5 +239,10 @@ extern   RAM_ALIGN const  Word16 *const w_old[];
 extern    RAM_ALIGN const  Word16 COPY_LEN[];
 extern    RAM_ALIGN const Word16 OLA_LEN[];
 
+#ifdef LC3_FLOAT_ANALYSIS
+extern RAM_ALIGN const float fl_twiddle_re[FL_TW_LEN];
+extern RAM_ALIGN const float fl_twiddle_im[FL_TW_LEN];
+#endif
+
 
 #endif
@@ -11,8 +11,6 @@
 #include "functions.h"
 
 
-static Word16 read_indice(UWord8 *ptr, Word16 *bp, Word16 *mask, Word16 numbits);
-
 static Word16 ac_dec_split_st2VQ_CW(                     /* local BER flag */
                                     const Word32 L_cwRx, /* max 25 bits */
                                     const Word32 L_szA, const Word32 L_szB, Word32 *L_cwA, Word32 *L_cwB,
@@ -29,22 +27,23 @@ void processDecoderEntropy_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side,
         Word32  tmp32, tmp32lim;
         Word16  gain_e, gain, submodeMSB, BER_detect;
         Counter n;
-        UWord8 *ptr;
+        Bitstream_Backward bs;
     );
 
-    ptr        = bytes;
     *bp_side   = shr_pos(sub(nbbits, 1), 3);
     *mask_side = shl(1, sub(8, sub(nbbits, shl_pos(*bp_side, 3))));
+    bs_read_init(&bs, bytes, *bp_side, *mask_side);
 
     /* Cutoff-detection */
     IF (BW_cutoff_bits > 0)
     {
-        *BW_cutoff_idx = read_indice(ptr, bp_side, mask_side, BW_cutoff_bits);
+        *BW_cutoff_idx = bs_read(&bs, BW_cutoff_bits);
         /* check for bitflips */
         IF (sub(fs_idx, *BW_cutoff_idx) < 0)
         {
             *BW_cutoff_idx = fs_idx;
             *bfi           = 1;  
+            bs_read_finish(&bs, bp_side, mask_side);
             Dyn_Mem_Deluxe_Out();
             return;
         }
@@ -66,21 +65,22 @@ void processDecoderEntropy_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side,
 
     /* Decode number of ntuples */
     L       = sub(14, norm_s(negate(L_spec)));
-    n       = read_indice(ptr, bp_side, mask_side, L);
+    n       = bs_read(&bs, L);
     n       = add(n, 1);
     *lastnz = shl_pos(n, 1);
     IF (sub(*lastnz, L_spec) > 0)
     {
         *bfi = 1;  
+        bs_read_finish(&bs, bp_side, mask_side);
         Dyn_Mem_Deluxe_Out();
         return;
     }
 
     /* Mode bit */
-    *lsbMode = read_bit(ptr, bp_side, mask_side);
+    *lsbMode = bs_read(&bs, 1);
 
     /* Decode global-gain */
-    *gg_idx = read_indice(ptr, bp_side, mask_side, 8);  
+    *gg_idx = bs_read(&bs, 8);  
     tmp32  = L_shl_pos(L_mult0(*gg_idx, 0x797D), 7);  /* 6Q25; 0x797D -> log2(10)/28 (Q18) */
     gain_e = add(extract_l(L_shr_pos(tmp32, 25)), 1); /* get exponent */
     gain   = round_fx(BASOP_Util_InvLog2(L_or(tmp32, 0xFE000000))); 
@@ -92,23 +92,22 @@ void processDecoderEntropy_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side,
     tns_order[1] = 0;  /* fix problem with uninitialized memory */
     FOR (n = 0; n < *tns_numfilters; n++)
     {
-        tns_order[n] = read_bit(ptr, bp_side, mask_side);  
+        tns_order[n] = bs_read(&bs, 1);  
     }
 
     /* LTPF on/off */
-    ltpf_idx[0] = read_indice(ptr, bp_side, mask_side, 1);  
+    ltpf_idx[0] = bs_read(&bs, 1);  
 
     /* Decode SNS VQ parameters - 1st stage (10 bits) */
-    L_scf_idx[0] = L_deposit_l(read_indice(ptr, bp_side, mask_side, 5)); /* stage1 LF  5  bits */
-    L_scf_idx[1] = L_deposit_l(read_indice(ptr, bp_side, mask_side, 5)); /* stage1 HF  5 bits  */
+    L_scf_idx[0] = L_deposit_l(bs_read(&bs, 5)); /* stage1 LF  5  bits */
+    L_scf_idx[1] = L_deposit_l(bs_read(&bs, 5)); /* stage1 HF  5 bits  */
 
     /* Decode SNS VQ parameters - 2nd stage side-info (3-4 bits) */
-    submodeMSB   = read_bit(ptr, bp_side, mask_side); /* submodeMSB 1 bit */
+    submodeMSB   = bs_read(&bs, 1); /* submodeMSB 1 bit */
     L_scf_idx[2] = L_deposit_l(shl_pos(submodeMSB, 1));
     ASSERT(sns_gainMSBbits[L_scf_idx[2]] > 0);
-    L_scf_idx[3] = L_deposit_l(
-        read_indice(ptr, bp_side, mask_side, sns_gainMSBbits[L_scf_idx[2]])); /* gains or gain MSBs  1-2 bits  */
-    L_scf_idx[4] = read_bit(ptr, bp_side, mask_side);                         /*  shape LS 1 bit */
+    L_scf_idx[3] = L_deposit_l(bs_read(&bs, sns_gainMSBbits[L_scf_idx[2]])); /* gains or gain MSBs  1-2 bits  */
+    L_scf_idx[4] = bs_read(&bs, 1);                                          /*  shape LS 1 bit */
 
     /* Decode SNS VQ parameters - 2nd stage data (24-25 bits) */
     IF (submodeMSB == 0)
@@ -116,8 +115,8 @@ void processDecoderEntropy_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side,
         /* regular mode A,B indexes integer multiplexed, total 24.x bits  MPVQ codeword section A and  codeword for
          * section B */
         /* regular mode  mode shape  index   total  24.9999 bits    MPVQ codeword  */
-        tmp32 = L_deposit_l(read_indice(ptr, bp_side, mask_side, 13));
-        tmp32 = L_or(tmp32, L_shl_pos(read_indice(ptr, bp_side, mask_side, 12), 13));   /*for ber state   */
+        tmp32 = L_deposit_l(bs_read(&bs, 13));
+        tmp32 = L_or(tmp32, L_shl_pos(bs_read(&bs, 12), 13));   /*for ber state   */
         BER_detect =
             ac_dec_split_st2VQ_CW(       /* local BER flag */
                                   tmp32, /* L_cwRx  max 25 bits */
@@ -137,8 +136,8 @@ void processDecoderEntropy_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side,
         ASSERT(submodeMSB == 1);
         /* outlier mode shape  index   total  23.8536 +  19.5637 (19.5637 < (log2(2.^24 -2.^23.8537))    bits    MPVQ
          * codeword  */
-        tmp32        = L_deposit_l(read_indice(ptr, bp_side, mask_side, 12));
-        tmp32        = L_or(tmp32, L_shl_pos(read_indice(ptr, bp_side, mask_side, 12), 12));
+        tmp32        = L_deposit_l(bs_read(&bs, 12));
+        tmp32        = L_or(tmp32, L_shl_pos(bs_read(&bs, 12), 12));
         L_scf_idx[5] = tmp32;   /*shape outl_near or outl_far */
         submodeLSB = 0;  
         BER_detect = 0;  
@@ -170,6 +169,7 @@ void processDecoderEntropy_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side,
     IF (BER_detect > 0)
     {
         *bfi = 1;  
+        bs_read_finish(&bs, bp_side, mask_side);
         Dyn_Mem_Deluxe_Out();
         return;
     }
@@ -177,8 +177,8 @@ void processDecoderEntropy_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side,
     /* LTPF data */
     IF (ltpf_idx[0] != 0)
     {
-        ltpf_idx[1] = read_indice(ptr, bp_side, mask_side, 1);  
-        ltpf_idx[2] = read_indice(ptr, bp_side, mask_side, 9);  
+        ltpf_idx[1] = bs_read(&bs, 1);  
+        ltpf_idx[2] = bs_read(&bs, 9);  
     }
     ELSE
     {
@@ -187,8 +187,9 @@ void processDecoderEntropy_fx(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side,
     }
 
     /* Decode noise-fac */
-    *fac_ns_idx = read_indice(ptr, bp_side, mask_side, 3);  
+    *fac_ns_idx = bs_read(&bs, 3);  
 
+    bs_read_finish(&bs, bp_side, mask_side);
     Dyn_Mem_Deluxe_Out();
 }
 
@@ -203,7 +204,7 @@ int paddingDec_fx(UWord8 *bytes, Word16 nbbits, Word16 L_spec, Word16 BW_cutoff_
     Word16 nbbytes = shr(nbbits,3);
 
     Word16  mask_side;
-    UWord8 *ptr = bytes;
+    Bitstream_Backward bs;
 
     Word16 lastnz;
     Word16 nbits = sub(14, norm_s(negate(L_spec)));
@@ -219,15 +220,15 @@ int paddingDec_fx(UWord8 *bytes, Word16 nbbits, Word16 L_spec, Word16 BW_cutoff_
         return 1;
     }
 
-    ptr = bytes;
+    bs_read_init(&bs, bytes, bp_side, mask_side);
 
     IF (BW_cutoff_bits > 0)
     {
-        read_indice(ptr, &bp_side, &mask_side, BW_cutoff_bits);
+        bs_read(&bs, BW_cutoff_bits);
         
     }
 
-    lastnz = read_indice(ptr, &bp_side, &mask_side, nbits);
+    lastnz = bs_read(&bs, nbits);
     
 
     lastnz_threshold = sub(shl(1, nbits), 2);
@@ -237,17 +238,19 @@ int paddingDec_fx(UWord8 *bytes, Word16 nbbits, Word16 L_spec, Word16 BW_cutoff_
         padding_len_bits = sub(sub(12, nbits), BW_cutoff_bits);
 
         /*Read padding length*/
-        padding_len = read_indice(ptr, &bp_side, &mask_side, padding_len_bits);
+        padding_len = bs_read(&bs, padding_len_bits);
         
 
         /* Read 4 reserved bits */
-        read_indice(ptr, &bp_side, &mask_side, 4);
+        bs_read(&bs, 4);
         
 
         IF (ep_enabled == 0)
         {
             /* Discard padding length bytes */
+            bs_read_finish(&bs, &bp_side, &mask_side);
             bp_side        = sub(bp_side, padding_len);
+            bs_read_init(&bs, bytes, bp_side, mask_side);
             *total_padding = add(add(*total_padding, padding_len), 2); 
         }
         ELSE
@@ -264,11 +267,11 @@ int paddingDec_fx(UWord8 *bytes, Word16 nbbits, Word16 L_spec, Word16 BW_cutoff_
         /* Read bandwidth bits */
         IF (BW_cutoff_bits > 0)
         {
-            read_indice(ptr, &bp_side, &mask_side, BW_cutoff_bits);
+            bs_read(&bs, BW_cutoff_bits);
             
         }
 
-        lastnz = read_indice(ptr, &bp_side, &mask_side, nbits);
+        lastnz = bs_read(&bs, nbits);
         
     }
 
@@ -280,25 +283,6 @@ int paddingDec_fx(UWord8 *bytes, Word16 nbbits, Word16 L_spec, Word16 BW_cutoff_
 }
 #endif
 
-static __forceinline Word16 read_indice(UWord8 *ptr, Word16 *bp, Word16 *mask, Word16 numbits)
-{
-    Dyn_Mem_Deluxe_In(
-        Word16  indice, bit;
-        Counter i;
-    );
-
-    indice = read_bit(ptr, bp, mask);
-
-    FOR (i = 1; i < numbits; i++)
-    {
-        bit    = read_bit(ptr, bp, mask);
-        indice = add(indice, lshl_pos(bit, i));
-    }
-
-    Dyn_Mem_Deluxe_Out();
-    return indice;
-}
-
 static __forceinline Word16 ac_dec_split_st2VQ_CW(                     /* local BER flag */
                                                   const Word32 L_cwRx, /* max 25 bits */
                                                   const Word32 L_szA, const Word32 L_szB, Word32 *L_cwA, Word32 *L_cwB,
@@ -11,84 +11,78 @@
 #include "functions.h"
 
 
-static int Dec_LC3_Channel(LC3_Dec *decoder, int channel, int bits_per_sample, UWord8 *bs_in, void *s_out, Word16 bfi,
-                           Word8 *scratchBuffer)
+/* a zero spectrum on zero overlap memory synthesizes to zeros with exponent 0 */
+static Word16 dec_at_rest(const LC3_Dec *decoder, const DecSetup *h_DecSetup)
+{
+    Counter i;
+
+    FOR (i = 0; i < decoder->stDec_ola_mem_fx_len; i++)
+    {
+        IF (h_DecSetup->stDec_ola_mem_fx[i] != 0)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* state of a channel between bitstream parsing and synthesis of the frame, the buffers live in the
+   scratch memory of the channel */
+typedef struct
+{
+    Word16  bfi;
+    Word16  q_fx_exp, fill_bits, nf_seed, gg_idx, fac_ns_idx, BW_cutoff_idx, BW_cutoff_idx_nf, zero_frame;
+    Word16  spec_inv_idx;
+    Word16  ltpf_idx[3], tns_order[TNS_NUMFILTERS_MAX];
+    Word16 *int_scf_fx_exp, *resBitBuf, *sqQdec, *int_scf_fx, *x_fx, *indexes, *scf_q;
+    Word32 *L_scf_idx, *q_d_fx;
+    Word8 * currentScratch;
+} DecChannelFrame;
+
+/* entropy and arithmetic decoding and partial concealment of one channel. Returns the final bfi of
+   the channel, which is the bfi the next channel starts from. The complexity counters opened here
+   are closed by Dec_LC3_ChannelSynth() */
+static Word16 Dec_LC3_ChannelParse(LC3_Dec *decoder, int channel, UWord8 *bs_in, Word16 bfi, DecChannelFrame *f,
+                                   Word8 *scratchBuffer)
 {
     Word16 scale;
-    Word32 offset;
-    Word16 fill_bits;
-    Word16 nf_seed, gg_idx, fac_ns_idx, q_fx_exp = 0;
     Word16 bp_side, mask_side;
-    Word16 tns_numfilters, lsbMode, lastnz, BW_cutoff_idx, BW_cutoff_idx_nf;
-    Word16 zero_frame;
-#ifdef ENABLE_RFRAME
+    Word16 tns_numfilters, lsbMode, lastnz;
     Word16 rframe = 0;
-#endif
-    Word16 ltpf_idx[3];
-    Word16 spec_inv_idx = 0;
-    Counter i;
-
-    /* Buffers */
-    Word16 *  int_scf_fx_exp, tns_order[TNS_NUMFILTERS_MAX];
-    Word16 *  resBitBuf;
-    Word16 *  sqQdec, *int_scf_fx, *x_fx, *indexes, *scf_q;
-    Word32 *  L_scf_idx;
-    Word32 *  q_d_fx;
-    Word8 *   currentScratch;
     DecSetup *h_DecSetup = decoder->channel_setup[channel];
 
 #ifdef DYNMEM_COUNT
     struct _dynmem
     {
-        Counter i;
         Word16  scale;
-        Word32  offset;
-        Word16  fill_bits;
-        Word16  nf_seed, gg_idx, fac_ns_idx, q_fx_exp;
         Word16  bp_side, mask_side;
-        Word16  tns_numfilters, lsbMode, lastnz, BW_cutoff_idx, BW_cutoff_idx_nf;
-        Word16  zero_frame;
-        Word16  ltpf_idx[3];
-#ifdef ENABLE_RFRAME
-        Word16 rframe;
-#endif
-        Word16 spec_inv_idx;
-
-        /* Buffers */
-        Word16 *int_scf_fx_exp, tns_order[TNS_NUMFILTERS_MAX];
-        Word16 *resBitBuf;
-        Word16 *sqQdec, *int_scf_fx, *x_fx, *indexes, *scf_q;
-        Word32 *L_scf_idx;
-        Word32 *q_d_fx;
-        Word8 * currentScratch;
+        Word16  tns_numfilters, lsbMode, lastnz;
+        Word16  rframe;
     };
-    Dyn_Mem_In("Dec_LC3_Channel", sizeof(struct _dynmem));
-#endif
-
-#ifdef DISABLE_PLC
-    UNUSED(decoder->plcMeth);
+    Dyn_Mem_In("Dec_LC3_ChannelParse", sizeof(struct _dynmem));
 #endif
 
     /* BUFFER INITIALISATION. Some buffers may overlap since they are not used in the whole decoding process */
-    q_d_fx = scratchAlign(scratchBuffer, 0); /* Size = 4 * MAX_LEN bytes */
-    resBitBuf =
-        scratchAlign(q_d_fx, sizeof(*q_d_fx) * decoder->frame_length); /* Size = 2 * NPRM_RESQ = 2 * MAX_LEN bytes */
-    indexes = scratchAlign(
-        resBitBuf, sizeof(*resBitBuf) * decoder->frame_length); /* Size = 2 * TNS_NUMFILTERS_MAX * MAXLAG = 32 bytes */
-    L_scf_idx      = scratchAlign(indexes, sizeof(*indexes) * TNS_NUMFILTERS_MAX *
+    f->q_fx_exp = 0;
+    f->q_d_fx   = scratchAlign(scratchBuffer, 0); /* Size = 4 * MAX_LEN bytes */
+    f->resBitBuf =
+        scratchAlign(f->q_d_fx, sizeof(*f->q_d_fx) * decoder->frame_length); /* Size = 2 * NPRM_RESQ = 2 * MAX_LEN bytes */
+    f->indexes = scratchAlign(
+        f->resBitBuf, sizeof(*f->resBitBuf) * decoder->frame_length); /* Size = 2 * TNS_NUMFILTERS_MAX * MAXLAG = 32 bytes */
+    f->L_scf_idx      = scratchAlign(f->indexes, sizeof(*f->indexes) * TNS_NUMFILTERS_MAX *
                                           MAXLAG); /* Size = 4 * SCF_MAX_PARAM = 28 bytes -> aligned to 32 bytes */
-    sqQdec         = scratchAlign(L_scf_idx, sizeof(*L_scf_idx) * (SCF_MAX_PARAM));   /* Size = 2 * MAX_LEN bytes */
-    scf_q          = scratchAlign(sqQdec, sizeof(*sqQdec) * (decoder->frame_length)); /* Size = 2 * M = 32 bytes */
-    int_scf_fx_exp = scratchAlign(scf_q, sizeof(*scf_q) * M); /* Size = 2 * MAX_BANDS_NUMBER = 128 bytes */
-    int_scf_fx     = scratchAlign(int_scf_fx_exp,
-                              sizeof(*int_scf_fx_exp) * MAX_BANDS_NUMBER); /* Size = 2 * MAX_BANDS_NUMBER = 128 bytes */
-    currentScratch = scratchAlign(int_scf_fx, sizeof(*int_scf_fx) * MAX_BANDS_NUMBER); /* Size = 4 * MAX_LEN */
-    x_fx =
-        scratchAlign(q_d_fx, sizeof(*q_d_fx) * decoder->frame_length); /* Size = 2 * (MAX_LEN + MDCT_MEM_LEN_MAX) = 2
+    f->sqQdec         = scratchAlign(f->L_scf_idx, sizeof(*f->L_scf_idx) * (SCF_MAX_PARAM));   /* Size = 2 * MAX_LEN bytes */
+    f->scf_q          = scratchAlign(f->sqQdec, sizeof(*f->sqQdec) * (decoder->frame_length)); /* Size = 2 * M = 32 bytes */
+    f->int_scf_fx_exp = scratchAlign(f->scf_q, sizeof(*f->scf_q) * M); /* Size = 2 * MAX_BANDS_NUMBER = 128 bytes */
+    f->int_scf_fx     = scratchAlign(f->int_scf_fx_exp,
+                              sizeof(*f->int_scf_fx_exp) * MAX_BANDS_NUMBER); /* Size = 2 * MAX_BANDS_NUMBER = 128 bytes */
+    f->currentScratch = scratchAlign(f->int_scf_fx, sizeof(*f->int_scf_fx) * MAX_BANDS_NUMBER); /* Size = 4 * MAX_LEN */
+    f->x_fx =
+        scratchAlign(f->q_d_fx, sizeof(*f->q_d_fx) * decoder->frame_length); /* Size = 2 * (MAX_LEN + MDCT_MEM_LEN_MAX) = 2
                                                                         * MAX_LEN + 1.25 * MAX_LEN = 3.25 * MAX_LEN */
 
 #ifdef DISABLE_PLC
-    memset(q_d_fx, 0, decoder->frame_length * sizeof(*q_d_fx));
+    memset(f->q_d_fx, 0, decoder->frame_length * sizeof(*f->q_d_fx));
 #endif
 
     BASOP_sub_start("Decoder");
@@ -115,9 +109,9 @@ static int Dec_LC3_Channel(LC3_Dec *decoder, int channel, int bits_per_sample, U
     {
         processDecoderEntropy_fx(bs_in, &bp_side, &mask_side, h_DecSetup->total_bits, decoder->yLen,
                                  decoder->fs_idx, decoder->BW_cutoff_bits, &tns_numfilters, &lsbMode, &lastnz, &bfi,
-                                 tns_order, &fac_ns_idx, &gg_idx, &BW_cutoff_idx, ltpf_idx, L_scf_idx,
+                                 f->tns_order, &f->fac_ns_idx, &f->gg_idx, &f->BW_cutoff_idx, f->ltpf_idx, f->L_scf_idx,
                                  decoder->frame_dms);
-        BW_cutoff_idx_nf = BW_cutoff_idx;  
+        f->BW_cutoff_idx_nf = f->BW_cutoff_idx;  
     }
     BASOP_sub_end(); /* Entropy dec */
 
@@ -125,21 +119,21 @@ static int Dec_LC3_Channel(LC3_Dec *decoder, int channel, int bits_per_sample, U
     IF (sub(bfi, 1) != 0)
     {
         processAriDecoder_fx(bs_in, &bp_side, &mask_side, h_DecSetup->total_bits, decoder->yLen, decoder->fs_idx,
-                             h_DecSetup->enable_lpc_weighting, tns_numfilters, lsbMode, lastnz, &bfi, tns_order,
-                             fac_ns_idx, gg_idx, decoder->frame_dms,
-                             decoder->n_pc, decoder->be_bp_left, decoder->be_bp_right, 0, &spec_inv_idx, &scale,
-                             &fill_bits, sqQdec, &nf_seed, resBitBuf, indexes, &zero_frame, currentScratch);
+                             h_DecSetup->enable_lpc_weighting, tns_numfilters, lsbMode, lastnz, &bfi, f->tns_order,
+                             f->fac_ns_idx, f->gg_idx, decoder->frame_dms,
+                             decoder->n_pc, decoder->be_bp_left, decoder->be_bp_right, 0, &f->spec_inv_idx, &scale,
+                             &f->fill_bits, f->sqQdec, &f->nf_seed, f->resBitBuf, f->indexes, &f->zero_frame, f->currentScratch);
 #ifdef ENABLE_RFRAME
         test();
-        IF (sub(rframe, 1) == 0 && zero_frame == 0)
+        IF (sub(rframe, 1) == 0 && f->zero_frame == 0)
         {
             bfi = 2;  
-            spec_inv_idx = s_max(lastnz, BW_cutoff_bin_all[BW_cutoff_idx]);  
+            f->spec_inv_idx = s_max(lastnz, BW_cutoff_bin_all[f->BW_cutoff_idx]);  
         }
 #endif
         IF (bfi == 0)
         {
-            processAriDecoderScaling_fx(sqQdec, decoder->yLen, q_d_fx, &q_fx_exp);
+            processAriDecoderScaling_fx(f->sqQdec, decoder->yLen, f->q_d_fx, &f->q_fx_exp);
         }
     }
     BASOP_sub_end(); /* Ari dec */
@@ -149,14 +143,14 @@ static int Dec_LC3_Channel(LC3_Dec *decoder, int channel, int bits_per_sample, U
     IF (sub(bfi, 1) != 0)
     {
         /* currentScratch Size = 96 bytes */
-        processSnsQuantizeScfDecoder_fx(L_scf_idx, scf_q, currentScratch);
+        processSnsQuantizeScfDecoder_fx(f->L_scf_idx, f->scf_q, f->currentScratch);
     }
     BASOP_sub_end();
 
     BASOP_sub_start("PLC::ComputeStabFac");
     if (h_DecSetup->plcAd)
     {
-        processPLCcomputeStabFac_main(scf_q, h_DecSetup->plcAd->old_scf_q, h_DecSetup->plcAd->old_old_scf_q,
+        processPLCcomputeStabFac_main(f->scf_q, h_DecSetup->plcAd->old_scf_q, h_DecSetup->plcAd->old_old_scf_q,
                                       bfi, h_DecSetup->prev_bfi, h_DecSetup->prev_prev_bfi, &h_DecSetup->plcAd->stab_fac);
     }
     BASOP_sub_end();
@@ -173,54 +167,99 @@ static int Dec_LC3_Channel(LC3_Dec *decoder, int channel, int bits_per_sample, U
         }
 
         processPCmain_fx(rframe, &bfi, h_DecSetup->prev_bfi, decoder->yLen, decoder->frame_dms,
-                         h_DecSetup->q_old_res_fx, &h_DecSetup->q_old_res_fx_exp, sqQdec,
-                         h_DecSetup->q_old_d_fx, spec_inv_idx, ltpf_idx[0], scale, q_d_fx, &q_fx_exp,
-                         gg_idx, h_DecSetup->quantizedGainOff, &h_DecSetup->prev_gg, &h_DecSetup->prev_gg_e,
-                         &BW_cutoff_idx_nf, &h_DecSetup->prev_BW_cutoff_idx_nf, fac_ns_idx, &h_DecSetup->prev_fac_ns_fx,
+                         h_DecSetup->q_old_res_fx, &h_DecSetup->q_old_res_fx_exp, f->sqQdec,
+                         h_DecSetup->q_old_d_fx, f->spec_inv_idx, f->ltpf_idx[0], scale, f->q_d_fx, &f->q_fx_exp,
+                         f->gg_idx, h_DecSetup->quantizedGainOff, &h_DecSetup->prev_gg, &h_DecSetup->prev_gg_e,
+                         &f->BW_cutoff_idx_nf, &h_DecSetup->prev_BW_cutoff_idx_nf, f->fac_ns_idx, &h_DecSetup->prev_fac_ns_fx,
                          &h_DecSetup->pc_nbLostFramesInRow);
     }
     BASOP_sub_end();
 
+
+#ifdef DYNMEM_COUNT
+    Dyn_Mem_Out();
+#endif
+    f->bfi = bfi;
+    return bfi;
+}
+
+/* spec_exp != NULL: s_out is the Word32 MDCT spectrum of the frame instead of PCM. Channels do not
+   depend on each other here, so their synthesis can run in parallel */
+static int Dec_LC3_ChannelSynth(LC3_Dec *decoder, int channel, int bits_per_sample, void *s_out, DecChannelFrame *f,
+                                Word16 *spec_exp)
+{
+    Word16 scale;
+    Word32 offset;
+    Word16 bfi = f->bfi, silent = 0;
+    Counter i;
+    DecSetup *h_DecSetup = decoder->channel_setup[channel];
+
+#ifdef DYNMEM_COUNT
+    struct _dynmem
+    {
+        Counter i;
+        Word16  scale;
+        Word32  offset;
+        Word16  bfi, silent;
+    };
+    Dyn_Mem_In("Dec_LC3_ChannelSynth", sizeof(struct _dynmem));
+#endif
+
+#ifdef DISABLE_PLC
+    UNUSED(decoder->plcMeth);
+#endif
+
     IF (sub(bfi, 1) != 0)
     {
         BASOP_sub_start("Residual dec");
-        processResidualDecoding_fx(q_d_fx, q_fx_exp, decoder->yLen, resBitBuf, fill_bits);
+        processResidualDecoding_fx(f->q_d_fx, f->q_fx_exp, decoder->yLen, f->resBitBuf, f->fill_bits);
         BASOP_sub_end();
 
         BASOP_sub_start("Noisefill");
         /* currentScratch Size = 2 * MAX_LEN bytes */
-        IF (zero_frame == 0)
+        IF (f->zero_frame == 0)
         {
-            processNoiseFilling_fx(q_d_fx, nf_seed, q_fx_exp, fac_ns_idx, BW_cutoff_idx_nf, decoder->frame_dms,
-                                   h_DecSetup->prev_fac_ns_fx, spec_inv_idx, currentScratch);
+            decoder->kernels->noise_filling(f->q_d_fx, f->nf_seed, f->q_fx_exp, f->fac_ns_idx, f->BW_cutoff_idx_nf, decoder->frame_dms,
+                                            h_DecSetup->prev_fac_ns_fx, f->spec_inv_idx, f->currentScratch);
         }
         BASOP_sub_end();
 
         BASOP_sub_start("applyGlobalGain");
-        processApplyGlobalGain_fx(q_d_fx, &q_fx_exp, decoder->yLen, gg_idx, h_DecSetup->quantizedGainOff);
+        processApplyGlobalGain_fx(f->q_d_fx, &f->q_fx_exp, decoder->yLen, f->gg_idx, h_DecSetup->quantizedGainOff);
         BASOP_sub_end();
 
         BASOP_sub_start("Tns_dec");
         /* currentScratch Size = 48 bytes */
-        processTnsDecoder_fx(indexes, q_d_fx, decoder->yLen, tns_order, &q_fx_exp, BW_cutoff_idx, decoder->frame_dms,
-                             currentScratch);
+        decoder->kernels->tns_decoder(f->indexes, f->q_d_fx, decoder->yLen, f->tns_order, &f->q_fx_exp, f->BW_cutoff_idx,
+                                      decoder->frame_dms, f->currentScratch);
         BASOP_sub_end();
 
 #ifndef BE_MOVED_STAB_FAC
         BASOP_sub_start("SnsQuantScfDec");
         /* currentScratch Size = 96 bytes */
-        processSnsQuantizeScfDecoder_fx(L_scf_idx, scf_q, currentScratch);
+        processSnsQuantizeScfDecoder_fx(f->L_scf_idx, f->scf_q, f->currentScratch);
         BASOP_sub_end();
 #endif
 
         BASOP_sub_start("SnsInterpScfDec");
         /* currentScratch Size = 128 bytes */
-        processSnsInterpolateScf_fx(scf_q, int_scf_fx, int_scf_fx_exp, 0, decoder->bands_number, currentScratch);
+        decoder->kernels->sns_interpolate_scf(f->scf_q, f->int_scf_fx, f->int_scf_fx_exp, 0, decoder->bands_number, f->currentScratch);
         BASOP_sub_end();
 
+        /* digital silence, the spectrum stays zero */
+        test();
+        IF (bfi == 0 && f->zero_frame != 0)
+        {
+            silent = dec_at_rest(decoder, h_DecSetup);
+        }
+
         BASOP_sub_start("Mdct shaping_dec");
-        processScfScaling(int_scf_fx_exp, decoder->bands_number, &q_fx_exp);
-        processMdctShaping_fx(q_d_fx, int_scf_fx, int_scf_fx_exp, decoder->bands_offset, decoder->bands_number);
+        processScfScaling(f->int_scf_fx_exp, decoder->bands_number, &f->q_fx_exp);
+        IF (silent == 0)
+        {
+            decoder->kernels->mdct_shaping(f->q_d_fx, f->int_scf_fx, f->int_scf_fx_exp, decoder->bands_offset,
+                                           decoder->bands_number);
+        }
         BASOP_sub_end();
         /* end int_scf_fx */
     }
@@ -228,12 +267,13 @@ static int Dec_LC3_Channel(LC3_Dec *decoder, int channel, int bits_per_sample, U
     BASOP_sub_start("PLC::Main");
     /* currentScratch Size = 2 * MAX_LGW + 8 * MAX_LPROT + 12 * MAX_L_FRAME */
     processPLCmain_fx(decoder, decoder->plcMeth, &h_DecSetup->concealMethod, &h_DecSetup->nbLostFramesInRow, bfi,
-                      h_DecSetup->prev_bfi, decoder->la_zeroes, x_fx,
+                      h_DecSetup->prev_bfi, decoder->la_zeroes, f->x_fx,
                       h_DecSetup->stDec_ola_mem_fx, &h_DecSetup->stDec_ola_mem_fx_exp, h_DecSetup->q_old_d_fx,
-                      &h_DecSetup->q_old_fx_exp, q_d_fx, &q_fx_exp, decoder->yLen, decoder->fs_idx,
-                      decoder->bands_offset, &h_DecSetup->plc_damping, h_DecSetup->ltpf_mem_pitch_int,
+                      &h_DecSetup->q_old_fx_exp, f->q_d_fx, &f->q_fx_exp, decoder->yLen, decoder->fs_idx,
+                      decoder->bands_offset, &h_DecSetup->plc_damping,
+                      spec_exp != NULL ? 0 : h_DecSetup->ltpf_mem_pitch_int, /* no TD-PLC for spectrum output */
                       h_DecSetup->ltpf_mem_pitch_fr, &h_DecSetup->ns_cum_alpha, &h_DecSetup->ns_seed, h_DecSetup->plcAd,
-                      decoder->frame_dms, currentScratch);
+                      decoder->frame_dms, f->currentScratch);
     BASOP_sub_end();
 
 #ifdef NONBE_PLC4_ADAP_DAMP
@@ -242,69 +282,108 @@ static int Dec_LC3_Channel(LC3_Dec *decoder, int channel, int bits_per_sample, U
     {
         processPLCDampingScrambling_main_fx(bfi, h_DecSetup->concealMethod, h_DecSetup->nbLostFramesInRow,
                                             h_DecSetup->pc_nbLostFramesInRow, &h_DecSetup->ns_seed, &h_DecSetup->pc_seed,
-                                            h_DecSetup->ltpf_mem_pitch_int, ltpf_idx[0], q_d_fx, &q_fx_exp, h_DecSetup->q_old_d_fx,
+                                            h_DecSetup->ltpf_mem_pitch_int, f->ltpf_idx[0], f->q_d_fx, &f->q_fx_exp, h_DecSetup->q_old_d_fx,
                                             &h_DecSetup->q_old_fx_exp, decoder->yLen, h_DecSetup->plcAd->stab_fac, decoder->frame_dms,
                                             &h_DecSetup->plcAd->cum_fading_slow, &h_DecSetup->plcAd->cum_fading_fast,
-                                            &h_DecSetup->plc_damping, spec_inv_idx);
+                                            &h_DecSetup->plc_damping, f->spec_inv_idx);
     }
     BASOP_sub_end();
 #endif
 
-    BASOP_sub_start("Imdct");
-    /* currentScratch Size = 4 * MAX_LEN */
-    ProcessingIMDCT(decoder, q_d_fx, &q_fx_exp, h_DecSetup->stDec_ola_mem_fx, &h_DecSetup->stDec_ola_mem_fx_exp,
-                    x_fx, decoder->frame_dms,
-                    h_DecSetup->concealMethod, bfi, h_DecSetup->prev_bfi, h_DecSetup->nbLostFramesInRow,
-                    h_DecSetup->plcAd,
-                    currentScratch);
-    BASOP_sub_end();
+    IF (spec_exp != NULL)
+    {
+        /* the time domain tools do not run, they restart from silence if PCM output is requested later */
+        BASOP_sub_start("Spectrum output");
+        basop_memcpy(s_out, f->q_d_fx, decoder->yLen * sizeof(*f->q_d_fx));
+        basop_memset((Word32 *)s_out + decoder->yLen, 0, (decoder->frame_length - decoder->yLen) * sizeof(*f->q_d_fx));
+        *spec_exp = f->q_fx_exp;
+
+        basop_memset(f->x_fx, 0, decoder->frame_length * sizeof(*f->x_fx));
+        basop_memset(h_DecSetup->stDec_ola_mem_fx, 0,
+                     decoder->stDec_ola_mem_fx_len * sizeof(*h_DecSetup->stDec_ola_mem_fx));
+        basop_memset(h_DecSetup->ltpf_mem_x, 0, decoder->ltpf_mem_x_len * sizeof(*h_DecSetup->ltpf_mem_x));
+        basop_memset(h_DecSetup->ltpf_mem_y, 0, decoder->ltpf_mem_y_len * sizeof(*h_DecSetup->ltpf_mem_y));
+        h_DecSetup->ltpf_mem_active    = 0;
+        h_DecSetup->ltpf_mem_pitch_int = 0;
+        BASOP_sub_end();
+    }
+    ELSE IF (silent != 0)
+    {
+        /* same result as ProcessingIMDCT(), the overlap memory stays zero */
+        BASOP_sub_start("Imdct");
+        basop_memset(f->x_fx, 0, (decoder->frame_length + decoder->stDec_ola_mem_fx_len) * sizeof(*f->x_fx));
+        f->q_fx_exp                         = 0;
+        h_DecSetup->stDec_ola_mem_fx_exp = 0;
+        BASOP_sub_end();
+    }
+    ELSE
+    {
+        BASOP_sub_start("Imdct");
+        /* currentScratch Size = 4 * MAX_LEN + LC3_SCRATCH_ALIGN */
+        decoder->kernels->imdct(decoder, f->q_d_fx, &f->q_fx_exp, h_DecSetup->stDec_ola_mem_fx, &h_DecSetup->stDec_ola_mem_fx_exp,
+                                f->x_fx, decoder->frame_dms,
+                                h_DecSetup->concealMethod, bfi, h_DecSetup->prev_bfi, h_DecSetup->nbLostFramesInRow,
+                                h_DecSetup->plcAd,
+                                f->currentScratch);
+        BASOP_sub_end();
+    }
 
    
        BASOP_sub_start("PLC::Update");
     
   
 
-    processPLCupdate_fx(h_DecSetup->plcAd, x_fx, q_fx_exp, h_DecSetup->concealMethod, decoder->frame_length,
+    processPLCupdate_fx(h_DecSetup->plcAd, f->x_fx, f->q_fx_exp, h_DecSetup->concealMethod, decoder->frame_length,
                         decoder->fs_idx, &h_DecSetup->nbLostFramesInRow, &h_DecSetup->prev_prev_bfi, &h_DecSetup->prev_bfi,
-                        bfi, scf_q, h_DecSetup->stDec_ola_mem_fx, h_DecSetup->stDec_ola_mem_fx_exp, &h_DecSetup->ns_cum_alpha);
+                        bfi, f->scf_q, h_DecSetup->stDec_ola_mem_fx, h_DecSetup->stDec_ola_mem_fx_exp, &h_DecSetup->ns_cum_alpha);
     BASOP_sub_end();
 
+    IF (spec_exp != NULL)
+    {
+        BASOP_sub_sub_end();
+        BASOP_sub_end(); /* Decoder */
+#ifdef DYNMEM_COUNT
+        Dyn_Mem_Out();
+#endif
+        return bfi;
+    }
+
 #ifdef LTPF_DISABLE_FILTERING   
-    ltpf_idx[0] = 0;
-    ltpf_idx[1] = 0;
-    ltpf_idx[2] = 0;
+    f->ltpf_idx[0] = 0;
+    f->ltpf_idx[1] = 0;
+    f->ltpf_idx[2] = 0;
     h_DecSetup->ltpf_mem_active=0;
 #endif
 
 
     BASOP_sub_start("LtpfDec");
     /* currentScratch Size = 0.5 * MAX_LEN + 20 bytes */
-    process_ltpf_decoder_fx(&q_fx_exp, decoder->frame_length, decoder->ltpf_mem_x_len, decoder->fs_idx,
-                            decoder->ltpf_mem_y_len, &h_DecSetup->ltpf_mem_e, x_fx, h_DecSetup->ltpf_mem_x, x_fx,
-                            h_DecSetup->ltpf_mem_y, ltpf_idx[0], ltpf_idx[1], ltpf_idx[2],
+    process_ltpf_decoder_fx(&f->q_fx_exp, decoder->frame_length, decoder->ltpf_mem_x_len, decoder->fs_idx,
+                            decoder->ltpf_mem_y_len, &h_DecSetup->ltpf_mem_e, f->x_fx, h_DecSetup->ltpf_mem_x, f->x_fx,
+                            h_DecSetup->ltpf_mem_y, f->ltpf_idx[0], f->ltpf_idx[1], f->ltpf_idx[2],
                             &h_DecSetup->ltpf_mem_pitch_int, &h_DecSetup->ltpf_mem_pitch_fr, &h_DecSetup->ltpf_mem_gain,
                             &h_DecSetup->ltpf_mem_active, h_DecSetup->ltpf_scale_fac_idx, bfi,
                             h_DecSetup->concealMethod,
-                            h_DecSetup->plc_damping, &h_DecSetup->ltpf_mem_scale_fac_idx, currentScratch);
+                            h_DecSetup->plc_damping, &h_DecSetup->ltpf_mem_scale_fac_idx, f->currentScratch);
     BASOP_sub_end();
 
     BASOP_sub_start("Output scaling");
     {
-        scale  = sub(sub(31 + 16, bits_per_sample), q_fx_exp);
+        scale  = sub(sub(31 + 16, bits_per_sample), f->q_fx_exp);
         offset = L_shr_sat(32768, sub(16, scale));
         IF (bits_per_sample == 16)
         {
-            scale = sub(15, q_fx_exp);
+            scale = sub(15, f->q_fx_exp);
             FOR (i = 0; i < decoder->frame_length; i++)
             {
-                ((Word16 *)s_out)[i] = round_fx_sat(L_shr_sat(L_deposit_h(x_fx[i]), scale)); 
+                ((Word16 *)s_out)[i] = round_fx_sat(L_shr_sat(L_deposit_h(f->x_fx[i]), scale)); 
             }
         }
         ELSE
         {
             FOR (i = 0; i < decoder->frame_length; i++)
             {
-                ((Word32 *)s_out)[i] = L_shr_sat(L_add_sat(L_deposit_h(x_fx[i]), offset), scale); 
+                ((Word32 *)s_out)[i] = L_shr_sat(L_add_sat(L_deposit_h(f->x_fx[i]), offset), scale); 
             }
         }
     }
@@ -321,22 +400,135 @@ static int Dec_LC3_Channel(LC3_Dec *decoder, int channel, int bits_per_sample, U
     return bfi;
 }
 
-/* num_bytes = 0 -> bad frame */
-LC3_Error Dec_LC3(LC3_Dec *decoder, UWord8 *input, int num_bytes, void **output, int bits_per_sample, void *scratch, int bfi_ext)
+
+/* decode one channel of a frame */
+static int Dec_LC3_Channel(LC3_Dec *decoder, int channel, int bits_per_sample, UWord8 *bs_in, void *s_out, Word16 bfi,
+                           Word16 *spec_exp, Word8 *scratchBuffer)
+{
+    DecChannelFrame frame;
+
+    Dec_LC3_ChannelParse(decoder, channel, bs_in, bfi, &frame, scratchBuffer);
+    return Dec_LC3_ChannelSynth(decoder, channel, bits_per_sample, s_out, &frame, spec_exp);
+}
+
+/* take over the state and output of the speculatively concealed frame */
+static void Dec_LC3_CommitSpeculation(LC3_Dec *decoder, void **output)
+{
+    int      ch = 0, state_size = 0;
+    LC3_Dec *spec_state = decoder->spec_state;
+    Word32 * spec_pcm   = decoder->spec_pcm;
+    Word16   spec_bits  = decoder->spec_bits;
+
+    state_size = alloc_decoder(NULL, decoder->fs_out, decoder->channels, (LC3_PlcMode)decoder->plcMeth);
+    memcpy(decoder, spec_state, state_size);
+    alloc_decoder(decoder, decoder->fs_out, decoder->channels, (LC3_PlcMode)decoder->plcMeth); /* rebind */
+    decoder->spec_state = spec_state;
+    decoder->spec_pcm   = spec_pcm;
+    decoder->spec_bits  = 0;
+
+    for (ch = 0; ch < decoder->channels; ch++)
+    {
+        memcpy(output[ch], &spec_pcm[ch * DYN_MAX_LEN(decoder->fs_out)],
+               decoder->frame_length * (spec_bits == 16 ? sizeof(Word16) : sizeof(Word32)));
+    }
+}
+
+/* conceal a loss of the next frame on a copy of the decoder state, so that Dec_LC3() only has to
+   take over the result if the frame is really lost */
+LC3_Error Dec_LC3_Speculate(LC3_Dec *decoder, int bits_per_sample, void *scratch)
 {
-    int       ch = 0, bfi = bfi_ext;
+    int      ch = 0, state_size = 0;
+    LC3_Dec *spec_state = decoder->spec_state;
+    void *   output[MAX_CHANNELS];
+    UWord8   dummy = 0;
+
+    state_size = alloc_decoder(NULL, decoder->fs_out, decoder->channels, (LC3_PlcMode)decoder->plcMeth);
+    memcpy(spec_state, decoder, state_size);
+    alloc_decoder(spec_state, decoder->fs_out, decoder->channels, (LC3_PlcMode)decoder->plcMeth); /* rebind */
+    spec_state->spec_state = NULL;
+    spec_state->spec_bits  = 0;
+
+    for (ch = 0; ch < decoder->channels; ch++)
+    {
+        output[ch] = &decoder->spec_pcm[ch * DYN_MAX_LEN(decoder->fs_out)];
+    }
+
+    Dec_LC3(spec_state, &dummy, 0, output, bits_per_sample, NULL, scratch, 1);
+    decoder->spec_bits = bits_per_sample;
+
+    return LC3_OK;
+}
+
+/* arguments of the channel synthesis jobs of one frame for parallel decoding */
+typedef struct
+{
+    LC3_Dec *       decoder;
+    void **         output;
+    Word16 *        spec_exp;
+    int             bits_per_sample;
+    DecChannelFrame frame[MAX_CHANNELS];
+} DecChannelJobs;
+
+static void Dec_LC3_ChannelJob(void *ctx, int ch)
+{
+    DecChannelJobs *jobs = (DecChannelJobs *)ctx;
+
+    Dec_LC3_ChannelSynth(jobs->decoder, ch, jobs->bits_per_sample, jobs->output[ch], &jobs->frame[ch],
+                         jobs->spec_exp ? &jobs->spec_exp[ch] : NULL);
+}
+
+/* num_bytes = 0 -> bad frame. spec_exp != NULL -> output is the Word32 MDCT spectrum with exponent spec_exp[ch] */
+LC3_Error Dec_LC3(LC3_Dec *decoder, UWord8 *input, int num_bytes, void **output, int bits_per_sample, Word16 *spec_exp,
+                  void *scratch, int bfi_ext)
+{
+    int       ch = 0, bfi = bfi_ext, parallel = 0, scratch_slice = 0;
     LC3_Error err = LC3_OK;
+    DecChannelJobs jobs;
     //int       fec_num_bytes;
     int       lc3_num_bytes;
     //int       lc3_channel_num_bytes;
     //int       channel_bfi, out_bfi;
     //Word16    channel_epmr;
 
+#if BTLLC_5MS_MODE
+    /* the decoder history is sized for 5 ms frames, the 10 ms default has to be changed */
+    if (decoder->frame_dms > 50)
+    {
+        return LC3_FRAMEMS_ERROR;
+    }
+#endif
+
     if (bfi == 0)
     {
         bfi = !num_bytes;
     }
 
+    /* a speculatively concealed frame is only valid for the frame following its computation */
+    if (decoder->spec_bits != 0)
+    {
+        if (bfi == 1 && decoder->spec_bits == bits_per_sample && spec_exp == NULL)
+        {
+            Dec_LC3_CommitSpeculation(decoder, output);
+            return LC3_DECODE_ERROR;
+        }
+        decoder->spec_bits = 0;
+    }
+
+    /* channels only depend on each other through bfi, which is final after parsing. All channels are
+       parsed in order, each into its own scratch slice, and the job runner takes their synthesis */
+    parallel = decoder->parallel_for != NULL && decoder->channels > 1;
+#if WMOPS
+    parallel = 0; /* the complexity counters are global */
+#endif
+    if (parallel)
+    {
+        jobs.decoder         = decoder;
+        jobs.output          = output;
+        jobs.spec_exp        = spec_exp;
+        jobs.bits_per_sample = bits_per_sample;
+        scratch_slice        = dec_channel_scratch_size(decoder, 1);
+    }
+
 	for (ch = 0; ch < decoder->channels; ch++)
 	{
 		lc3_num_bytes = num_bytes / decoder->channels + (ch < (num_bytes % decoder->channels));
@@ -366,9 +558,22 @@ LC3_Error Dec_LC3(LC3_Dec *decoder, UWord8 *input, int num_bytes, void **output,
 			decoder->channel_setup[ch]->last_size = lc3_num_bytes;
 		}
 
-		bfi = Dec_LC3_Channel(decoder, ch, bits_per_sample, input, output[ch], bfi, scratch);
+		if (parallel)
+		{
+			bfi = Dec_LC3_ChannelParse(decoder, ch, input, bfi, &jobs.frame[ch], (Word8 *)scratch + ch * scratch_slice);
+		}
+		else
+		{
+			bfi = Dec_LC3_Channel(decoder, ch, bits_per_sample, input, output[ch], bfi, spec_exp ? &spec_exp[ch] : NULL,
+			                      scratch);
+		}
 		input += decoder->channel_setup[ch]->targetBytes;
 	}
 
+    if (parallel)
+    {
+        decoder->parallel_for(decoder->parallel_user, Dec_LC3_ChannelJob, &jobs, decoder->channels);
+    }
+
     return bfi == 1 ? LC3_DECODE_ERROR : LC3_OK;
 }
@@ -56,21 +56,39 @@
 #define DYN_MAX_LPROT(fs) ((512 * (CODEC_FS(fs) / 100)) / 320)
 
 #define DYN_MAX_PLOCS(fs) (DYN_MAX_LPROT(fs) / 4 + 1)
+#if BTLLC_5MS_MODE
+/* the decoder only runs 5 and 2.5 ms frames, PLC history is kept for 5 ms and there is no PhECU state */
+#define DYN_MAX_DEC_LEN(fs) (DYN_MAX_LEN(fs) / 2)
+#define MAX_DEC_BW (MAX_BW / 2)
+#define DYN_PHECU_PLOCS(fs) 0
+#else
+#define DYN_MAX_DEC_LEN(fs) DYN_MAX_LEN(fs)
+#define MAX_DEC_BW MAX_BW
+#define DYN_PHECU_PLOCS(fs) DYN_MAX_PLOCS(fs)
+#endif
 #define DYN_MAX_MDCT_LEN(fs) (DYN_MAX_LEN(fs) - (180 * DYN_MAX_LEN(fs) / 480))
+#ifdef LC3_FLOAT_ANALYSIS
+/* processMdct_fl() needs 4 float buffers of frame_length instead of the 4 * MAX_LEN bytes of processMdct_fx() */
+#define DYN_ENC_SCRATCH_SIZE(frame_length) (26 * MAX(frame_length, 160) + 64 + LC3_SCRATCH_ALIGN)
+#else
+#define DYN_ENC_SCRATCH_SIZE(frame_length) (14 * MAX(frame_length, 160) + 64 + LC3_SCRATCH_ALIGN)
+#endif
+#define DYN_DEC_SCRATCH_SIZE(fs) (12 * DYN_MAX_LEN(fs) + 752 + LC3_SCRATCH_ALIGN)
+#define DYN_DEC_SCRATCH_SIZE_APLC(fs) (2 * MAX_LGW + 8 * DYN_MAX_LPROT(fs) + 8 * DYN_MAX_LEN(fs))
 
 #define  MAX_PITCH_FS(fs) (CEILING((MAX_PITCH_12K8 * CODEC_FS(fs)), (12800)))
 
 #ifdef NONBE_FIX_PCMHIST_LENGTHS
-/*  get the maximum buffer size assuming 10 ms framing */
+/*  get the maximum buffer size for the longest decoder frame */
 /*  MAX_PITCH was previously always  the highest fs in the current  SUBSET , i.e. typically 48 kHz  */
 /*  now fs(from incoming wav file)  adaptive  MAX_PITCH_FS(fs) is used instead  */
 
-#define  DYN_MAX_LEN_PCM_PLC_CLASSIFIER(fs) (MAX_PITCH_FS(fs) + DYN_MAX_LEN(fs))                  /* CLASSIFIER PCM memory requirement   */
-#define  DYN_MAX_LEN_PCM_PLC_TDCAPPLYFILTER(fs) ((M+1) + MAX_PITCH_FS(fs) + (DYN_MAX_LEN(fs)/2))  /* TDC filtering PCM memory requirement */
+#define  DYN_MAX_LEN_PCM_PLC_CLASSIFIER(fs) (MAX_PITCH_FS(fs) + DYN_MAX_DEC_LEN(fs))                  /* CLASSIFIER PCM memory requirement   */
+#define  DYN_MAX_LEN_PCM_PLC_TDCAPPLYFILTER(fs) ((M+1) + MAX_PITCH_FS(fs) + (DYN_MAX_DEC_LEN(fs)/2))  /* TDC filtering PCM memory requirement */
 #define  DYN_MAX_LEN_PCM_PLC(fs)  MAX(DYN_MAX_LEN_PCM_PLC_CLASSIFIER(fs), DYN_MAX_LEN_PCM_PLC_TDCAPPLYFILTER(fs) )
 
 #else
- #define DYN_MAX_LEN_PCM_PLC(fs) (MAX_PITCH + DYN_MAX_LEN(fs))
+ #define DYN_MAX_LEN_PCM_PLC(fs) (MAX_PITCH + DYN_MAX_DEC_LEN(fs))
 #endif
 #define FRAME_MS_BLOCK 25
 
@@ -119,6 +137,7 @@
 #define NONBE_PLC3_GAIN_CONTROL /* Add gain control to prevent high energy increase @ 2.5 and 5ms */
 #define NONBE_PLC4_ADAP_DAMP    /* Improved adaptive damping and sign scrambling */
 /* #define NONBE_PLC2_DEBUG */  /* Switch to activate PLC2 debug code to extended parameter extraction from fixpoint */
+/* #define DEBUG_SCRATCH */     /* Poison the scratch arena and check that scratch regions are carved inside of it without intersecting */
 
 /* PLC2 NON-BE Optimization   */
 
@@ -194,6 +213,7 @@ do not change  __forceinline  for mex compilation using  gcc6.3.0 or larger
 #endif
 
 #define MAX_CHANNELS 2
+#define MAX_SNAPSHOT_BUFFERS 8 /* channel buffers kept in a state snapshot */
 #define MIN_NBYTES 20      /* 16kbps at 8/16/24/32/48kHz */
 #define MAX_NBYTES 435     /* 320kbps at 44.1kHz */
 #define MAX_NBYTES_RED 400 /* 320kbps at 48kHz */
@@ -260,6 +280,8 @@ do not change  __forceinline  for mex compilation using  gcc6.3.0 or larger
 /* MDCT */
 #define TWIDDLE WORD322WORD16(0x5a82799a)
 #define MDCT_MEM_LEN_MAX (MAX_LEN - ((180 * MAX_LEN) / 480))
+#define SPEC_IN_HEADROOM 4 /* headroom of spectra passed to the encoder, as left by processMdct_fx() */
+#define FL_TW_LEN 960      /* float analysis twiddles, every fft length N/2 used by the MDCT divides it */
 
 /* TNS */
 #define TNS_NUMFILTERS_MAX 2
@@ -271,6 +293,7 @@ do not change  __forceinline  for mex compilation using  gcc6.3.0 or larger
 /* OLPA/LTPF */
 #define LEN_12K8 128
 #define LEN_6K4 64
+#define ATTDEC_BLOCK_LEN (LEN_12K8 / 4) /* attack detector block, 2.5 ms at 12.8 kHz */
 #define MIN_PITCH_6K4 17
 #define MAX_PITCH_6K4 114
 #define RANGE_PITCH_6K4 98
@@ -498,12 +521,12 @@ do not change  __forceinline  for mex compilation using  gcc6.3.0 or larger
 /* Scratch buffer defines */
 #define scratchBuffer_ACTIVE
 #define SCRATCH_BUF_LEN_ENC (4 * MAX_LEN + 32 + 32 + 2 * MAX_LEN + 3 * MAX_LEN + MAX_LEN)
-#define SCRATCH_BUF_LEN_ENC_CURRENT_SCRATCH (4 * MAX_LEN)
+#define SCRATCH_BUF_LEN_ENC_CURRENT_SCRATCH (4 * MAX_LEN + LC3_SCRATCH_ALIGN)
 
 #define SCRATCH_BUF_LEN_ENC_TOT (SCRATCH_BUF_LEN_ENC + SCRATCH_BUF_LEN_ENC_CURRENT_SCRATCH)
 
 #define SCRATCH_BUF_LEN_DEC (4 * MAX_LEN + 2 * MAX_LEN + 32 + 32 + 2 * MAX_LEN + 32 + 128 + 128)
-#define SCRATCH_BUF_LEN_DEC_CURRENT_SCRATCH (2 * MAX_LGW + 8 * MAX_LPROT + 12 * MAX_L_FRAME)
+#define SCRATCH_BUF_LEN_DEC_CURRENT_SCRATCH (2 * MAX_LGW + 8 * MAX_LPROT + 12 * MAX_L_FRAME + LC3_SCRATCH_ALIGN)
 #define SCRATCH_BUF_LEN_DEC_TOT (SCRATCH_BUF_LEN_DEC + SCRATCH_BUF_LEN_DEC_CURRENT_SCRATCH)
 
 #define ADVACED_PLC_SIZE                                                                                               \
@@ -540,7 +563,15 @@ do not change  __forceinline  for mex compilation using  gcc6.3.0 or larger
 #define RAM_ALIGN
 #endif
 
+#ifdef DEBUG_SCRATCH
+#define scratchAlign(ptr, offset) scratch_align_check((void *)(ptr), (int)(offset))
+#else
 #define scratchAlign(ptr, offset) (void *)((char *)(ptr) + (offset))
+#endif
+/* as scratchAlign(), the region behind is rounded up to LC3_SCRATCH_ALIGN for the vector loads of the
+   transforms. Every use needs LC3_SCRATCH_ALIGN bytes more in the DYN_*_SCRATCH_SIZE it is carved from */
+#define scratchAlignSimd(ptr, offset)                                                                                \
+    (void *)(((uintptr_t)scratchAlign(ptr, offset) + LC3_SCRATCH_ALIGN - 1) & ~(uintptr_t)(LC3_SCRATCH_ALIGN - 1))
 #define ALIGN_BUFFER_STRUCT
 
 
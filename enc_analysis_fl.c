@@ -0,0 +1,706 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+#include "functions.h"
+
+#ifdef LC3_FLOAT_ANALYSIS
+
+/* Single precision encoder analysis (make float). The stages below replace their
+ * fixed-point counterparts in Enc_LC3_Channel and exchange data with the rest of
+ * the encoder in the usual Word32 mantissa + block exponent format, so all
+ * quantization and coding stays untouched and the bitstream stays compliant.
+ * Output is not bit-exact to the fixed-point encoder. Loops are kept simple and
+ * branch free so the compiler can vectorize them for the target (-mavx2 -mfma). */
+
+#include <math.h>
+
+#define FL_PI 3.14159265358979323846
+
+/* float value of a fixed-point mantissa with exponent e */
+static float fl_scale(Word16 e) { return ldexpf(1.0f, e - 31); }
+
+/* convert to Word32 mantissas with a common exponent of at least e_min, keeping hr bits of headroom */
+static void fl_to_fixed(const float *x, Word32 *y, Word16 *y_e, Word16 n, Word16 hr, Word16 e_min)
+{
+    int   i, e;
+    float m = 0.0f, s;
+
+    FOR (i = 0; i < n; i++)
+    {
+        m = fmaxf(m, fabsf(x[i]));
+    }
+    IF (m == 0.0f)
+    {
+        basop_memset(y, 0, n * sizeof(*y));
+        *y_e = e_min;
+        return;
+    }
+    frexpf(m, &e);
+    e    = s_max(e + hr, e_min);
+    s    = ldexpf(1.0f, 31 - e);
+    *y_e = (Word16)e;
+    FOR (i = 0; i < n; i++)
+    {
+        y[i] = (Word32)lrintf(x[i] * s);
+    }
+}
+
+/* mixed radix complex fft for lengths 2^a*3^b*5^c dividing FL_TW_LEN */
+static void fl_fft(const float *in_re, const float *in_im, float *out_re, float *out_im, int n, int is,
+                   int tw_step)
+{
+    int   p, m, k, q, r;
+    float t_re[5], t_im[5], a_re, a_im;
+
+    p = 5;
+    if (n % 3 == 0)
+        p = 3;
+    if (n % 2 == 0)
+        p = 2;
+    if (n % 4 == 0)
+        p = 4;
+    m = n / p;
+
+    IF (m == 1)
+    {
+        FOR (q = 0; q < p; q++)
+        {
+            out_re[q] = in_re[q * is];
+            out_im[q] = in_im[q * is];
+        }
+    }
+    ELSE
+    {
+        FOR (q = 0; q < p; q++)
+        {
+            fl_fft(in_re + q * is, in_im + q * is, out_re + q * m, out_im + q * m, m, is * p, tw_step * p);
+        }
+    }
+
+    FOR (k = 0; k < m; k++)
+    {
+        FOR (q = 0; q < p; q++)
+        {
+            int j    = (q * k * tw_step) % FL_TW_LEN;
+            a_re     = out_re[q * m + k];
+            a_im     = out_im[q * m + k];
+            t_re[q]  = a_re * fl_twiddle_re[j] - a_im * fl_twiddle_im[j];
+            t_im[q]  = a_re * fl_twiddle_im[j] + a_im * fl_twiddle_re[j];
+        }
+        FOR (r = 0; r < p; r++)
+        {
+            a_re = 0.0f;
+            a_im = 0.0f;
+            FOR (q = 0; q < p; q++)
+            {
+                int j = (q * r * m * tw_step) % FL_TW_LEN;
+                a_re += t_re[q] * fl_twiddle_re[j] - t_im[q] * fl_twiddle_im[j];
+                a_im += t_re[q] * fl_twiddle_im[j] + t_im[q] * fl_twiddle_re[j];
+            }
+            out_re[r * m + k] = a_re;
+            out_im[r * m + k] = a_im;
+        }
+    }
+}
+
+/* unnormalized dct-iv, y[k] = sum x[n] cos(pi/N (n+1/2)(k+1/2)), via an N/2 point fft,
+   work holds 2 * N floats */
+static void fl_dct_iv(const float *x, float *y, int N, float *work)
+{
+    int    n, half = N >> 1;
+    float *z_re, *z_im, *Z_re, *Z_im;
+    float  w_re, w_im, s_re, s_im, t;
+
+    z_re = work;
+    z_im = z_re + half;
+    Z_re = z_im + half;
+    Z_im = Z_re + half;
+
+    /* pre twiddle exp(-i*pi*(4n+1)/(4N)) by recursion with step exp(-i*pi/N) */
+    w_re = (float)cos(FL_PI / (4.0 * N));
+    w_im = (float)-sin(FL_PI / (4.0 * N));
+    s_re = (float)cos(FL_PI / N);
+    s_im = (float)-sin(FL_PI / N);
+    FOR (n = 0; n < half; n++)
+    {
+        z_re[n] = x[2 * n] * w_re - x[N - 1 - 2 * n] * w_im;
+        z_im[n] = x[2 * n] * w_im + x[N - 1 - 2 * n] * w_re;
+        t       = w_re * s_re - w_im * s_im;
+        w_im    = w_re * s_im + w_im * s_re;
+        w_re    = t;
+    }
+
+    fl_fft(z_re, z_im, Z_re, Z_im, half, 1, FL_TW_LEN / half);
+
+    /* post twiddle exp(-i*pi*n/N) */
+    w_re = 1.0f;
+    w_im = 0.0f;
+    FOR (n = 0; n < half; n++)
+    {
+        y[2 * n]         = Z_re[n] * w_re - Z_im[n] * w_im;
+        y[N - 1 - 2 * n] = -(Z_re[n] * w_im + Z_im[n] * w_re);
+        t                = w_re * s_re - w_im * s_im;
+        w_im             = w_re * s_im + w_im * s_re;
+        w_re             = t;
+    }
+}
+
+void processMdct_fl(LC3_Enc *encoder, Word16 x[], Word16 mem[], Word32 y[], Word16 *y_e, Word8 *scratchBuffer)
+{
+    Word16        N, wLen, memLen, z, m;
+    const Word16 *w;
+    int           i;
+    float *       buf, *u, *v, *work;
+
+#if BTLLC_5MS_MODE
+    N      = 240;
+    w      = LowDelayShapes_n960_N240_5ms;
+    wLen   = 420;
+    memLen = encoder->stEnc_mdct_mem_len;
+#else
+    N      = encoder->frame_length;
+    w      = encoder->W_fx;
+    wLen   = encoder->W_size;
+    memLen = encoder->stEnc_mdct_mem_len;
+#endif
+
+    u    = (float *)scratchAlign(scratchBuffer, 0);   /* Size = 4 * N */
+    buf  = (float *)scratchAlign(u, sizeof(*u) * N); /* Size = 4 * 2 * N */
+    v    = (float *)scratchAlign(buf, 0);            /* Size = 4 * N, buf is folded into u before */
+    work = (float *)scratchAlign(v, sizeof(*v) * N); /* Size = 4 * 2 * N */
+
+    z = (N << 1) - wLen; /* number of leading zeros in window */
+    m = N >> 1;          /* half block size */
+
+    FOR (i = 0; i < memLen; i++)
+    {
+        buf[i] = mem[i];
+    }
+    FOR (i = 0; i < N; i++)
+    {
+        buf[memLen + i] = x[i];
+    }
+    basop_memmove(mem, &x[N - memLen], memLen * sizeof(Word16));
+
+    /* windowing and folding, same layout as processMdct_fx() */
+    FOR (i = 0; i < m; i++)
+    {
+        u[m + i] = buf[i] * w[i] - buf[2 * m - 1 - i] * w[2 * m - 1 - i];
+    }
+    FOR (i = 0; i < z; i++)
+    {
+        u[m - 1 - i] = buf[2 * m + i] * w[2 * m + i];
+    }
+    FOR (i = z; i < m; i++)
+    {
+        u[m - 1 - i] = buf[2 * m + i] * w[2 * m + i] + buf[4 * m - 1 - i] * w[4 * m - 1 - i];
+    }
+
+    fl_dct_iv(u, v, N, work);
+
+    /* same scale as the fixed-point transform (window in Q15 incl. 2^4, X_EXP) */
+    FOR (i = 0; i < N; i++)
+    {
+        v[i] *= fl_scale(X_EXP - 2);
+    }
+
+    /* keep the exponent of processMdct_fx() (windowing, cfft and dct_IV() twiddle scaling) unless the
+       signal needs more, the following SNS shaping saturates and relies on that headroom */
+    fl_to_fixed(v, y, y_e, N, 3, X_EXP - 2 + 2 + sub(15, norm_s(m - 1)));
+}
+
+void processPerBandEnergy_fl(Word32 *d2_fx, Word16 *d2_fx_exp, Word32 *d_fx, Word16 d_fx_exp,
+                             const Word16 *band_offsets, Word16 fs_idx, Word16 n_bands, Word16 linear, Word16 frame_dms,
+                             Word8 *scratchBuffer)
+{
+    int    b, k, start, stop, maxBwBin;
+    float *d, e[MAX_BANDS_NUMBER], s;
+
+    UNUSED(fs_idx);
+    UNUSED(linear);
+
+    d = (float *)scratchAlign(scratchBuffer, 0); /* Size = 4 * MAX_BW */
+
+    maxBwBin = MAX_BW;
+#if BTLLC_5MS_MODE
+    maxBwBin = MAX_BW >> 1;
+    UNUSED(frame_dms);
+#else
+    IF (frame_dms == 50)
+    {
+        maxBwBin = MAX_BW >> 1;
+    }
+#endif
+    s = fl_scale(d_fx_exp);
+    FOR (k = 0; k < s_min(band_offsets[n_bands], maxBwBin); k++)
+    {
+        d[k] = d_fx[k] * s;
+    }
+
+    FOR (b = 0; b < n_bands; b++)
+    {
+        start = band_offsets[b];
+        stop  = band_offsets[b + 1];
+        s     = 0.0f;
+        FOR (k = start; k < s_min(stop, maxBwBin); k++)
+        {
+            s += d[k] * d[k];
+        }
+        e[b] = s / (stop - start);
+    }
+
+    fl_to_fixed(e, d2_fx, d2_fx_exp, n_bands, 0, -31);
+}
+
+void processSnsComputeScf_fl(Word32 *d2_fx, Word16 d2_fx_exp, Word16 fs_idx, Word16 n_bands, Word16 *scf,
+                             Word16 scf_smoothing_enabled, Word8 *scratchBuffer)
+{
+    int    i;
+    float  d2[MAX_BANDS_NUMBER], d3[MAX_BANDS_NUMBER], d4[MAX_BANDS_NUMBER], ds[M], s, mean, nf;
+    Word32 L_mean, L_tmp;
+    Word16 scf_smooth[M];
+
+    UNUSED(scratchBuffer);
+
+    s = fl_scale(d2_fx_exp);
+    FOR (i = 0; i < n_bands; i++)
+    {
+        d2[i] = d2_fx[i] * s;
+    }
+
+    /* band duplication up to 64 bands */
+#if !BTLLC_5MS_MODE
+    IF (n_bands < 32)
+    {
+        int r = 32 - n_bands;
+        FOR (i = n_bands - 1; i >= r; i--)
+        {
+            d2[(i + r) * 2 + 1] = d2[i];
+            d2[(i + r) * 2 + 0] = d2[i];
+        }
+        FOR (i = r - 1; i >= 0; i--)
+        {
+            d2[i * 4 + 3] = d2[i];
+            d2[i * 4 + 2] = d2[i];
+            d2[i * 4 + 1] = d2[i];
+            d2[i * 4 + 0] = d2[i];
+        }
+        n_bands = 64;
+    }
+    ELSE
+#endif
+    IF (n_bands < 64)
+    {
+        int r = 64 - n_bands;
+        FOR (i = n_bands - 1; i >= r; i--)
+        {
+            d2[i + r] = d2[i];
+        }
+        FOR (i = r - 1; i >= 0; i--)
+        {
+            d2[i * 2 + 1] = d2[i];
+            d2[i * 2 + 0] = d2[i];
+        }
+        n_bands = 64;
+    }
+
+    /* smoothing and pre-emphasis, tilt from the fixed-point table */
+    d3[0] = 0.75f * d2[0] + 0.25f * d2[1];
+    FOR (i = 1; i < MAX_BANDS_NUMBER - 1; i++)
+    {
+        d3[i] = 0.5f * d2[i] + 0.25f * (d2[i - 1] + d2[i + 1]);
+    }
+    d3[MAX_BANDS_NUMBER - 1] = 0.75f * d2[MAX_BANDS_NUMBER - 1] + 0.25f * d2[MAX_BANDS_NUMBER - 2];
+    FOR (i = 0; i < MAX_BANDS_NUMBER; i++)
+    {
+        d3[i] *= ldexpf((float)lpc_pre_emphasis[fs_idx][i], lpc_pre_emphasis_e[fs_idx][i] - 15);
+    }
+
+    /* noise floor at -40dB, log domain */
+    mean = 0.0f;
+    FOR (i = 0; i < MAX_BANDS_NUMBER; i++)
+    {
+        mean += d3[i];
+    }
+    mean = mean / MAX_BANDS_NUMBER;
+    nf   = fmaxf(log2f(fmaxf(mean, 1e-30f)), -25965.0f / 512.0f) - 6803.0f / 512.0f;
+    FOR (i = 0; i < MAX_BANDS_NUMBER; i++)
+    {
+        d4[i] = fmaxf(nf, log2f(fmaxf(d3[i], 1e-30f)));
+    }
+
+    /* downsampling */
+    ds[0] = (d4[0] + d4[1] + d4[2]) / 4.0f + d4[3] / 6.0f + d4[4] / 12.0f;
+    FOR (i = 1; i < M - 1; i++)
+    {
+        ds[i] = (d4[i * 4 - 1] + d4[i * 4 + 4]) / 12.0f + (d4[i * 4] + d4[i * 4 + 3]) / 6.0f +
+                (d4[i * 4 + 1] + d4[i * 4 + 2]) / 4.0f;
+    }
+    ds[M - 1] = d4[59] / 12.0f + d4[60] / 6.0f + (d4[61] + d4[62] + d4[63]) / 4.0f;
+
+    /* remove mean and scaling, Q10 log2 domain as processSnsComputeScf_fx() */
+    mean = 0.0f;
+    FOR (i = 0; i < M; i++)
+    {
+        mean += ds[i];
+    }
+    mean = mean / M;
+    FOR (i = 0; i < M; i++)
+    {
+        scf[i] = (Word16)lrintf(fminf(fmaxf(0.85f * 1024.0f * (ds[i] - mean), -32768.0f), 32767.0f));
+    }
+
+    /* scale factor smoothing, integer as in the fixed-point encoder */
+    IF (scf_smoothing_enabled)
+    {
+        scf_smooth[0] = L_shr(L_mult0(L_add(L_add(scf[0], scf[1]), scf[2]), 10923), 15);
+        L_mean        = scf_smooth[0];
+        scf_smooth[1] = L_shr(L_add(L_add(L_add(scf[0], scf[1]), scf[2]), scf[3]), 2);
+        L_mean        = L_add(L_mean, scf_smooth[1]);
+        FOR (i = 2; i < M - 2; i++)
+        {
+            L_tmp         = L_add(L_add(L_add(L_add(scf[i - 2], scf[i - 1]), scf[i]), scf[i + 1]), scf[i + 2]);
+            scf_smooth[i] = L_shr(L_mult0(L_tmp, 13107), 16);
+            L_mean        = L_add(L_mean, scf_smooth[i]);
+        }
+        scf_smooth[M - 2] = L_shr(L_add(L_add(L_add(scf[M - 4], scf[M - 3]), scf[M - 2]), scf[M - 1]), 2);
+        L_mean            = L_add(L_mean, scf_smooth[M - 2]);
+        scf_smooth[M - 1] = L_shr(L_mult0(L_add(L_add(scf[M - 3], scf[M - 2]), scf[M - 1]), 10923), 15);
+        L_mean            = L_add(L_mean, scf_smooth[M - 1]);
+
+        L_mean = L_shr(L_mean, 4);
+        FOR (i = 0; i < M; i++)
+        {
+            scf[i] = L_shr(L_sub(scf_smooth[i], L_mean), 1);
+        }
+    }
+}
+
+/* float lattice analysis, quantization and bit count of processTnsCoder_fx(); the
+   filtering itself runs on the Word32 spectrum with the quantized coefficients */
+void processTnsCoder_fl(Word16 *bits, Word16 indexes[], Word32 x[], Word16 BW_cutoff_idx, Word16 order[],
+                        Word16 *numfilters, Word16 enable_lpc_weighting, Word16 nSubdivisions, Word16 frame_dms,
+                        Word16 maxLen, Word8 *scratchBuffer)
+{
+    int           i, j, k, sd, n, lag, start, stop, maxOrder, xLen, stopfreq;
+    Word16        startfreq[TNS_NUMFILTERS_MAX], RC[MAXLAG], idx;
+    Word32        state[MAXLAG], tmpSave, tmp, xi;
+    const Word16 *subdiv_startfreq, *subdiv_stopfreq;
+    float *       xf, r[MAXLAG + 1], a[MAXLAG + 1], a_tmp[MAXLAG + 1], rc[MAXLAG];
+    float         e, en, sum, k_rc, pg, alpha, g;
+
+    UNUSED(maxLen);
+
+    xf = (float *)scratchAlign(scratchBuffer, 0); /* Size = 4 * MAX_LEN */
+
+    *bits       = 0;
+    maxOrder    = MAXLAG;
+    *numfilters = 1;
+    xLen        = BW_cutoff_bin_all[BW_cutoff_idx];
+#if BTLLC_5MS_MODE
+    startfreq[0]     = 6;
+    subdiv_startfreq = tns_subdiv_startfreq_48k_5ms;
+    subdiv_stopfreq  = tns_subdiv_stopfreq_48k_5ms;
+    xLen             = xLen >> 1;
+    maxOrder         = 4;
+    *numfilters      = 2;
+    startfreq[1]     = xLen >> 1;
+    UNUSED(frame_dms);
+#else
+    SWITCH (frame_dms)
+    {
+    case 25:
+        startfreq[0]     = 3;
+        subdiv_startfreq = tns_subdiv_startfreq_2_5ms[BW_cutoff_idx];
+        subdiv_stopfreq  = tns_subdiv_stopfreq_2_5ms[BW_cutoff_idx];
+        xLen             = xLen >> 2;
+        maxOrder         = 4;
+        BREAK;
+    case 50:
+        startfreq[0]     = 6;
+        subdiv_startfreq = tns_subdiv_startfreq_5ms[BW_cutoff_idx];
+        subdiv_stopfreq  = tns_subdiv_stopfreq_5ms[BW_cutoff_idx];
+        xLen             = xLen >> 1;
+        maxOrder         = 4;
+        BREAK;
+    default: /* 100 */
+        startfreq[0]     = 12;
+        subdiv_startfreq = tns_subdiv_startfreq[BW_cutoff_idx];
+        subdiv_stopfreq  = tns_subdiv_stopfreq[BW_cutoff_idx];
+        BREAK;
+    }
+
+    IF (BW_cutoff_idx >= 3 && frame_dms >= 50)
+    {
+        *numfilters  = 2;
+        startfreq[1] = xLen >> 1;
+    }
+#endif
+
+    /* the autocorrelation is normalized per subdivision, so the spectrum exponent is not needed */
+    FOR (i = 0; i < xLen; i++)
+    {
+        xf[i] = (float)x[i];
+    }
+    basop_memset(state, 0, MAXLAG * sizeof(*state));
+
+    FOR (j = 0; j < *numfilters; j++)
+    {
+        /* normalized autocorrelation over the subdivisions */
+        FOR (lag = 0; lag <= maxOrder; lag++)
+        {
+            r[lag] = 0.0f;
+        }
+        FOR (sd = 0; sd < nSubdivisions; sd++)
+        {
+            start = subdiv_startfreq[nSubdivisions * j + sd];
+            stop  = subdiv_stopfreq[nSubdivisions * j + sd];
+            en    = 0.0f;
+            FOR (n = start; n < stop; n++)
+            {
+                en += xf[n] * xf[n];
+            }
+            IF (en == 0.0f)
+            {
+                r[0] = 1.0f;
+                FOR (lag = 1; lag <= maxOrder; lag++)
+                {
+                    r[lag] = 0.0f;
+                }
+                BREAK;
+            }
+            FOR (lag = 0; lag <= maxOrder; lag++)
+            {
+                sum = 0.0f;
+                FOR (n = start; n < stop - lag; n++)
+                {
+                    sum += xf[n] * xf[n + lag];
+                }
+                r[lag] += sum / en;
+            }
+        }
+        FOR (lag = 1; lag <= maxOrder; lag++)
+        {
+            r[lag] *= ldexpf((float)tnsAcfWindow[lag - 1], -31);
+        }
+
+        /* Levinson-Durbin */
+        e    = r[0];
+        a[0] = 1.0f;
+        FOR (k = 1; k <= maxOrder; k++)
+        {
+            sum = 0.0f;
+            FOR (i = 0; i < k; i++)
+            {
+                sum += a[i] * r[k - i];
+            }
+            k_rc = (e > 0.0f) ? -sum / e : 0.0f;
+            FOR (i = 1; i < k; i++)
+            {
+                a_tmp[i] = a[i] + k_rc * a[k - i];
+            }
+            FOR (i = 1; i < k; i++)
+            {
+                a[i] = a_tmp[i];
+            }
+            a[k]      = k_rc;
+            rc[k - 1] = k_rc;
+            e         = e * (1.0f - k_rc * k_rc);
+        }
+
+        /* prediction gain */
+        pg = (e > 0.0f) ? r[0] / e : 1.0f;
+
+        IF (pg > 1.5f)
+        {
+            IF (enable_lpc_weighting != 0 && pg < 2.0f)
+            {
+                /* LPC weighting, then back to reflection coefficients */
+                alpha = 0.85f + 0.3f * (pg - 1.5f);
+                g     = alpha;
+                FOR (i = 1; i <= maxOrder; i++)
+                {
+                    a[i] *= g;
+                    g *= alpha;
+                }
+                FOR (k = maxOrder; k >= 1; k--)
+                {
+                    k_rc      = a[k];
+                    rc[k - 1] = k_rc;
+                    FOR (i = 1; i < k; i++)
+                    {
+                        a_tmp[i] = (a[i] - a[k - i] * k_rc) / (1.0f - k_rc * k_rc);
+                    }
+                    FOR (i = 1; i < k; i++)
+                    {
+                        a[i] = a_tmp[i];
+                    }
+                }
+            }
+
+            /* reflection coefficients quantization with the fixed-point thresholds */
+            FOR (i = 0; i < maxOrder; i++)
+            {
+                RC[i] = (Word16)lrintf(fminf(fmaxf(rc[i] * 32768.0f, -32768.0f), 32767.0f));
+                idx   = 1;
+                WHILE (idx < TNS_COEF_RES && RC[i] > tnsQuantThr[idx - 1])
+                {
+                    idx++;
+                }
+                indexes[MAXLAG * j + i] = idx - 1;
+            }
+
+            /* reduce filter order by truncating trailing zeros */
+            i = maxOrder - 1;
+            WHILE (i >= 0 && indexes[MAXLAG * j + i] == INDEX_SHIFT)
+            {
+                i--;
+            }
+            order[j] = i + 1;
+
+            /* count bits */
+            tmp = ac_tns_order_bits[enable_lpc_weighting][order[j] - 1];
+            FOR (i = 0; i < order[j]; i++)
+            {
+                tmp += ac_tns_coef_bits[i][indexes[MAXLAG * j + i]];
+            }
+            *bits = add(*bits, add(2, extract_l(L_shr_pos(L_sub(tmp, 1), 11))));
+
+            FOR (i = 0; i < order[j]; i++)
+            {
+                RC[i] = tnsQuantPts[indexes[MAXLAG * j + i]];
+            }
+
+            stopfreq = xLen;
+            IF (*numfilters == 2 && j == 0)
+            {
+                stopfreq = startfreq[1];
+            }
+
+            /* lattice filter on the Word32 spectrum, as FIRLattice() */
+            FOR (n = startfreq[j]; n < stopfreq; n++)
+            {
+                xi      = x[n];
+                tmpSave = xi;
+                FOR (i = 0; i < order[j] - 1; i++)
+                {
+                    tmp      = L_add(state[i], Mpy_32_16(xi, RC[i]));
+                    xi       = L_add(xi, Mpy_32_16(state[i], RC[i]));
+                    state[i] = tmpSave;
+                    tmpSave  = tmp;
+                }
+                xi                  = L_add(xi, Mpy_32_16(state[order[j] - 1], RC[order[j] - 1]));
+                state[order[j] - 1] = tmpSave;
+                x[n]                = xi;
+            }
+        }
+        ELSE
+        {
+            /* TNS disabled */
+            *bits    = add(*bits, 1);
+            order[j] = 0;
+        }
+    }
+}
+
+void processEstimateGlobalGain_fl(Word32 x[], Word16 x_e, Word16 lg, Word16 nbitsSQ, Word16 *gain, Word16 *gain_e,
+                                  Word16 *quantizedGain, Word16 *quantizedGainMin, Word16 quantizedGainOff,
+                                  Word32 *targetBitsOff, Word16 *old_targetBits, Word16 old_specBits,
+                                  Word8 *scratchBuffer)
+{
+    int    i, iter, lg_4, iszero;
+    Word32 tmp32;
+    float *en, s, ener, x_max, target, fac, offset, tmp;
+
+    en = (float *)scratchAlign(scratchBuffer, 0); /* Size = MAX_LEN */
+
+    /* bit budget offset tracking, unchanged from processEstimateGlobalGain_fx() */
+    IF (*old_targetBits < 0)
+    {
+        *targetBitsOff = 0;
+    }
+    ELSE
+    {
+        tmp32          = L_add(*targetBitsOff, L_deposit_h(sub(*old_targetBits, old_specBits)));
+        tmp32          = L_min((40 << 16), L_max(-(40 << 16), tmp32));
+        *targetBitsOff = L_add(Mpy_32_16(*targetBitsOff, 26214), Mpy_32_16(tmp32, 6554));
+    }
+    *old_targetBits = nbitsSQ;
+    nbitsSQ         = add(nbitsSQ, round_fx(*targetBitsOff));
+
+    /* energy of quadruples with 9dB offset, (28/20)*(7+10*log10(e)) */
+    lg_4  = lg >> 2;
+    s     = fl_scale(x_e);
+    x_max = 0.0f;
+    FOR (i = 0; i < lg_4; i++)
+    {
+        float x0 = x[4 * i] * s, x1 = x[4 * i + 1] * s, x2 = x[4 * i + 2] * s, x3 = x[4 * i + 3] * s;
+        x_max = fmaxf(x_max, fmaxf(fmaxf(fabsf(x0), fabsf(x1)), fmaxf(fabsf(x2), fabsf(x3))));
+        ener  = x0 * x0 + x1 * x1 + x2 * x2 + x3 * x3 + ldexpf(1.0f, -31);
+        en[i] = 1.4f * (7.0f + 10.0f * log10f(ener));
+    }
+
+    IF (x_max == 0.0f)
+    {
+        *quantizedGainMin = quantizedGainOff;
+        *quantizedGain    = 0;
+        *old_targetBits   = -1;
+    }
+    ELSE
+    {
+        /* minimum gain */
+        tmp               = floorf(28.0f * log10f(x_max / (32768.0f - 0.375f)) + 1.0f + 1.0f / 1024.0f);
+        *quantizedGainMin = (Word16)s_max(quantizedGainOff, s_min(add(255, quantizedGainOff), (Word16)tmp));
+
+        /* SQ scale: 4 bits / 6 dB per quadruple, find offset by bisection */
+        target = 1.96f * nbitsSQ;
+        fac    = 256.0f;
+        offset = (float)(255 + quantizedGainOff);
+        FOR (iter = 0; iter < 8; iter++)
+        {
+            fac    = fac * 0.5f;
+            offset = offset - fac;
+            ener   = 0.0f;
+            iszero = 1;
+            FOR (i = lg_4 - 1; i >= 0; i--)
+            {
+                tmp = en[i] - offset;
+                IF (tmp < 9.8f)
+                {
+                    if (iszero == 0)
+                        ener += 3.78f;
+                }
+                ELSE
+                {
+                    ener += tmp;
+                    iszero = 0;
+                }
+                if (tmp >= 70.0f)
+                    ener += tmp - 70.0f;
+            }
+            if (ener > target && iszero == 0)
+            {
+                offset = offset + fac;
+            }
+        }
+
+        tmp = floorf(offset);
+        if ((Word16)tmp < *quantizedGainMin)
+        {
+            *old_targetBits = -1;
+        }
+        *quantizedGain = sub(s_max(*quantizedGainMin, (Word16)tmp), quantizedGainOff);
+    }
+
+    tmp32   = L_shl_pos(L_mult0(add(*quantizedGain, quantizedGainOff), 0x797D), 7);
+    *gain_e = add(extract_l(L_shr_pos(tmp32, 25)), 1);
+    *gain   = round_fx(BASOP_Util_InvLog2(L_or(tmp32, 0xFE000000)));
+}
+
+#endif /* LC3_FLOAT_ANALYSIS */
@@ -25,7 +25,7 @@ void processEncoderEntropy(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wo
     Word16  submode_LSB, submode_MSB, gain_MSBs;
     Word32  L_gain_LSB;
     Counter n;
-    UWord8 *ptr;
+    Bitstream_Backward bs;
 
     Word16  lastnzTrigger[5] = {63, 127, 127, 255, 255};
 
@@ -37,7 +37,7 @@ void processEncoderEntropy(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wo
         Word16  submode_LSB, submode_MSB, gain_MSBs;
         Word32  L_gain_LSB;
         Counter n;
-        UWord8 *ptr;
+        Bitstream_Backward bs;
         Word16  lastnzTrigger[5];
     };
     Dyn_Mem_In("processEncoderEntropy", sizeof(struct _dynmem));
@@ -46,14 +46,14 @@ void processEncoderEntropy(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wo
     /* Init */
     *bp_side   = shr_pos(sub(nbbits, 1), 3);
     *mask_side = shl(1, sub(8, sub(nbbits, shl_pos(*bp_side, 3))));
-    ptr        = bytes;
 
     basop_memset(bytes, 0, targetBytes * sizeof(*bytes));
+    bs_write_init(&bs, bytes, *bp_side, *mask_side);
 
     /* Cutoff-detection */
     IF (BW_cutoff_bits > 0)
     {
-        write_indice_backward(ptr, bp_side, mask_side, BW_cutoff_idx, BW_cutoff_bits);
+        bs_write(&bs, BW_cutoff_idx, BW_cutoff_bits);
     }
 
     /* Encode last non-zero tuple */
@@ -61,35 +61,35 @@ void processEncoderEntropy(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wo
 
     IF (sub(bfi_ext, 1) == 0)
     {
-        write_indice_backward(ptr, bp_side, mask_side, lastnzTrigger[fs_idx], tmp);
+        bs_write(&bs, lastnzTrigger[fs_idx], tmp);
     }
     ELSE
     {
-        write_indice_backward(ptr, bp_side, mask_side, sub(shr_pos(lastnz, 1), 1), tmp);
+        bs_write(&bs, sub(shr_pos(lastnz, 1), 1), tmp);
     }
 
     /* Mode bit */
-    write_bit_backward(ptr, bp_side, mask_side, lsbMode);
+    bs_write(&bs, lsbMode, 1);
 
     /* Encode global-gain */
-    write_indice_backward(ptr, bp_side, mask_side, gg_idx, 8);
+    bs_write(&bs, gg_idx, 8);
 
     /* TNS on/off flag */
     FOR (n = 0; n < tns_numfilters; n++)
     {
-        write_bit_backward(ptr, bp_side, mask_side, s_min(tns_order[n], 1));
+        bs_write(&bs, s_min(tns_order[n], 1), 1);
     }
 
     /* LTPF on/off*/
-    write_indice_backward(ptr, bp_side, mask_side, ltpf_idx[0], 1);
+    bs_write(&bs, ltpf_idx[0], 1);
 
     /* Encode SCF VQ parameters - 1st stage (10 bits) */
-    write_indice_backward(ptr, bp_side, mask_side, extract_l(L_scf_idx[0]), 5); /* stage1 LF   5 bits */
-    write_indice_backward(ptr, bp_side, mask_side, extract_l(L_scf_idx[1]), 5); /* stage1 HF   5  bits  */
+    bs_write(&bs, extract_l(L_scf_idx[0]), 5); /* stage1 LF   5 bits */
+    bs_write(&bs, extract_l(L_scf_idx[1]), 5); /* stage1 HF   5  bits  */
 
     /* Encode SCF VQ parameters - 2nd stage side-info (3-4 bits) */
     submode_MSB = shr_pos(extract_l(L_scf_idx[2]), 1);        /*  explicit tx */
-    write_bit_backward(ptr, bp_side, mask_side, submode_MSB); /* submode MSB  1 explicit bit */
+    bs_write(&bs, submode_MSB, 1);                            /* submode MSB  1 explicit bit */
     submode_LSB = s_and(extract_l(L_scf_idx[2]), 0x1);        /* for joint coding with shapeCw */
     gain_MSBs   = extract_l(L_scf_idx[3]);                    /* all gain bits */
     L_gain_LSB  = L_and(L_scf_idx[3], 0x1L);
@@ -97,9 +97,8 @@ void processEncoderEntropy(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wo
 
     ASSERT(gain_MSBs >= 0 && gain_MSBs < (1 << sns_gainMSBbits[L_scf_idx[2]])); /* ASSERT  max 2 MSB(s) in gain bits */
 
-    write_indice_backward(ptr, bp_side, mask_side, gain_MSBs,
-                          sns_gainMSBbits[L_scf_idx[2]]);                 /* adjgain or MSBs of adjGains   1-2 bits  */
-    write_bit_backward(ptr, bp_side, mask_side, extract_l(L_scf_idx[4])); /*  shape  LS 1 bit */
+    bs_write(&bs, gain_MSBs, sns_gainMSBbits[L_scf_idx[2]]); /* adjgain or MSBs of adjGains   1-2 bits  */
+    bs_write(&bs, extract_l(L_scf_idx[4]), 1);               /*  shape  LS 1 bit */
 
     /* Encode SCF VQ parameters - 2nd stage data (24-25 bits) */
     IF (submode_MSB == 0)
@@ -118,8 +117,8 @@ void processEncoderEntropy(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wo
                                      L_scf_idx[5] /* shapeA */, L_tmp /*   shapeB joint with adjGainLSB */);
         /* regular mode  mode shape  index   total  1+23.9999 bits    MPVQ codeword  */
         ASSERT(L_tmp < (1L << 25));
-        write_indice_backward(ptr, bp_side, mask_side, extract_l(L_tmp), 13);                /*  multiplex 13  bits  */
-        write_indice_backward(ptr, bp_side, mask_side, extract_l(L_shr_pos(L_tmp, 13)), 12); /* multiplex 12 bits  */
+        bs_write(&bs, extract_l(L_tmp), 13);                /*  multiplex 13  bits  */
+        bs_write(&bs, extract_l(L_shr_pos(L_tmp, 13)), 12); /* multiplex 12 bits  */
     }
     ELSE
     { /* outlier near, outlier far */
@@ -133,19 +132,21 @@ void processEncoderEntropy(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Wo
 
         ASSERT(L_tmp < (1L << 24));
         /* outlier mode shape  index   total  23.8536 ( +  ~.14 ) bits as   MPVQ codeword  */
-        write_indice_backward(ptr, bp_side, mask_side, extract_l(L_tmp), 12);            /*  multiplex 12  bits  LSB*/
-        write_indice_backward(ptr, bp_side, mask_side, extract_l(L_shr(L_tmp, 12)), 12); /* multiplex 12 bits  MSBs */
+        bs_write(&bs, extract_l(L_tmp), 12);            /*  multiplex 12  bits  LSB*/
+        bs_write(&bs, extract_l(L_shr(L_tmp, 12)), 12); /* multiplex 12 bits  MSBs */
     }
 
     /* LTPF data */
     IF (ltpf_idx[0] != 0)
     {
-        write_indice_backward(ptr, bp_side, mask_side, ltpf_idx[1], 1);
-        write_indice_backward(ptr, bp_side, mask_side, ltpf_idx[2], 9);
+        bs_write(&bs, ltpf_idx[1], 1);
+        bs_write(&bs, ltpf_idx[2], 9);
     }
 
     /* Encoder noise-fac */
-    write_indice_backward(ptr, bp_side, mask_side, fac_ns_idx, 3);
+    bs_write(&bs, fac_ns_idx, 3);
+
+    bs_write_finish(&bs, bp_side, mask_side);
 
 #ifdef DYNMEM_COUNT
     Dyn_Mem_Out();
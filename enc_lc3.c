@@ -11,22 +11,198 @@
 #include "functions.h"
 
 
-static void Enc_LC3_Channel(LC3_Enc *encoder, int channel, int bits_per_sample, Word32 *s_in, UWord8 *bytes,
-                            Word8 *scratchBuffer, int bfi_ext)
+/* quantization and entropy coding of the shaped and TNS filtered spectrum */
+void Enc_LC3_CodeSpectrum(LC3_Enc *encoder, EncSetup *h_EncSetup, Word32 *d_fx, Word16 d_fx_exp, Word16 BW_cutoff_idx,
+                          Word16 tns_numfilters, Word16 *tns_order, Word16 *indexes, Word16 *ltpf_idx, Word16 ltpf_bits,
+                          Word32 *L_scf_idx, UWord8 *bytes, Word8 *scratchBuffer, int bfi_ext)
+{
+    Dyn_Mem_Deluxe_In(
+        Word16  gain_e, gain, quantizedGain, quantizedGainMin;
+        Word16  lsbMode, lastnz;
+        Word16  gainChange, fac_ns_idx;
+        Word16  nBits, numResBits;
+        Word16  bp_side, mask_side;
+        //Word16 b_left;
+        Word16 *q_d_fx16, *codingdata;
+        Word8 * resBits;
+        Word8 * currentScratch;
+    );
+
+    q_d_fx16 = scratchAlign(scratchBuffer, 0); /* Size = 2 * MAX_LEN bytes */
+    codingdata =
+        scratchAlign(q_d_fx16, sizeof(*q_d_fx16) * s_max(80, encoder->frame_length)); /* Size = 3 * MAX_LEN bytes */
+    resBits = scratchAlign(codingdata,
+                           sizeof(*codingdata) * (3 * s_max(80, encoder->frame_length) / 2)); /* Size = MAX_LEN bytes */
+    currentScratch =
+        scratchAlign(resBits, sizeof(*resBits) * s_max(80, encoder->frame_length)); /* Size = 4 * MAX_LEN */
+
+    BASOP_sub_start("Est. Global Gain");
+    /* currentScratch Size = 4 * MAX_LEN bytes */
+    h_EncSetup->targetBitsQuant = sub(h_EncSetup->targetBitsInit, add(h_EncSetup->tns_bits, ltpf_bits));
+#ifdef LC3_FLOAT_ANALYSIS
+    processEstimateGlobalGain_fl(d_fx, d_fx_exp, encoder->yLen, h_EncSetup->targetBitsQuant, &gain, &gain_e,
+                                 &quantizedGain, &quantizedGainMin, h_EncSetup->quantizedGainOff,
+                                 &h_EncSetup->targetBitsOff, &h_EncSetup->mem_targetBits, h_EncSetup->mem_specBits,
+                                 currentScratch);
+#else
+    processEstimateGlobalGain_fx(d_fx, d_fx_exp, encoder->yLen, h_EncSetup->targetBitsQuant, &gain, &gain_e,
+                                 &quantizedGain, &quantizedGainMin, h_EncSetup->quantizedGainOff,
+                                 &h_EncSetup->targetBitsOff, &h_EncSetup->mem_targetBits, h_EncSetup->mem_specBits,
+                                 currentScratch);
+#endif
+    BASOP_sub_end();
+    /* begin q_d_fx16 */
+
+    BASOP_sub_start("Quant. 1");
+    processQuantizeSpec_fx(d_fx, d_fx_exp, gain, gain_e, q_d_fx16, encoder->yLen, h_EncSetup->targetBitsQuant,
+                           h_EncSetup->targetBitsAri, &h_EncSetup->mem_specBits, &nBits, encoder->fs_idx, &lastnz,
+                           codingdata, &lsbMode, -1);
+    BASOP_sub_end();
+
+    BASOP_sub_start("Adj. Global Gain");
+    processAdjustGlobalGain_fx(&quantizedGain, quantizedGainMin, h_EncSetup->quantizedGainOff, &gain, &gain_e,
+                               h_EncSetup->targetBitsQuant, h_EncSetup->mem_specBits, &gainChange, encoder->fs_idx);
+    BASOP_sub_end();
+
+    BASOP_sub_start("Quant. 2");
+    IF (sub(gainChange, 1) == 0)
+    {
+        processQuantizeSpec_fx(d_fx, d_fx_exp, gain, gain_e, q_d_fx16, encoder->yLen, h_EncSetup->targetBitsQuant,
+                               h_EncSetup->targetBitsAri, NULL, &nBits, encoder->fs_idx, &lastnz, codingdata, &lsbMode,
+                               0);
+    }
+    BASOP_sub_end();
+
+    BASOP_sub_start("Res. Cod.");
+    IF (lsbMode == 0)
+    {
+        processResidualCoding_fx(d_fx_exp, d_fx, q_d_fx16, gain, gain_e, encoder->yLen, h_EncSetup->targetBitsQuant,
+                                 nBits, resBits, &numResBits);
+    }
+    ELSE
+    {
+        numResBits = 0; 
+    }
+    BASOP_sub_end();
+
+    BASOP_sub_start("Noise fac");
+    /* currentScratch Size = 2 * MAX_LEN bytes */
+#ifdef NONBE_LOW_BR_NF_TUNING
+    processNoiseFactor_fx(&fac_ns_idx, d_fx_exp, d_fx, q_d_fx16, gain, gain_e, BW_cutoff_idx, encoder->frame_dms,
+                          h_EncSetup->targetBytes, currentScratch);
+#else
+    processNoiseFactor_fx(&fac_ns_idx, d_fx_exp, d_fx, q_d_fx16, gain, gain_e, BW_cutoff_idx, encoder->frame_dms,
+                          currentScratch);
+#endif
+    BASOP_sub_end();
+
+    BASOP_sub_start("Entropy cod");
+    processEncoderEntropy(bytes, &bp_side, &mask_side, h_EncSetup->targetBitsAri, h_EncSetup->targetBytes,
+                          encoder->yLen, encoder->BW_cutoff_bits, tns_numfilters, lsbMode, lastnz,
+                          tns_order, fac_ns_idx, quantizedGain, BW_cutoff_idx, ltpf_idx, L_scf_idx, bfi_ext,
+                          encoder->fs_idx);
+    BASOP_sub_end();
+
+    BASOP_sub_start("Ari cod");
+    processAriEncoder_fx(bytes, bp_side, mask_side, h_EncSetup->targetBitsAri, q_d_fx16, tns_order, tns_numfilters,
+                         indexes, lastnz, codingdata, resBits, numResBits, lsbMode, h_EncSetup->enable_lpc_weighting,
+                         currentScratch);
+    BASOP_sub_end();
+
+    BASOP_sub_start("Reorder Bitstream Enc");
+    test();
+    IF (encoder->combined_channel_coding == 0 && h_EncSetup->n_pc > 0)
+    {
+		printf("Reorder Ari dec\n");
+        //BASOP_sub_start("Reorder Ari dec");
+        //processAriDecoder_fx(bytes, &bp_side, &mask_side, h_EncSetup->total_bits, encoder->yLen, encoder->fs_idx,
+        //                     h_EncSetup->enable_lpc_weighting, tns_numfilters, lsbMode, lastnz, &gain, tns_order,
+        //                     fac_ns_idx, quantizedGain, encoder->frame_dms,
+        //                     h_EncSetup->n_pc, 0, shr_pos(h_EncSetup->total_bits,3), 1, &gain, &b_left,
+        //                     &gain, codingdata, &gain, (Word16*)resBits, indexes, &gain, currentScratch);
+        //BASOP_sub_end(); /* Ari dec */
+        //processReorderBitstream_fx(bytes, h_EncSetup->n_pccw, h_EncSetup->n_pc, b_left, currentScratch);
+    }
+    BASOP_sub_end();
+
+    /* end q_d_fx16 */
+    Dyn_Mem_Deluxe_Out();
+}
+
+/* memories of the encoder besides the delay lines. The resampler high pass settles to a small limit cycle */
+typedef struct
+{
+    Word32 r12k8_mem_50[2];
+    Word32 targetBitsOff, attdec_acc_energy;
+    Word16 mem_targetBits, mem_specBits;
+    Word16 olpa_mem_s6k4_exp, olpa_mem_pitch;
+    Word16 ltpf_mem_in_exp, ltpf_mem_normcorr, ltpf_mem_mem_normcorr, ltpf_mem_ltpf_on, ltpf_mem_pitch;
+    Word16 attdec_filter_mem[2], attdec_detected, attdec_position, attdec_scaling;
+} EncScalarMem;
+
+static void enc_scalar_mem(const EncSetup *h_EncSetup, EncScalarMem *mem)
+{
+    basop_memset(mem, 0, sizeof(*mem)); /* compared with memcmp() */
+    mem->r12k8_mem_50[0]       = h_EncSetup->r12k8_mem_50[0];
+    mem->r12k8_mem_50[1]       = h_EncSetup->r12k8_mem_50[1];
+    mem->targetBitsOff         = h_EncSetup->targetBitsOff;
+    mem->attdec_acc_energy     = h_EncSetup->attdec_acc_energy;
+    mem->mem_targetBits        = h_EncSetup->mem_targetBits;
+    mem->mem_specBits          = h_EncSetup->mem_specBits;
+    mem->olpa_mem_s6k4_exp     = h_EncSetup->olpa_mem_s6k4_exp;
+    mem->olpa_mem_pitch        = h_EncSetup->olpa_mem_pitch;
+    mem->ltpf_mem_in_exp       = h_EncSetup->ltpf_mem_in_exp;
+    mem->ltpf_mem_normcorr     = h_EncSetup->ltpf_mem_normcorr;
+    mem->ltpf_mem_mem_normcorr = h_EncSetup->ltpf_mem_mem_normcorr;
+    mem->ltpf_mem_ltpf_on      = h_EncSetup->ltpf_mem_ltpf_on;
+    mem->ltpf_mem_pitch        = h_EncSetup->ltpf_mem_pitch;
+    mem->attdec_filter_mem[0]  = h_EncSetup->attdec_filter_mem[0];
+    mem->attdec_filter_mem[1]  = h_EncSetup->attdec_filter_mem[1];
+    mem->attdec_detected       = h_EncSetup->attdec_detected;
+    mem->attdec_position       = h_EncSetup->attdec_position;
+    mem->attdec_scaling        = h_EncSetup->attdec_scaling;
+}
+
+static Word16 enc_zero16(const Word16 *x, Word16 len)
+{
+    Counter i;
+
+    FOR (i = 0; i < len; i++)
+    {
+        IF (x[i] != 0)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* delay lines of MDCT, resampler, OLPA and LTPF. Fed with zeros they only stay unchanged if they are zero */
+static Word16 enc_delay_lines_zero(const LC3_Enc *encoder, const EncSetup *h_EncSetup)
+{
+    test(); test(); test(); test(); test();
+    return enc_zero16(h_EncSetup->stEnc_mdct_mem, encoder->stEnc_mdct_mem_len) &&
+           enc_zero16(h_EncSetup->r12k8_mem_in, encoder->r12k8_mem_in_len) &&
+           enc_zero16(h_EncSetup->r12k8_mem_out, encoder->r12k8_mem_out_len) &&
+           enc_zero16(h_EncSetup->olpa_mem_s12k8, 3) &&
+           enc_zero16(h_EncSetup->olpa_mem_s6k4, LEN_6K4 + MAX_PITCH_6K4) &&
+           enc_zero16(h_EncSetup->ltpf_mem_in, encoder->ltpf_mem_in_len);
+}
+
+/* spec_exp != NULL: s_in is the Word32 MDCT spectrum of the frame instead of PCM */
+static void Enc_LC3_Channel(LC3_Enc *encoder, int channel, int bits_per_sample, Word32 *s_in, const Word16 *spec_exp,
+                            UWord8 *bytes, Word8 *scratchBuffer, int bfi_ext)
 {
     Dyn_Mem_Deluxe_In(
         Word16 d_fx_exp;
-        Word16 gain_e, gain, quantizedGain, quantizedGainMin;
         Word16 ener_fx_exp;
         Word16 pitch, normcorr;
         Word16 ltpf_bits;
         Word16 tns_numfilters;
-        Word16 lsbMode, lastnz, BW_cutoff_idx;
-        Word16 gainChange, fac_ns_idx;
-        Word16 nBits, numResBits;
-        Word16 bp_side, mask_side;
+        Word16 BW_cutoff_idx;
         Word16 s_12k8_len;
-        //Word16 b_left;
+        Word16 rest;
+        EncScalarMem rest_mem, mem;
         
         Word32 *  L_scf_idx;
         Word32 *  d_fx, *ener_fx;
@@ -69,47 +245,109 @@ static void Enc_LC3_Channel(LC3_Enc *encoder, int channel, int bits_per_sample,
     int_scf_fx_exp =
         scratchAlign(int_scf_fx, sizeof(*int_scf_fx) * MAX_BANDS_NUMBER); /* Size = 2 * MAX_BANDS_NUMBER = 128 bytes */
 
-    /* Scale 24-bit input data 16bit input only */
-    memcpy(s_in_scaled, s_in, encoder->frame_length * sizeof(*s_in_scaled));
-
-    BASOP_sub_start("Mdct");
-    /* currentScratch Size = 4 * MAX_LEN */
-    processMdct_fx(encoder, s_in_scaled, h_EncSetup->stEnc_mdct_mem, d_fx, &d_fx_exp, currentScratch);
-    BASOP_sub_end();
+    rest = 0;
+    IF (spec_exp != NULL)
+    {
+        /* the time domain tools do not run, the MDCT restarts from silence if PCM input follows */
+        BASOP_sub_start("Spectrum input");
+        processSpectrumInput_fx(s_in, *spec_exp, d_fx, &d_fx_exp, encoder->frame_length);
+        basop_memset(h_EncSetup->stEnc_mdct_mem, 0, encoder->stEnc_mdct_mem_len * sizeof(*h_EncSetup->stEnc_mdct_mem));
+        BASOP_sub_end();
+    }
+    ELSE
+    {
+        /* Scale 24-bit input data 16bit input only */
+        memcpy(s_in_scaled, s_in, encoder->frame_length * sizeof(*s_in_scaled));
 
-    /* begin s_12k8 */
-    BASOP_sub_start("Resamp12k8");
-    /* currentScratch Size = 2.25 * MAX_LEN bytes */
-    process_resamp12k8_fx(s_in_scaled, encoder->frame_length, h_EncSetup->r12k8_mem_in, encoder->r12k8_mem_in_len,
-                          h_EncSetup->r12k8_mem_50, h_EncSetup->r12k8_mem_out, encoder->r12k8_mem_out_len, s_12k8,
-                          &s_12k8_len, /*encoder->fs_idx,*/ encoder->frame_dms, currentScratch);
-    BASOP_sub_end();
+        BASOP_sub_start("Silence");
+        test(); test();
+        IF (bfi_ext == 0 && encoder->silence_cache != NULL && enc_zero16(s_in_scaled, encoder->frame_length))
+        {
+            IF (sub(h_EncSetup->silence_bytes, h_EncSetup->targetBytes) == 0)
+            {
+                /* the state is at rest, see below */
+                basop_memcpy(bytes, &encoder->silence_cache[channel * MAX_NBYTES], h_EncSetup->targetBytes);
+                BASOP_sub_end();
+                BASOP_sub_end(); /* Encoder */
+                Dyn_Mem_Deluxe_Out();
+                return;
+            }
+            rest = enc_delay_lines_zero(encoder, h_EncSetup);
+            IF (rest)
+            {
+                enc_scalar_mem(h_EncSetup, &rest_mem);
+            }
+        }
+        BASOP_sub_end();
 
-    BASOP_sub_start("Olpa");
-    /* currentScratch Size = 392 bytes */
-    process_olpa_fx(&h_EncSetup->olpa_mem_s6k4_exp, h_EncSetup->olpa_mem_s12k8, h_EncSetup->olpa_mem_s6k4, &pitch,
-                    s_12k8, s_12k8_len, &normcorr, &h_EncSetup->olpa_mem_pitch, currentScratch);
-    BASOP_sub_end();
+        BASOP_sub_start("Mdct");
+        /* currentScratch Size = 4 * MAX_LEN + LC3_SCRATCH_ALIGN */
+#ifdef LC3_FLOAT_ANALYSIS
+        /* currentScratch Size = 16 * MAX_LEN */
+        processMdct_fl(encoder, s_in_scaled, h_EncSetup->stEnc_mdct_mem, d_fx, &d_fx_exp, currentScratch);
+#else
+        processMdct_fx(encoder, s_in_scaled, h_EncSetup->stEnc_mdct_mem, d_fx, &d_fx_exp, currentScratch);
+#endif
+        BASOP_sub_end();
+    }
 
-    BASOP_sub_start("LtpfEnc");
-    /* currentScratch Size = 512 bytes */
-    process_ltpf_coder_fx(&ltpf_bits, pitch, h_EncSetup->ltpf_enable, &h_EncSetup->ltpf_mem_in_exp,
-                          h_EncSetup->ltpf_mem_in, encoder->ltpf_mem_in_len, ltpf_idx, s_12k8, s_12k8_len,
-                          &h_EncSetup->ltpf_mem_normcorr, &h_EncSetup->ltpf_mem_mem_normcorr, normcorr,
-                          &h_EncSetup->ltpf_mem_ltpf_on, &h_EncSetup->ltpf_mem_pitch, 
-                          encoder->frame_dms, currentScratch);
-    BASOP_sub_end();
+    /* begin s_12k8 */
+    IF (sub(encoder->complexity, LC3_ENC_COMPLEXITY_MINIMAL) < 0 && spec_exp == NULL)
+    {
+        BASOP_sub_start("Resamp12k8");
+        /* currentScratch Size = 2.25 * MAX_LEN bytes */
+        process_resamp12k8_fx(s_in_scaled, encoder->frame_length, h_EncSetup->r12k8_mem_in, encoder->r12k8_mem_in_len,
+                              h_EncSetup->r12k8_mem_50, h_EncSetup->r12k8_mem_out, encoder->r12k8_mem_out_len, s_12k8,
+                              &s_12k8_len, /*encoder->fs_idx,*/ encoder->frame_dms, currentScratch);
+        BASOP_sub_end();
+
+        BASOP_sub_start("Olpa");
+        /* currentScratch Size = 392 bytes */
+        process_olpa_fx(&h_EncSetup->olpa_mem_s6k4_exp, h_EncSetup->olpa_mem_s12k8, h_EncSetup->olpa_mem_s6k4, &pitch,
+                        s_12k8, s_12k8_len, &normcorr, &h_EncSetup->olpa_mem_pitch, currentScratch);
+        BASOP_sub_end();
+
+        BASOP_sub_start("LtpfEnc");
+        /* currentScratch Size = 512 bytes */
+        process_ltpf_coder_fx(&ltpf_bits, pitch, h_EncSetup->ltpf_enable, &h_EncSetup->ltpf_mem_in_exp,
+                              h_EncSetup->ltpf_mem_in, encoder->ltpf_mem_in_len, ltpf_idx, s_12k8, s_12k8_len,
+                              &h_EncSetup->ltpf_mem_normcorr, &h_EncSetup->ltpf_mem_mem_normcorr, normcorr,
+                              &h_EncSetup->ltpf_mem_ltpf_on, &h_EncSetup->ltpf_mem_pitch, 
+                              encoder->frame_dms, currentScratch);
+        BASOP_sub_end();
+
+        BASOP_sub_start("AttackDetector");
+        attack_detector_fx(h_EncSetup, s_12k8, s_12k8_len);
+        BASOP_sub_end();
+    }
+    ELSE
+    {
+        /* no pitch analysis or no time signal, signal LTPF inactive as done for unvoiced frames */
+        ltpf_idx[0] = 0;
+        ltpf_idx[1] = 0;
+        ltpf_idx[2] = 0;
+        ltpf_bits   = 1;
+
+        h_EncSetup->ltpf_mem_mem_normcorr = h_EncSetup->ltpf_mem_normcorr;
+        h_EncSetup->ltpf_mem_normcorr     = 0;
+        h_EncSetup->ltpf_mem_ltpf_on      = 0;
+        h_EncSetup->ltpf_mem_pitch        = 0;
+
+        /* the attack detector runs on s_12k8 */
+        h_EncSetup->attdec_detected = 0;
+    }
 
     /* end s_12k8 */
-    BASOP_sub_start("AttackDetector");
-    /* currentScratch Size = ??? bytes */
-    //attack_detector_fx(encoder, h_EncSetup, s_in_scaled, sub(h_EncSetup->x_exp, 15), currentScratch);
-    BASOP_sub_end();
     /* begin ener_fx */
     BASOP_sub_start("PerBandEnergy");
     /* currentScratch Size = 160 bytes */
-    processPerBandEnergy_fx(ener_fx, &ener_fx_exp, d_fx, d_fx_exp, encoder->bands_offset, encoder->fs_idx,
+#ifdef LC3_FLOAT_ANALYSIS
+    processPerBandEnergy_fl(ener_fx, &ener_fx_exp, d_fx, d_fx_exp, encoder->bands_offset, encoder->fs_idx,
                             encoder->bands_number, 0, encoder->frame_dms, currentScratch);
+#else
+    encoder->kernels->per_band_energy(ener_fx, &ener_fx_exp, d_fx, d_fx_exp, encoder->bands_offset, encoder->fs_idx,
+                                      encoder->bands_number, 0, encoder->frame_dms, currentScratch);
+#endif
     BASOP_sub_end();
 
     BASOP_sub_start("BW Cutoff-Detection");
@@ -126,8 +364,13 @@ static void Enc_LC3_Channel(LC3_Enc *encoder, int channel, int bits_per_sample,
 
     BASOP_sub_start("SnsCompScf");
     /* currentScratch Size = 512 bytes */
+#ifdef LC3_FLOAT_ANALYSIS
+    processSnsComputeScf_fl(ener_fx, ener_fx_exp, encoder->fs_idx, encoder->bands_number, scf,
+                            h_EncSetup->attdec_detected, currentScratch);
+#else
     processSnsComputeScf_fx(ener_fx, ener_fx_exp, encoder->fs_idx, encoder->bands_number, scf,
                             h_EncSetup->attdec_detected, currentScratch);
+#endif
     BASOP_sub_end();
 
     BASOP_sub_start("SnsQuantScfEnc");
@@ -137,11 +380,11 @@ static void Enc_LC3_Channel(LC3_Enc *encoder, int channel, int bits_per_sample,
 
     BASOP_sub_start("SnsInterpScfEnc");
     /* currentScratch Size = 128 bytes */
-    processSnsInterpolateScf_fx(scf_q, int_scf_fx, int_scf_fx_exp, 1, encoder->bands_number, currentScratch);
+    encoder->kernels->sns_interpolate_scf(scf_q, int_scf_fx, int_scf_fx_exp, 1, encoder->bands_number, currentScratch);
     BASOP_sub_end();
 
     BASOP_sub_start("Mdct shaping_enc");
-    processMdctShaping_fx(d_fx, int_scf_fx, int_scf_fx_exp, encoder->bands_offset, encoder->bands_number);
+    encoder->kernels->mdct_shaping(d_fx, int_scf_fx, int_scf_fx_exp, encoder->bands_offset, encoder->bands_number);
     BASOP_sub_end();
     /* end int_scf_fx_exp */
     BASOP_sub_start("BandwidthControl_enc");
@@ -151,102 +394,66 @@ static void Enc_LC3_Channel(LC3_Enc *encoder, int channel, int bits_per_sample,
     //}
     BASOP_sub_end();    
     BASOP_sub_start("Tns_enc");
-    /* currentScratch Size = 2 * MAX_LEN + 220 */
-    processTnsCoder_fx(&(h_EncSetup->tns_bits), indexes, d_fx, BW_cutoff_idx, tns_order, &tns_numfilters,
-                       h_EncSetup->enable_lpc_weighting, encoder->nSubdivisions, encoder->frame_dms,
-                       encoder->frame_length, currentScratch);
-    BASOP_sub_end();
-
-    BASOP_sub_start("Est. Global Gain");
-    /* currentScratch Size = 4 * MAX_LEN bytes */
-    h_EncSetup->targetBitsQuant = sub(h_EncSetup->targetBitsInit, add(h_EncSetup->tns_bits, ltpf_bits));
-    processEstimateGlobalGain_fx(d_fx, d_fx_exp, encoder->yLen, h_EncSetup->targetBitsQuant, &gain, &gain_e,
-                                 &quantizedGain, &quantizedGainMin, h_EncSetup->quantizedGainOff,
-                                 &h_EncSetup->targetBitsOff, &h_EncSetup->mem_targetBits, h_EncSetup->mem_specBits,
-                                 currentScratch);
-    BASOP_sub_end();
-    /* begin q_d_fx16 */
-
-    BASOP_sub_start("Quant. 1");
-    processQuantizeSpec_fx(d_fx, d_fx_exp, gain, gain_e, q_d_fx16, encoder->yLen, h_EncSetup->targetBitsQuant,
-                           h_EncSetup->targetBitsAri, &h_EncSetup->mem_specBits, &nBits, encoder->fs_idx, &lastnz,
-                           codingdata, &lsbMode, -1);
-    BASOP_sub_end();
-
-    BASOP_sub_start("Adj. Global Gain");
-    processAdjustGlobalGain_fx(&quantizedGain, quantizedGainMin, h_EncSetup->quantizedGainOff, &gain, &gain_e,
-                               h_EncSetup->targetBitsQuant, h_EncSetup->mem_specBits, &gainChange, encoder->fs_idx);
-    BASOP_sub_end();
-
-    BASOP_sub_start("Quant. 2");
-    IF (sub(gainChange, 1) == 0)
-    {
-        processQuantizeSpec_fx(d_fx, d_fx_exp, gain, gain_e, q_d_fx16, encoder->yLen, h_EncSetup->targetBitsQuant,
-                               h_EncSetup->targetBitsAri, NULL, &nBits, encoder->fs_idx, &lastnz, codingdata, &lsbMode,
-                               0);
-    }
-    BASOP_sub_end();
-
-    BASOP_sub_start("Res. Cod.");
-    IF (lsbMode == 0)
+    IF (sub(encoder->complexity, LC3_ENC_COMPLEXITY_LOW) < 0)
     {
-        processResidualCoding_fx(d_fx_exp, d_fx, q_d_fx16, gain, gain_e, encoder->yLen, h_EncSetup->targetBitsQuant,
-                                 nBits, resBits, &numResBits);
+        /* currentScratch Size = 2 * MAX_LEN + 220 */
+#ifdef LC3_FLOAT_ANALYSIS
+        processTnsCoder_fl(&(h_EncSetup->tns_bits), indexes, d_fx, BW_cutoff_idx, tns_order, &tns_numfilters,
+                           h_EncSetup->enable_lpc_weighting, encoder->nSubdivisions, encoder->frame_dms,
+                           encoder->frame_length, currentScratch);
+#else
+        encoder->kernels->tns_coder(&(h_EncSetup->tns_bits), indexes, d_fx, BW_cutoff_idx, tns_order, &tns_numfilters,
+                                    h_EncSetup->enable_lpc_weighting, encoder->nSubdivisions, encoder->frame_dms,
+                                    encoder->frame_length, currentScratch);
+#endif
     }
     ELSE
     {
-        numResBits = 0; 
-    }
-    BASOP_sub_end();
-
-    BASOP_sub_start("Noise fac");
-    /* currentScratch Size = 2 * MAX_LEN bytes */
-#ifdef NONBE_LOW_BR_NF_TUNING
-    processNoiseFactor_fx(&fac_ns_idx, d_fx_exp, d_fx, q_d_fx16, gain, gain_e, BW_cutoff_idx, encoder->frame_dms,
-                          h_EncSetup->targetBytes, currentScratch);
+        /* all filters disabled, same filter count as processTnsCoder_fx() */
+#if BTLLC_5MS_MODE
+        tns_numfilters = 2;
 #else
-    processNoiseFactor_fx(&fac_ns_idx, d_fx_exp, d_fx, q_d_fx16, gain, gain_e, BW_cutoff_idx, encoder->frame_dms,
-                          currentScratch);
+        tns_numfilters = 1;
+        IF (sub(BW_cutoff_idx, 3) >= 0 && sub(encoder->frame_dms, 50) >= 0)
+        {
+            tns_numfilters = 2;
+        }
 #endif
+        tns_order[0]         = 0;
+        tns_order[1]         = 0;
+        h_EncSetup->tns_bits = tns_numfilters;
+    }
     BASOP_sub_end();
 
-    BASOP_sub_start("Entropy cod");
-    processEncoderEntropy(bytes, &bp_side, &mask_side, h_EncSetup->targetBitsAri, h_EncSetup->targetBytes,
-                          encoder->yLen, encoder->BW_cutoff_bits, tns_numfilters, lsbMode, lastnz,
-                          tns_order, fac_ns_idx, quantizedGain, BW_cutoff_idx, ltpf_idx, L_scf_idx, bfi_ext,
-                          encoder->fs_idx);
-    BASOP_sub_end();
-
-    BASOP_sub_start("Ari cod");
-    processAriEncoder_fx(bytes, bp_side, mask_side, h_EncSetup->targetBitsAri, q_d_fx16, tns_order, tns_numfilters,
-                         indexes, lastnz, codingdata, resBits, numResBits, lsbMode, h_EncSetup->enable_lpc_weighting,
-                         currentScratch);
-    BASOP_sub_end();
+    /* q_d_fx16 Size = 10 * MAX_LEN bytes */
+    Enc_LC3_CodeSpectrum(encoder, h_EncSetup, d_fx, d_fx_exp, BW_cutoff_idx, tns_numfilters, tns_order, indexes, ltpf_idx,
+                         ltpf_bits, L_scf_idx, bytes, (Word8 *)q_d_fx16, bfi_ext);
 
-    BASOP_sub_start("Reorder Bitstream Enc");
-    test();
-    IF (encoder->combined_channel_coding == 0 && h_EncSetup->n_pc > 0)
+    /* A zero frame that leaves the whole state unchanged codes to the same frame and again leaves the
+       state unchanged, so the following zero frames repeat it until the input or the frame size changes */
+    BASOP_sub_start("Silence");
+    h_EncSetup->silence_bytes = 0;
+    IF (rest)
     {
-		printf("Reorder Ari dec\n");
-        //BASOP_sub_start("Reorder Ari dec");
-        //processAriDecoder_fx(bytes, &bp_side, &mask_side, h_EncSetup->total_bits, encoder->yLen, encoder->fs_idx,
-        //                     h_EncSetup->enable_lpc_weighting, tns_numfilters, lsbMode, lastnz, &gain, tns_order,
-        //                     fac_ns_idx, quantizedGain, encoder->frame_dms,
-        //                     h_EncSetup->n_pc, 0, shr_pos(h_EncSetup->total_bits,3), 1, &gain, &b_left,
-        //                     &gain, codingdata, &gain, (Word16*)resBits, indexes, &gain, currentScratch);
-        //BASOP_sub_end(); /* Ari dec */
-        //processReorderBitstream_fx(bytes, h_EncSetup->n_pccw, h_EncSetup->n_pc, b_left, currentScratch);
+        enc_scalar_mem(h_EncSetup, &mem);
+        test();
+        IF (enc_delay_lines_zero(encoder, h_EncSetup) && memcmp(&rest_mem, &mem, sizeof(mem)) == 0)
+        {
+            basop_memcpy(&encoder->silence_cache[channel * MAX_NBYTES], bytes, h_EncSetup->targetBytes);
+            h_EncSetup->silence_bytes = h_EncSetup->targetBytes;
+        }
     }
     BASOP_sub_end();
 
-    /* end q_d_fx16 */
     BASOP_sub_end();
 
 
     Dyn_Mem_Deluxe_Out();
 }
 
-int Enc_LC3(LC3_Enc *encoder, void **input, int bits_per_sample, UWord8 *output, void *scratch, Word16 bfi_ext)
+/* spec_exp != NULL -> input is the Word32 MDCT spectrum with exponent spec_exp[ch] */
+int Enc_LC3(LC3_Enc *encoder, void **input, int bits_per_sample, const Word16 *spec_exp, UWord8 *output, void *scratch,
+            Word16 bfi_ext)
 {
     int ch = 0, output_size = 0;
     int input_size = 0;
@@ -257,7 +464,8 @@ int Enc_LC3(LC3_Enc *encoder, void **input, int bits_per_sample, UWord8 *output,
 
     for (ch = 0; ch < encoder->channels; ch++)
     {
-        Enc_LC3_Channel(encoder, ch, bits_per_sample, input[ch], lc3buf, scratch, bfi_ext);
+        Enc_LC3_Channel(encoder, ch, bits_per_sample, input[ch], spec_exp ? &spec_exp[ch] : NULL, lc3buf, scratch,
+                        bfi_ext);
         //if (encoder->epmode && encoder->combined_channel_coding == 0)
         //{
         //    output_size2 = totalBytes / encoder->channels + (ch < (totalBytes % encoder->channels));
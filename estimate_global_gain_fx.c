@@ -21,6 +21,7 @@ void processEstimateGlobalGain_fx(Word32 x[], Word16 x_e, Word16 lg, Word16 nbit
     Word32  ener, tmp32, x_max;
     Word32  target, fac, offset;
     Word32 *en;
+    Word16 *en_exp;
     Counter i, iter;
     Word32 diff, diff2;
 
@@ -31,12 +32,14 @@ void processEstimateGlobalGain_fx(Word32 x[], Word16 x_e, Word16 lg, Word16 nbit
                    Word32  ener, tmp32, x_max;
                    Word32  target, fac, offset;
                    Word32 *en;
+                   Word16 *en_exp;
                    Counter i, iter;
                    Word32  diff, diff2;
                }));
 #endif
 
-    en = (Word32 *)scratchAlign(scratchBuffer, 0); /* Size = 4 * MAX_LEN bytes */
+    en     = (Word32 *)scratchAlign(scratchBuffer, 0);                   /* Size = MAX_LEN bytes */
+    en_exp = (Word16 *)scratchAlign(en, sizeof(*en) * shr_pos(lg, 2)); /* Size = MAX_LEN / 2 bytes */
 
     IF (*old_targetBits < 0)
     {
@@ -91,11 +94,19 @@ void processEstimateGlobalGain_fx(Word32 x[], Word16 x_e, Word16 lg, Word16 nbit
 #ifdef NON_BE_GAIN_EST_FIX
         if (ener==1 && s < 0) s = 0;
 #endif
-        /* log */
-        tmp32 = L_add(BASOP_Util_Log2(ener), L_shl_pos(L_deposit_l(s), 25)); /* log2, 6Q25 */
+        en[i]     = ener; 
+        en_exp[i] = s;    
+        x += 4;
+    }
+
+    /* log, one batched pass over all quadruples */
+    BASOP_Util_Log2_vec(en, en, lg_4);
+
+    FOR (i = 0; i < lg_4; i++)
+    {
+        tmp32 = L_add(en[i], L_shl_pos(L_deposit_l(en_exp[i]), 25)); /* log2, 6Q25 */
         tmp32 = L_add(L_shr_pos(Mpy_32_16(tmp32, 0x436E), 6), 0x9CCCD); /* -> (28/20)*(7+10*tmp32/log2(10)), 15Q16 */
         en[i] = tmp32;                                                  
-        x += 4;
     }
 
     IF (x_max == 0)
@@ -19,6 +19,8 @@
 #include "rom_basop_util.h"
 #include "setup_dec_lc3.h" /* for decoder state handle ptr  */
 #include "setup_enc_lc3.h" /* for encoder state handle ptr  */
+#include "scratch_arena.h"
+#include "jitter_buffer.h"
 #include "stl.h"
 
 #ifdef WIN32
@@ -67,6 +69,11 @@ void processScfScaling(Word16 scf_exp[], Word16 fdns_npts, Word16 *x_e);
 
 void processMdct_fx(LC3_Enc* encoder, Word16 x[], Word16 mem[], Word32 y[], Word16 *y_e, Word8 *scratchBuffer);
 
+void processSpectrumInput_fx(Word32 x[], Word16 x_exp, Word32 y[], Word16 *y_exp, Word16 len);
+
+void processSpectrumMix_fx(Word32 y[], Word16 *y_exp, const Word32 x[], Word16 x_exp, Word16 gain, Word16 gain_exp,
+                           Word16 len);
+
 void processLevinson_fx(Word32 *lpc, Word32 *ac, Word16 N, Word16 *rc, Word32 *pred_err, Word8 *scratchBuffer);
 
 void lpc2rc(Word32 *lpc, Word16 *rc, Word16 N);
@@ -80,7 +87,7 @@ void dct_IV(Word32 *pDat, Word16 *pDat_e, Word16 L, Word32 *workBuffer);
 Word16 find_last_nz_pair(const Word16 x[], Word16 length);
 
 PvqEntry_fx mpvq_index_fx(const Word16 *vec_in, Word16 dim_in, Word16 k_val_local);
-void        mpvq_deindex_fx(const PvqEntry_fx *entry, UWord32 *h_mem, Word16 *vec_out);
+void        mpvq_deindex_fx(const PvqEntry_fx *entry, Word16 *vec_out);
 
 void pvq_enc_search_fx(const Word16 *x,       /* i:   target vector to quantize             Qin      */
                        Word16 *      rt_far,  /* o:   outl_far o, raw pulses  (non-scaled short) Q0      */
@@ -96,7 +103,7 @@ void pvq_enc_search_fx(const Word16 *x,       /* i:   target vector to quantize
                        const Word16 dimA /* i:   Length of vector A section */
 );
 
-PvqEntry_fx get_size_mpvq_calc_offset_fx(Word16 dim_in, Word16 k_val_in, UWord32 *h_mem);
+PvqEntry_fx get_size_mpvq_fx(Word16 dim_in, Word16 k_val_in);
 
 Word16 pvq_dec_deidx_fx(                          /* out BER detected 1 , ok==0 */
                         Word16 *      y,          /* o:   decoded vector (non-scaled int)  */
@@ -165,7 +172,7 @@ void process_ltpf_decoder_fx(Word16 *x_e, Word16 L_frame, Word16 old_x_len, Word
                              Word16 concealMethod,
                              Word16 damping, Word16 *old_scale_fac_idx, Word8 *scratchBuffer);
 
-void attack_detector_fx(LC3_Enc *enc, EncSetup *setup, Word16 *input, Word16 input_scaling, void *scratch);
+void attack_detector_fx(EncSetup *setup, const Word16 *s_12k8, Word16 s_12k8_len);
 
 void processSnsComputeScf_fx(Word32 *d2_fx, Word16 d2_fx_exp, Word16 fs_idx, Word16 n_bands, Word16 *scf,
                              Word16 scf_smoothing_enabled, Word8 *scratchBuffer);
@@ -447,8 +454,105 @@ void idct16_fx(const Word16 *in, Word16 *out);
 
 /* Functions used in arithmetic coder */
 
-void write_bit_backward(UWord8 *ptr, Word16 *bp, Word16 *mask, Word16 bit);
-void write_indice_backward(UWord8 *ptr, Word16 *bp, Word16 *mask, Word16 indice, Word16 numbits);
+/* Backward bit stream of the side information and the residual bits. Bits go from the lsb of ptr[bp]
+   upwards and bytes from bp downwards, the position is given by bp and mask as for read_bit(). Pending
+   bits are kept in a 64 bit word and stored or loaded as whole bytes. */
+typedef struct
+{
+    UWord8 *ptr;
+    UWord64 acc;  /* pending bits, next bit in the lsb */
+    Word16  bits; /* number of pending bits in acc */
+    Word16  bp;   /* next byte to store or load */
+} Bitstream_Backward;
+
+static __inline void bs_write_init(Bitstream_Backward *bs, UWord8 *ptr, Word16 bp, Word16 mask)
+{
+    bs->ptr  = ptr;
+    bs->acc  = 0;
+    bs->bits = sub(14, norm_s(mask)); /* bits already used in ptr[bp] */
+    bs->bp   = bp;
+}
+
+static __inline void bs_write_bytes(Bitstream_Backward *bs)
+{
+    WHILE (bs->bits >= 8)
+    {
+        bs->ptr[bs->bp] |= (UWord8)bs->acc;
+        bs->acc >>= 8;
+        bs->bits = sub(bs->bits, 8);
+        bs->bp   = sub(bs->bp, 1);
+    }
+}
+
+/* numbits <= 16 */
+static __inline void bs_write(Bitstream_Backward *bs, Word16 indice, Word16 numbits)
+{
+    bs->acc |= (UWord64)((UWord16)indice & ((1u << numbits) - 1)) << bs->bits;
+    bs->bits = add(bs->bits, numbits);
+    if (bs->bits >= 48)
+    {
+        bs_write_bytes(bs);
+    }
+}
+
+static __inline void bs_write_finish(Bitstream_Backward *bs, Word16 *bp, Word16 *mask)
+{
+    bs_write_bytes(bs);
+    if (bs->bits > 0)
+    {
+        bs->ptr[bs->bp] |= (UWord8)bs->acc;
+    }
+    *bp   = bs->bp;
+    *mask = shl(1, bs->bits);
+}
+
+static __inline void bs_read_bytes(Bitstream_Backward *bs)
+{
+    WHILE (bs->bits <= 56)
+    {
+        if (bs->bp >= 0)
+        {
+            bs->acc |= (UWord64)bs->ptr[bs->bp] << bs->bits;
+        }
+        bs->bits = add(bs->bits, 8);
+        bs->bp   = sub(bs->bp, 1);
+    }
+}
+
+static __inline void bs_read_init(Bitstream_Backward *bs, UWord8 *ptr, Word16 bp, Word16 mask)
+{
+    Word16 used = sub(14, norm_s(mask));
+
+    bs->ptr  = ptr;
+    bs->acc  = 0;
+    bs->bits = 0;
+    bs->bp   = bp;
+    bs_read_bytes(bs);
+    bs->acc >>= used;
+    bs->bits = sub(bs->bits, used);
+}
+
+/* numbits <= 15 */
+static __inline Word16 bs_read(Bitstream_Backward *bs, Word16 numbits)
+{
+    Word16 indice;
+
+    if (bs->bits < numbits)
+    {
+        bs_read_bytes(bs);
+    }
+    indice = (Word16)(bs->acc & ((1u << numbits) - 1));
+    bs->acc >>= numbits;
+    bs->bits = sub(bs->bits, numbits);
+    return indice;
+}
+
+/* position of the next unread bit */
+static __inline void bs_read_finish(Bitstream_Backward *bs, Word16 *bp, Word16 *mask)
+{
+    *bp   = add(bs->bp, shr_pos(add(bs->bits, 7), 3));
+    *mask = shl(1, s_and(negate(bs->bits), 7));
+}
 
 void processEncoderEntropy(UWord8 *bytes, Word16 *bp_side, Word16 *mask_side, Word16 nbbits, Word16 targetBytes,
                            Word16 L_spec, Word16 BW_cutoff_bits, Word16 tns_numfilters,
@@ -468,20 +572,69 @@ int paddingDec_fx(UWord8 *bytes, Word16 nbbits, Word16 L_spec, Word16 BW_cutoff_
 
 Word16 read_bit(UWord8 *ptr, Word16 *bp, Word16 *mask);
 
+#ifdef LC3_FLOAT_ANALYSIS
+/* enc_analysis_fl.c, single precision replacements of the encoder analysis stages */
+void processMdct_fl(LC3_Enc *encoder, Word16 x[], Word16 mem[], Word32 y[], Word16 *y_e, Word8 *scratchBuffer);
+void processPerBandEnergy_fl(Word32 *d2_fx, Word16 *d2_fx_exp, Word32 *d_fx, Word16 d_fx_exp,
+                             const Word16 *band_offsets, Word16 fs_idx, Word16 n_bands, Word16 linear, Word16 frame_dms,
+                             Word8 *scratchBuffer);
+void processSnsComputeScf_fl(Word32 *d2_fx, Word16 d2_fx_exp, Word16 fs_idx, Word16 n_bands, Word16 *scf,
+                             Word16 scf_smoothing_enabled, Word8 *scratchBuffer);
+void processTnsCoder_fl(Word16 *bits, Word16 indexes[], Word32 x[], Word16 BW_cutoff_idx, Word16 order[],
+                        Word16 *numfilters, Word16 enable_lpc_weighting, Word16 nSubdivisions, Word16 frame_dms,
+                        Word16 maxLen, Word8 *scratchBuffer);
+void processEstimateGlobalGain_fl(Word32 x[], Word16 x_e, Word16 lg, Word16 sqTargetBits, Word16 *gain, Word16 *gain_e,
+                                  Word16 *quantizedGain, Word16 *quantizedGainMin, Word16 quantizedGainOff,
+                                  Word32 *targetBitsOff, Word16 *old_targetBits, Word16 old_specBits,
+                                  Word8 *scratchBuffer);
+#endif
+
+/* kernels_cfg_fx.c */
+const LC3_Kernels *select_kernels(Word16 fs_idx, Word16 frame_dms);
+LC3_KERNEL_CONFIGS(LC3_KERNEL_PROTOTYPES)
+
 /* setup_enc_lc3.c */
 int       alloc_encoder(LC3_Enc *encoder, int samplerate, int channels);
 void      set_enc_frame_params(LC3_Enc *encoder);
 LC3_Error update_enc_bitrate(LC3_Enc *encoder, int bitrate);
+LC3_Error update_enc_nbytes(LC3_Enc *encoder, int nbytes);
+void      set_enc_channel_bytes(LC3_Enc *encoder, EncSetup *setup, Word16 bytes);
+void      reset_enc_pitch_state(EncSetup *setup);
+void      init_enc_bitrate_tab(LC3_Enc *encoder);
+int       enc_snapshot_buffers(const LC3_Enc *encoder, int ch, void **buf, int *len);
 LC3_Error FillEncSetup(LC3_Enc *encoder, int samplerate, int channels);
 
 /* setup_dec_lc3.c */
 int       alloc_decoder(LC3_Dec *decoder, int samplerate, int channels, LC3_PlcMode plc_mode);
 void      set_dec_frame_params(LC3_Dec *decoder);
 LC3_Error update_dec_bitrate(LC3_Dec *decoder, int ch, Word16 nBytes);
+void      init_dec_bitrate_tab(LC3_Dec *decoder);
 LC3_Error FillDecSetup(LC3_Dec *decoder, int samplerate, int channels, LC3_PlcMode plc_mode);
-
-int       Enc_LC3(LC3_Enc *encoder, void **input, int bits_per_sample, UWord8 *output, void *scratch, Word16 bfi_ext);
-LC3_Error Dec_LC3(LC3_Dec *decoder, UWord8 *input, int input_bytes, void **output, int bits_per_sample, void *scratch, int bfi_ext);
+int       alloc_dec_speculation(LC3_Dec *decoder, void *buffer, int samplerate, int channels, LC3_PlcMode plc_mode);
+int       dec_channel_scratch_size(const LC3_Dec *decoder, int slice);
+int       dec_snapshot_buffers(const LC3_Dec *decoder, int ch, void **buf, int *len);
+int       alloc_scratch_arena(LC3_ScratchArena *arena, int samplerate, int channels);
+LC3_Error FillScratchArena(LC3_ScratchArena *arena, int samplerate, int channels);
+void      scratch_arena_begin(LC3_ScratchArena *arena);
+int       scratch_arena_check(const LC3_ScratchArena *arena);
+void *    scratch_align_check(void *ptr, int offset);
+int       alloc_jitter_buffer(LC3_JitterBuffer *jb, int samplerate, int frame_dms, int max_delay_ms, int max_bytes);
+LC3_Error FillJitterBuffer(LC3_JitterBuffer *jb, int samplerate, int frame_dms, int max_delay_ms, int max_bytes);
+void      jitter_buffer_reset(LC3_JitterBuffer *jb);
+void      jitter_buffer_put(LC3_JitterBuffer *jb, uint32_t timestamp, uint32_t arrival, const uint8_t *bytes, int nbytes);
+void      jitter_buffer_pop(LC3_JitterBuffer *jb, uint32_t now, uint8_t **data, int *nbytes);
+
+int       Enc_LC3(LC3_Enc *encoder, void **input, int bits_per_sample, const Word16 *spec_exp, UWord8 *output,
+                  void *scratch, Word16 bfi_ext);
+void      Enc_LC3_CodeSpectrum(LC3_Enc *encoder, EncSetup *h_EncSetup, Word32 *d_fx, Word16 d_fx_exp,
+                               Word16 BW_cutoff_idx, Word16 tns_numfilters, Word16 *tns_order, Word16 *indexes,
+                               Word16 *ltpf_idx, Word16 ltpf_bits, Word32 *L_scf_idx, UWord8 *bytes, Word8 *scratchBuffer,
+                               int bfi_ext);
+LC3_Error Dec_LC3(LC3_Dec *decoder, UWord8 *input, int input_bytes, void **output, int bits_per_sample, Word16 *spec_exp,
+                  void *scratch, int bfi_ext);
+LC3_Error Dec_LC3_Speculate(LC3_Dec *decoder, int bits_per_sample, void *scratch);
+LC3_Error Transrate_LC3(LC3_Enc *encoder, LC3_Dec *decoder, UWord8 *input, int num_bytes, UWord8 *output,
+                        int *num_bytes_out, void *scratch);
 
 void *balloc(void *base, size_t *base_size, size_t size);
 
@@ -11,13 +11,16 @@
 
 
 
-void ProcessingIMDCT(
-	LC3_Dec* decoder,
+static inline void ProcessingIMDCT_body(
     Word32       y[],       /* i:   spectra data */
     Word16 *     y_e,       /* i:   spectral data exponent */
     Word16       mem[],     /* i/o: overlap add memory */
     Word16 *     mem_e,     /* i/o: overlap add exponent */
     Word16       x[],       /* o:   time signal out */
+    const Word16 w[],       /* i:   window coefficients including normalization of sqrt(2/N) and scaled by 2^4 */
+    Word16       wLen,      /* i:   window length */
+    Word16       N,         /* i:   block size */
+    Word16       memLen,    /* i:   overlap add buffer size */
     Word16       frame_dms, /* i:   frame size in ms */
     Word16     concealMethod,     /* i:   concealment method */
     Word16     bfi,               /* i:   bad frame indicator */
@@ -26,21 +29,6 @@ void ProcessingIMDCT(
     AplcSetup *plcAd,             /* i: advanced plc struct */
     Word8 *scratchBuffer)
 {
-	const Word16 *w;       /* i:   window coefficients including normalization of sqrt(2/N) and scaled by 2^4 */
-	Word16       wLen;      /* i:   window length */
-	Word16       N;         /* i:   block size */
-	Word16       memLen;    /* i:   overlap add buffer size */
-#if BTLLC_5MS_MODE
-	N = 240;
-	w = LowDelayShapes_n960_N240_5ms;
-	wLen = 420;
-	memLen = decoder->stDec_ola_mem_fx_len;
-#else
-	w = decoder->W_fx;
-	wLen = decoder->W_size;
-	N = decoder->frame_length;
-	memLen = decoder->stDec_ola_mem_fx_len;
-#endif
     Counter i;
     Word16  o, z, m, s;
     Word16  y_s, mem_s, max_bw;
@@ -65,7 +53,7 @@ void ProcessingIMDCT(
     test(); test(); test();
     IF (sub(bfi, 1) != 0 || concealMethod == 0 || sub(concealMethod, 4) == 0 || sub(concealMethod, 5) == 0)
     {
-        workBuffer = (Word32 *)scratchAlign(scratchBuffer, 0); /* Size = 4 * MAX_LEN bytes */
+        workBuffer = (Word32 *)scratchAlignSimd(scratchBuffer, 0); /* Size = 4 * MAX_LEN + LC3_SCRATCH_ALIGN bytes */
 
         /* Init (constant per sample rate) */
         z      = 2 * N - wLen; /* number of leading zeros in window */
@@ -188,6 +176,52 @@ void ProcessingIMDCT(
 }
 /* End Processing */
 
+/* generic version for configurations without specialized kernels, see kernels_cfg.h */
+void ProcessingIMDCT(
+	LC3_Dec* decoder,
+    Word32       y[],       /* i:   spectra data */
+    Word16 *     y_e,       /* i:   spectral data exponent */
+    Word16       mem[],     /* i/o: overlap add memory */
+    Word16 *     mem_e,     /* i/o: overlap add exponent */
+    Word16       x[],       /* o:   time signal out */
+    Word16       frame_dms, /* i:   frame size in ms */
+    Word16     concealMethod,     /* i:   concealment method */
+    Word16     bfi,               /* i:   bad frame indicator */
+    Word16     prev_bfi,          /* i:   previous bad frame indicator */
+    Word16     nbLostFramesInRow, /* i: number of consecutive lost frames */
+    AplcSetup *plcAd,             /* i: advanced plc struct */
+    Word8 *scratchBuffer)
+{
+#if BTLLC_5MS_MODE
+    ProcessingIMDCT_body(y, y_e, mem, mem_e, x, LowDelayShapes_n960_N240_5ms, 420, 240, decoder->stDec_ola_mem_fx_len,
+                         frame_dms, concealMethod, bfi, prev_bfi, nbLostFramesInRow, plcAd, scratchBuffer);
+#else
+    ProcessingIMDCT_body(y, y_e, mem, mem_e, x, decoder->W_fx, decoder->W_size, decoder->frame_length,
+                         decoder->stDec_ola_mem_fx_len, frame_dms, concealMethod, bfi, prev_bfi, nbLostFramesInRow,
+                         plcAd, scratchBuffer);
+#endif
+}
+
+/* one instance per configuration, the block size and frame_dms are constants */
+#if BTLLC_5MS_MODE
+#define IMDCT_CFG_WINDOW(decoder) LowDelayShapes_n960_N240_5ms, 420
+#else
+#define IMDCT_CFG_WINDOW(decoder) (decoder)->W_fx, (decoder)->W_size
+#endif
+
+#define IMDCT_CFG(cfg, cfg_fs_idx, cfg_frame_dms, cfg_bands_number)                                                    \
+    void ProcessingIMDCT_##cfg(LC3_Dec *decoder, Word32 y[], Word16 *y_e, Word16 mem[], Word16 *mem_e, Word16 x[],     \
+                               Word16 frame_dms, Word16 concealMethod, Word16 bfi, Word16 prev_bfi,                    \
+                               Word16 nbLostFramesInRow, AplcSetup *plcAd, Word8 *scratchBuffer)                       \
+    {                                                                                                                  \
+        UNUSED(frame_dms);                                                                                             \
+        ProcessingIMDCT_body(y, y_e, mem, mem_e, x, IMDCT_CFG_WINDOW(decoder),                                         \
+                             LC3_CFG_FRAME_LENGTH(cfg_fs_idx, cfg_frame_dms), decoder->stDec_ola_mem_fx_len,           \
+                             cfg_frame_dms, concealMethod, bfi, prev_bfi, nbLostFramesInRow, plcAd, scratchBuffer);    \
+    }
+
+LC3_KERNEL_CONFIGS(IMDCT_CFG)
+
 
 void Processing_ITDA_WIN_OLA(
     Word32       L_x_tda[], /* i:     X_TDA buffer data   =  "y"  DCT-IV output */
@@ -0,0 +1,291 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+
+#include "functions.h"
+
+static int jb_frame_length(int samplerate, int frame_dms)
+{
+    return frame_dms * CODEC_FS(samplerate) / 10000;
+}
+
+/* if jb is null only size is reported */
+int alloc_jitter_buffer(LC3_JitterBuffer *jb, int samplerate, int frame_dms, int max_delay_ms, int max_bytes)
+{
+    size_t size     = sizeof(LC3_JitterBuffer);
+    int    frame_us = (int)((int64_t)jb_frame_length(samplerate, frame_dms) * 1000000 / samplerate);
+    int    capacity = (max_delay_ms * 1000 + frame_us - 1) / frame_us + JB_EXTRA_SLOTS;
+    int    window   = JB_WINDOW_MS * 1000 / frame_us;
+    int    i        = 0;
+    void * slot = NULL, *offset = NULL, *work = NULL;
+    Word8 *data     = NULL;
+
+    slot   = balloc(jb, &size, sizeof(*jb->slot) * capacity);
+    offset = balloc(jb, &size, sizeof(*jb->offset) * window);
+    work   = balloc(jb, &size, sizeof(*jb->work) * window);
+    data   = balloc(jb, &size, max_bytes * capacity);
+
+    if (jb)
+    {
+        jb->slot     = slot;
+        jb->offset   = offset;
+        jb->work     = work;
+        jb->capacity = capacity;
+        jb->window   = window;
+        for (i = 0; i < capacity; i++)
+        {
+            jb->slot[i].data = (uint8_t *)data + i * max_bytes;
+        }
+    }
+
+    return (int)size;
+}
+
+/* forget all frames and the transit history, the next frame restarts playout */
+void jitter_buffer_reset(LC3_JitterBuffer *jb)
+{
+    int i = 0;
+
+    for (i = 0; i < jb->capacity; i++)
+    {
+        jb->slot[i].state = JB_EMPTY;
+    }
+    jb->fill         = 0;
+    jb->pos          = 0;
+    jb->excess       = 0;
+    jb->out_of_range = 0;
+    jb->receiving    = 0;
+    jb->playing      = 0;
+}
+
+LC3_Error FillJitterBuffer(LC3_JitterBuffer *jb, int samplerate, int frame_dms, int max_delay_ms, int max_bytes)
+{
+    int frame_length = jb_frame_length(samplerate, frame_dms);
+
+    memset(jb, 0, alloc_jitter_buffer(NULL, samplerate, frame_dms, max_delay_ms, max_bytes));
+    alloc_jitter_buffer(jb, samplerate, frame_dms, max_delay_ms, max_bytes);
+
+    jb->samplerate = samplerate;
+    jb->frame_us   = (int32_t)((int64_t)frame_length * 1000000 / samplerate);
+    jb->frame_rem  = (int32_t)((int64_t)frame_length * 1000000 % samplerate);
+    jb->ts_step    = frame_length;
+    jb->max_delay  = max_delay_ms * 1000;
+    jb->max_bytes  = max_bytes;
+    jb->loss       = JB_DEFAULT_LOSS;
+    jb->skip_hold  = JB_SKIP_HOLD_MS * 1000 / jb->frame_us;
+    jitter_buffer_reset(jb);
+
+    return LC3_OK;
+}
+
+static JitterSlot *jb_slot(const LC3_JitterBuffer *jb, int32_t seq)
+{
+    int32_t idx = seq % jb->capacity;
+    return &jb->slot[idx < 0 ? idx + jb->capacity : idx];
+}
+
+/* duration of n frames in us, relative to ref */
+static int32_t jb_frames_us(const LC3_JitterBuffer *jb, int32_t n)
+{
+    return n * jb->frame_us + (int32_t)(((int64_t)n * jb->frame_rem + jb->ref_frac) / jb->samplerate);
+}
+
+/* move the playout position by n frames, ref follows */
+static void jb_advance(LC3_JitterBuffer *jb, int32_t n)
+{
+    int64_t frac = (int64_t)jb->ref_frac + (int64_t)n * jb->frame_rem;
+    int32_t us   = (int32_t)(frac >= 0 ? frac / jb->samplerate : -((-frac + jb->samplerate - 1) / jb->samplerate));
+
+    jb->ref_frac = (uint32_t)(frac - (int64_t)us * jb->samplerate);
+    jb->ref += (uint32_t)(n * jb->frame_us + us);
+    jb->play_seq += n;
+    jb->play_ts += (uint32_t)(n * jb->ts_step);
+}
+
+/* k-th smallest of x, x is reordered */
+static int32_t jb_select(int32_t *x, int n, int k)
+{
+    int lo = 0, hi = n - 1;
+
+    while (lo < hi)
+    {
+        int32_t pivot = x[(lo + hi) / 2];
+        int     i = lo, j = hi;
+
+        while (i <= j)
+        {
+            while (x[i] < pivot)
+                i++;
+            while (x[j] > pivot)
+                j--;
+            if (i <= j)
+            {
+                int32_t t = x[i];
+                x[i++]    = x[j];
+                x[j--]    = t;
+            }
+        }
+        if (k <= j)
+            hi = j;
+        else if (k >= i)
+            lo = i;
+        else
+            break;
+    }
+    return x[k];
+}
+
+/* the target playout offset is the (1 - loss) quantile of the recent transit offsets */
+static void jb_push_offset(LC3_JitterBuffer *jb, int32_t offset)
+{
+    int i = 0, k = 0;
+
+    jb->offset[jb->pos] = offset;
+    jb->pos             = jb->pos + 1 == jb->window ? 0 : jb->pos + 1;
+    jb->fill            = MIN(jb->fill + 1, jb->window);
+
+    jb->min_offset = jb->offset[0];
+    for (i = 0; i < jb->fill; i++)
+    {
+        jb->work[i]    = jb->offset[i];
+        jb->min_offset = MIN(jb->min_offset, jb->offset[i]);
+    }
+    k          = MIN((int)(((int64_t)jb->fill * (32768 - jb->loss)) >> 15), jb->fill - 1);
+    jb->target = MIN(jb_select(jb->work, jb->fill, k), jb->min_offset + jb->max_delay);
+}
+
+void jitter_buffer_put(LC3_JitterBuffer *jb, uint32_t timestamp, uint32_t arrival, const uint8_t *bytes, int nbytes)
+{
+    int32_t     seq = 0, d = 0, offset = 0;
+    JitterSlot *slot = NULL;
+
+    if (!jb->receiving)
+    {
+        /* first frame, playout starts with it at the next deadline */
+        jb->receiving = 1;
+        jb->play_seq  = 0;
+        jb->max_seq   = 0;
+        jb->play_ts   = timestamp;
+        jb->ref       = arrival;
+        jb->ref_frac  = 0;
+    }
+
+    d   = (int32_t)(timestamp - jb->play_ts);
+    seq = jb->play_seq + (d >= 0 ? d + jb->ts_step / 2 : d - jb->ts_step / 2) / jb->ts_step;
+
+    /* reordered frames that arrive before playout started move the start back */
+    if (!jb->playing && seq < jb->play_seq && jb->max_seq - seq < jb->capacity)
+    {
+        jb_advance(jb, seq - jb->play_seq);
+    }
+
+    if (seq - jb->play_seq >= jb->capacity || jb->play_seq - seq >= jb->capacity)
+    {
+        jb->stats.dropped++;
+        if (++jb->out_of_range >= JB_RESYNC_FRAMES)
+        {
+            jb->stats.resyncs++;
+            jitter_buffer_reset(jb);
+            jitter_buffer_put(jb, timestamp, arrival, bytes, nbytes);
+        }
+        return;
+    }
+    jb->out_of_range = 0;
+
+    slot   = jb_slot(jb, seq);
+    offset = (int32_t)(arrival - jb->ref) - jb_frames_us(jb, seq - jb->play_seq);
+
+    if (slot->seq == seq && slot->state != JB_EMPTY && slot->state != JB_LOST)
+    {
+        jb->stats.dropped++; /* duplicate */
+        return;
+    }
+
+    jb->stats.received++;
+    jb_push_offset(jb, offset);
+
+    if (seq < jb->play_seq)
+    {
+        jb->stats.late++;
+        if (slot->seq == seq)
+        {
+            slot->state = JB_DONE; /* a second copy is a duplicate */
+        }
+        return;
+    }
+
+    memcpy(slot->data, bytes, nbytes);
+    slot->seq     = seq;
+    slot->arrival = arrival;
+    slot->nbytes  = (int16_t)nbytes;
+    slot->state   = JB_FULL;
+    jb->max_seq   = MAX(jb->max_seq, seq);
+}
+
+/* frame due at time now, nbytes is 0 if it has to be concealed. data points into the buffer and is
+   valid until the next jitter_buffer_put() */
+void jitter_buffer_pop(LC3_JitterBuffer *jb, uint32_t now, uint8_t **data, int *nbytes)
+{
+    JitterSlot *slot = NULL, *next = NULL;
+    int32_t     playout = 0;
+
+    *data   = jb->slot[0].data;
+    *nbytes = 0;
+
+    if (!jb->receiving)
+    {
+        return; /* nothing received yet */
+    }
+
+    jb->playing      = 1;
+    playout          = (int32_t)(now - jb->ref);
+    jb->stats.delay  = playout - jb->min_offset;
+    jb->stats.target = jb->target - jb->min_offset;
+    slot             = jb_slot(jb, jb->play_seq);
+
+    if (slot->seq == jb->play_seq && slot->state == JB_FULL)
+    {
+        /* lower the delay by skipping a frame if it stayed above target for long enough */
+        next       = jb_slot(jb, jb->play_seq + 1);
+        jb->excess = playout - jb_frames_us(jb, 1) >= jb->target && next->seq == jb->play_seq + 1 &&
+                             next->state == JB_FULL
+                         ? jb->excess + 1
+                         : 0;
+        if (jb->excess >= jb->skip_hold)
+        {
+            jb->stats.skipped++;
+            jb->excess  = 0;
+            slot->state = JB_DONE;
+            slot        = next;
+            jb_advance(jb, 1);
+        }
+
+        jb->stats.played++;
+        jb->delay_sum += (uint32_t)(now - slot->arrival);
+        jb->stats.buffer_delay = (int32_t)(jb->delay_sum / (uint32_t)jb->stats.played);
+        slot->state            = JB_DONE;
+        *data                  = slot->data;
+        *nbytes                = slot->nbytes;
+        jb_advance(jb, 1);
+    }
+    else if (playout < jb->target && playout - jb->min_offset < jb->max_delay)
+    {
+        /* wait for the frame, one more frame of delay */
+        jb->stats.stretched++;
+        jb->excess = 0;
+    }
+    else
+    {
+        jb->stats.concealed++;
+        jb->excess  = 0;
+        slot->seq   = jb->play_seq;
+        slot->state = JB_LOST;
+        jb_advance(jb, 1);
+    }
+}
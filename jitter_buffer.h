@@ -0,0 +1,75 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+#ifndef JITTER_BUFFER_H
+#define JITTER_BUFFER_H
+
+#include "lc3.h"
+
+#include <stdint.h>
+
+#define JB_WINDOW_MS 4000     /* transit offsets the target delay is estimated from */
+#define JB_SKIP_HOLD_MS 100   /* delay above target for this long before a frame is skipped */
+#define JB_MAX_DELAY_MS 1000  /* upper limit of max_delay_ms */
+#define JB_EXTRA_SLOTS 3      /* slots beyond max_delay_ms for the frame being played and skips */
+#define JB_RESYNC_FRAMES 4    /* consecutive frames outside of the buffer restart it */
+#define JB_DEFAULT_LOSS 328   /* 1% late loss in Q15 */
+
+/* slot states */
+#define JB_EMPTY 0
+#define JB_FULL 1 /* received, waiting for its deadline */
+#define JB_DONE 2 /* played, skipped or arrived after it was concealed */
+#define JB_LOST 3 /* concealed at its deadline */
+
+typedef struct
+{
+    int32_t  seq;     /* frame number */
+    uint32_t arrival; /* arrival time in us */
+    int16_t  state;   /* JB_EMPTY .. JB_LOST */
+    int16_t  nbytes;
+    uint8_t *data;    /* max_bytes */
+} JitterSlot;
+
+/* Adaptive jitter buffer. Frame seq is due at ref + (seq - play_seq) frames plus the playout
+   offset, the transit offset of a frame is its arrival time on the same scale. Frames are on time if
+   their transit offset does not exceed the playout offset, which follows the target by inserting
+   concealed frames on underrun and skipping frames while the buffer holds more than needed. */
+struct LC3_JitterBuffer
+{
+    JitterSlot *    slot;       /* ring of capacity frames, frame seq is kept in slot seq % capacity */
+    int32_t *       offset;     /* transit offsets of the last window frames in us */
+    int32_t *       work;       /* window entries for the quantile */
+    uint64_t        delay_sum;  /* buffering delay of all played frames in us */
+    uint32_t        ref;        /* due time of play_seq at playout offset 0, in us */
+    uint32_t        ref_frac;   /* fraction of ref in 1 / samplerate us */
+    uint32_t        play_ts;    /* timestamp of play_seq */
+    int32_t         play_seq;   /* next frame to play */
+    int32_t         max_seq;    /* highest frame received */
+    int32_t         samplerate;
+    int32_t         frame_us;   /* frame duration is frame_us + frame_rem / samplerate us */
+    int32_t         frame_rem;
+    int32_t         ts_step;    /* timestamp increment per frame */
+    int32_t         max_delay;  /* in us */
+    int32_t         loss;       /* target late loss in Q15 */
+    int32_t         target;     /* target playout offset in us */
+    int32_t         min_offset; /* lowest transit offset in the window */
+    int16_t         capacity;   /* number of slots */
+    int16_t         max_bytes;  /* slot size */
+    int16_t         window;     /* length of offset */
+    int16_t         fill;       /* valid entries of offset */
+    int16_t         pos;        /* next entry of offset to write */
+    int16_t         skip_hold;  /* deadlines above target before a frame is skipped */
+    int16_t         excess;     /* consecutive deadlines above target */
+    int16_t         out_of_range; /* consecutive frames outside of the buffer */
+    int16_t         receiving;  /* a frame was received since init or resync */
+    int16_t         playing;    /* playout started */
+    LC3_JitterStats stats;
+};
+
+#endif
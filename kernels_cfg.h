@@ -0,0 +1,75 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+#ifndef KERNELS_CFG_H
+#define KERNELS_CFG_H
+
+#include "constants.h"
+#include "lc3.h"
+
+/* Configurations with specialized kernels, X(name, fs_idx, frame_dms, bands_number).
+   Every kernel file instantiates its body once per entry with these values as
+   constants, all other configurations run the generic functions. */
+#if BTLLC_5MS_MODE
+#define LC3_KERNEL_CONFIGS(X) X(48k_5ms, 4, 50, 55)
+#else
+#define LC3_KERNEL_CONFIGS(X)                                                                                          \
+    X(48k_5ms, 4, 50, 55)                                                                                              \
+    X(48k_10ms, 4, 100, 64)                                                                                            \
+    X(32k_10ms, 3, 100, 64)                                                                                            \
+    X(16k_10ms, 1, 100, 64)
+#endif
+
+/* Frame length of a configuration, 44.1 kHz runs on the 48 kHz grid */
+#define LC3_CFG_FRAME_LENGTH(fs_idx, frame_dms) (((fs_idx) == 4 ? 48 : 8 * ((fs_idx) + 1)) * (frame_dms) / 10)
+
+struct AplcSetup; /* setup_dec_lc3.h */
+
+/* Kernel signatures, same as the generic functions. Arguments fixed by the
+   configuration are ignored by the specialized instances. */
+typedef void Lc3PerBandEnergyFn(Word32 *d2_fx, Word16 *d2_fx_exp, Word32 *d_fx, Word16 d_fx_exp,
+                                const Word16 *band_offsets, Word16 fs_idx, Word16 n_bands, Word16 linear,
+                                Word16 frame_dms, Word8 *scratchBuffer);
+typedef void Lc3SnsInterpolateScfFn(Word16 *scf_q, Word16 mdct_scf[], Word16 mdct_scf_exp[], Word16 inv_scf,
+                                    Word16 n_bands, Word8 *scratchBuffer);
+typedef void Lc3MdctShapingFn(Word32 x[], Word16 scf[], Word16 scf_exp[], const Word16 bands_offset[],
+                              Word16 fdns_npts);
+typedef void Lc3NoiseFillingFn(Word32 xq[], Word16 nfseed, Word16 xq_e, Word16 fac_ns_idx, Word16 BW_cutoff_idx,
+                               Word16 frame_dms, Word16 fac_ns_pc, Word16 spec_inv_idx, Word8 *scratchBuffer);
+typedef void Lc3TnsDecoderFn(Word16 rc_idx[], Word32 x[], Word16 xLen, Word16 order[], Word16 *x_e,
+                             Word16 BW_stopband_idx, Word16 frame_dms, Word8 *scratchBuffer);
+typedef void Lc3TnsCoderFn(Word16 *bits, Word16 indexes[], Word32 x[], Word16 BW_cutoff_idx, Word16 order[],
+                           Word16 *numfilters, Word16 enable_lpc_weighting, Word16 nSubdivisions, Word16 frame_dms,
+                           Word16 maxLen, Word8 *scratchBuffer);
+typedef void Lc3ImdctFn(LC3_Dec *decoder, Word32 y[], Word16 *y_e, Word16 mem[], Word16 *mem_e, Word16 x[],
+                        Word16 frame_dms, Word16 concealMethod, Word16 bfi, Word16 prev_bfi, Word16 nbLostFramesInRow,
+                        struct AplcSetup *plcAd, Word8 *scratchBuffer);
+
+/* Kernel set of one configuration, selected once in set_enc_frame_params() / set_dec_frame_params() */
+typedef struct
+{
+    Lc3PerBandEnergyFn *    per_band_energy;
+    Lc3SnsInterpolateScfFn *sns_interpolate_scf;
+    Lc3MdctShapingFn *      mdct_shaping;
+    Lc3NoiseFillingFn *     noise_filling;
+    Lc3TnsDecoderFn *       tns_decoder;
+    Lc3TnsCoderFn *         tns_coder;
+    Lc3ImdctFn *            imdct;
+} LC3_Kernels;
+
+#define LC3_KERNEL_PROTOTYPES(cfg, cfg_fs_idx, cfg_frame_dms, cfg_bands_number)                                        \
+    Lc3PerBandEnergyFn     processPerBandEnergy_##cfg##_fx;                                                            \
+    Lc3SnsInterpolateScfFn processSnsInterpolateScf_##cfg##_fx;                                                        \
+    Lc3MdctShapingFn       processMdctShaping_##cfg##_fx;                                                              \
+    Lc3NoiseFillingFn      processNoiseFilling_##cfg##_fx;                                                             \
+    Lc3TnsDecoderFn        processTnsDecoder_##cfg##_fx;                                                               \
+    Lc3TnsCoderFn          processTnsCoder_##cfg##_fx;                                                                 \
+    Lc3ImdctFn             ProcessingIMDCT_##cfg;
+
+#endif
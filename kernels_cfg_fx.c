@@ -0,0 +1,38 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+#include "functions.h"
+
+#define KERNEL_TABLE(cfg, cfg_fs_idx, cfg_frame_dms, cfg_bands_number)                                                 \
+    static const LC3_Kernels kernels_##cfg = {processPerBandEnergy_##cfg##_fx, processSnsInterpolateScf_##cfg##_fx,   \
+                                              processMdctShaping_##cfg##_fx, processNoiseFilling_##cfg##_fx,           \
+                                              processTnsDecoder_##cfg##_fx, processTnsCoder_##cfg##_fx,                \
+                                              ProcessingIMDCT_##cfg};
+
+LC3_KERNEL_CONFIGS(KERNEL_TABLE)
+
+static const LC3_Kernels kernels_generic = {processPerBandEnergy_fx, processSnsInterpolateScf_fx,
+                                            processMdctShaping_fx,   processNoiseFilling_fx,
+                                            processTnsDecoder_fx,    processTnsCoder_fx,
+                                            ProcessingIMDCT};
+
+/* called once per configuration change, never per frame */
+const LC3_Kernels *select_kernels(Word16 fs_idx, Word16 frame_dms)
+{
+#define KERNEL_MATCH(cfg, cfg_fs_idx, cfg_frame_dms, cfg_bands_number)                                                 \
+    if (fs_idx == (cfg_fs_idx) && frame_dms == (cfg_frame_dms))                                                        \
+    {                                                                                                                  \
+        return &kernels_##cfg;                                                                                         \
+    }
+
+    LC3_KERNEL_CONFIGS(KERNEL_MATCH)
+#undef KERNEL_MATCH
+
+    return &kernels_generic;
+}
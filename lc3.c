@@ -117,6 +117,151 @@ void *balloc(void *base, size_t *base_size, size_t size)
     return (void *)ptr;
 }
 
+/* header of a state snapshot. it is followed by the state structs with their pointers cleared
+   and then by the channel buffers, of which only the part carrying over to the next frame is kept.
+   pointers are rebuilt on restore, so snapshots can be moved between instances, threads and hosts
+   running the same build */
+typedef struct
+{
+    int32_t magic;
+    int32_t version;
+    int32_t samplerate;
+    int32_t channels;
+    int32_t plc_mode;
+    int32_t size;
+} SnapshotHeader;
+
+#define SNAPSHOT_MAGIC 0x4C433353 /* "LC3S" */
+
+static int snapshot_valid(const SnapshotHeader *hdr, int size, int samplerate, int channels, int plc_mode)
+{
+    RETURN_IF(size < (int)sizeof(*hdr), 0);
+    RETURN_IF(hdr->magic != SNAPSHOT_MAGIC || hdr->version != LC3_VERSION, 0);
+    RETURN_IF(hdr->size < 0 || size - (int)sizeof(*hdr) < hdr->size, 0);
+    RETURN_IF(hdr->samplerate != samplerate || hdr->channels != channels, 0);
+    RETURN_IF(hdr->plc_mode != plc_mode, 0);
+    return 1;
+}
+
+static void snapshot_header(SnapshotHeader *hdr, int samplerate, int channels, int plc_mode, int state_size)
+{
+    hdr->magic      = SNAPSHOT_MAGIC;
+    hdr->version    = LC3_VERSION;
+    hdr->samplerate = samplerate;
+    hdr->channels   = channels;
+    hdr->plc_mode   = plc_mode;
+    hdr->size       = state_size;
+}
+
+/* append len bytes to the snapshot data at *pos, only count them if data is NULL */
+static void snapshot_put(void *data, int *pos, const void *src, int len)
+{
+    if (data)
+        memcpy((Word8 *)data + *pos, src, len);
+    *pos += len;
+}
+
+/* read len bytes of the snapshot data at *pos, returns 0 if the data ends before */
+static int snapshot_get(const void *data, int *pos, int end, void *dst, int len)
+{
+    RETURN_IF(len > end - *pos, 0);
+    memcpy(dst, (const Word8 *)data + *pos, len);
+    *pos += len;
+    return 1;
+}
+
+/* write the encoder snapshot data or only count its size if data is NULL */
+static int snapshot_enc_data(const LC3_Enc *encoder, void *data)
+{
+    int     ch = 0, i = 0, n = 0, pos = 0;
+    int     len[MAX_SNAPSHOT_BUFFERS];
+    void *  buf[MAX_SNAPSHOT_BUFFERS];
+    LC3_Enc enc = *encoder;
+
+    memset(enc.channel_setup, 0, sizeof(enc.channel_setup));
+#if !BTLLC_5MS_MODE
+    enc.W_fx = NULL;
+#endif
+    enc.bands_offset  = NULL;
+    enc.kernels       = NULL;
+    enc.silence_cache = NULL;
+    snapshot_put(data, &pos, &enc, sizeof(enc));
+
+    for (ch = 0; ch < encoder->channels; ch++)
+    {
+        EncSetup setup       = *encoder->channel_setup[ch];
+        setup.stEnc_mdct_mem = NULL;
+        setup.mdct_mem32     = NULL;
+        setup.silence_bytes  = 0; /* the silence frame is encoded again, no need to keep it */
+        snapshot_put(data, &pos, &setup, sizeof(setup));
+    }
+
+    for (ch = 0; ch < encoder->channels; ch++)
+    {
+        n = enc_snapshot_buffers(encoder, ch, buf, len);
+        for (i = 0; i < n; i++)
+            snapshot_put(data, &pos, buf[i], len[i]);
+    }
+
+    return pos;
+}
+
+/* write the decoder snapshot data or only count its size if data is NULL */
+static int snapshot_dec_data(const LC3_Dec *decoder, void *data)
+{
+    int     ch = 0, i = 0, n = 0, pos = 0;
+    int     len[MAX_SNAPSHOT_BUFFERS];
+    void *  buf[MAX_SNAPSHOT_BUFFERS];
+    LC3_Dec dec = *decoder;
+
+    memset(dec.channel_setup, 0, sizeof(dec.channel_setup));
+#if !BTLLC_5MS_MODE
+    dec.W_fx = NULL;
+#endif
+    dec.bands_offset  = NULL;
+    dec.kernels       = NULL;
+    dec.spec_state    = NULL;
+    dec.spec_pcm      = NULL;
+    dec.spec_bits     = 0;
+    dec.parallel_for  = NULL;
+    dec.parallel_user = NULL;
+    snapshot_put(data, &pos, &dec, sizeof(dec));
+
+    for (ch = 0; ch < decoder->channels; ch++)
+    {
+        DecSetup setup         = *decoder->channel_setup[ch];
+        setup.ltpf_mem_x       = NULL;
+        setup.ltpf_mem_y       = NULL;
+        setup.stDec_ola_mem_fx = NULL;
+        setup.plcAd            = NULL;
+        setup.q_old_d_fx       = NULL;
+        setup.q_old_res_fx     = NULL;
+        snapshot_put(data, &pos, &setup, sizeof(setup));
+
+        if (decoder->channel_setup[ch]->plcAd)
+        {
+            AplcSetup plcAd         = *decoder->channel_setup[ch]->plcAd;
+            plcAd.x_old_tot_fx      = NULL;
+            plcAd.PhECU_f0est       = NULL;
+            plcAd.PhECU_xfp_fx      = NULL;
+            plcAd.PhECU_X_sav_fx    = NULL;
+            plcAd.PhECU_plocs       = NULL;
+            plcAd.PhECU_fg_wintaper = NULL;
+            plcAd.PhECU_win_pre_tda = NULL;
+            snapshot_put(data, &pos, &plcAd, sizeof(plcAd));
+        }
+    }
+
+    for (ch = 0; ch < decoder->channels; ch++)
+    {
+        n = dec_snapshot_buffers(decoder, ch, buf, len);
+        for (i = 0; i < n; i++)
+            snapshot_put(data, &pos, buf[i], len[i]);
+    }
+
+    return pos;
+}
+
 /* encoder functions *********************************************************/
 
 LC3_Error lc3_enc_init(LC3_Enc *encoder, int samplerate, int channels)
@@ -139,7 +284,7 @@ int lc3_enc_get_scratch_size(const LC3_Enc *encoder)
 {
     int size = 0;
     RETURN_IF(encoder == NULL, 0);
-    size = 14 * MAX(encoder->frame_length, 160) + 64;
+    size = DYN_ENC_SCRATCH_SIZE(encoder->frame_length);
     assert(size <= LC3_ENC_MAX_SCRATCH_SIZE);
     return size;
 }
@@ -233,6 +378,99 @@ LC3_Error lc3_enc_set_bandwidth(LC3_Enc *encoder, int bandwidth)
     return LC3_OK;
 }
 
+LC3_Error lc3_enc_set_complexity(LC3_Enc *encoder, LC3_EncComplexity level)
+{
+    int ch = 0;
+
+    RETURN_IF(encoder == NULL, LC3_NULL_ERROR);
+    RETURN_IF((unsigned)level > LC3_ENC_COMPLEXITY_MINIMAL, LC3_ERROR);
+    for (ch = 0; ch < encoder->channels; ch++)
+    {
+        encoder->channel_setup[ch]->silence_bytes = 0;
+        /* the time domain tools did not run, their delay lines are from before */
+        if (encoder->complexity == LC3_ENC_COMPLEXITY_MINIMAL && level != LC3_ENC_COMPLEXITY_MINIMAL)
+        {
+            reset_enc_pitch_state(encoder->channel_setup[ch]);
+        }
+    }
+    encoder->complexity = level;
+    return LC3_OK;
+}
+
+int lc3_enc_get_silence_cache_size(const LC3_Enc *encoder)
+{
+    RETURN_IF(encoder == NULL, 0);
+    return encoder->channels * MAX_NBYTES;
+}
+
+LC3_Error lc3_enc_set_silence_cache(LC3_Enc *encoder, void *buffer)
+{
+    int ch = 0;
+
+    RETURN_IF(encoder == NULL, LC3_NULL_ERROR);
+    RETURN_IF((uintptr_t)buffer % 4 != 0, LC3_ALIGN_ERROR);
+    encoder->silence_cache = buffer;
+    for (ch = 0; ch < encoder->channels; ch++)
+    {
+        encoder->channel_setup[ch]->silence_bytes = 0;
+    }
+    return LC3_OK;
+}
+
+int lc3_enc_get_snapshot_size(const LC3_Enc *encoder)
+{
+    RETURN_IF(encoder == NULL, 0);
+    return (int)sizeof(SnapshotHeader) + snapshot_enc_data(encoder, NULL);
+}
+
+LC3_Error lc3_enc_snapshot(const LC3_Enc *encoder, void *snapshot, int size)
+{
+    int state_size = 0;
+    RETURN_IF(encoder == NULL || snapshot == NULL, LC3_NULL_ERROR);
+    RETURN_IF((uintptr_t)snapshot % 4 != 0, LC3_ALIGN_ERROR);
+    RETURN_IF(size < lc3_enc_get_snapshot_size(encoder), LC3_ERROR);
+
+    state_size = snapshot_enc_data(encoder, (SnapshotHeader *)snapshot + 1);
+    snapshot_header(snapshot, encoder->fs_in, encoder->channels, 0, state_size);
+    return LC3_OK;
+}
+
+LC3_Error lc3_enc_restore(LC3_Enc *encoder, const void *snapshot, int size)
+{
+    int                   ch = 0, i = 0, n = 0, pos = 0;
+    int                   len[MAX_SNAPSHOT_BUFFERS];
+    void *                buf[MAX_SNAPSHOT_BUFFERS];
+    const SnapshotHeader *hdr  = snapshot;
+    const void *          data = hdr + 1;
+    LC3_Enc               enc;
+    RETURN_IF(encoder == NULL || snapshot == NULL, LC3_NULL_ERROR);
+    RETURN_IF((uintptr_t)snapshot % 4 != 0, LC3_ALIGN_ERROR);
+    RETURN_IF(!snapshot_valid(hdr, size, encoder->fs_in, encoder->channels, 0), LC3_ERROR);
+
+    RETURN_IF(!snapshot_get(data, &pos, hdr->size, &enc, sizeof(enc)), LC3_ERROR);
+    RETURN_IF(enc.fs_in != encoder->fs_in || enc.channels != encoder->channels, LC3_ERROR);
+    RETURN_IF(!lc3_frame_size_supported(enc.frame_dms / 10.0f), LC3_ERROR);
+    RETURN_IF((unsigned)enc.complexity > LC3_ENC_COMPLEXITY_MINIMAL, LC3_ERROR);
+    RETURN_IF(hdr->size - pos < encoder->channels * (int)sizeof(EncSetup), LC3_ERROR);
+
+    for (ch = 0; ch < encoder->channels; ch++)
+        snapshot_get(data, &pos, hdr->size, encoder->channel_setup[ch], sizeof(EncSetup));
+
+    enc.silence_cache = encoder->silence_cache; /* the silence cache belongs to the restoring side */
+    *encoder          = enc;
+    alloc_encoder(encoder, encoder->fs_in, encoder->channels); /* rebuild channel pointers */
+    set_enc_frame_params(encoder);                              /* rebuild table pointers */
+
+    for (ch = 0; ch < encoder->channels; ch++)
+    {
+        n = enc_snapshot_buffers(encoder, ch, buf, len);
+        for (i = 0; i < n; i++)
+            RETURN_IF(!snapshot_get(data, &pos, hdr->size, buf[i], len[i]), LC3_ERROR);
+    }
+    RETURN_IF(pos != hdr->size, LC3_ERROR);
+    return LC3_OK;
+}
+
 static LC3_Error lc3_enc(LC3_Enc *encoder, void **input_samples, int bitdepth, void *output_bytes, int *num_bytes,
                          void *scratch)
 {
@@ -240,7 +478,7 @@ static LC3_Error lc3_enc(LC3_Enc *encoder, void **input_samples, int bitdepth, v
     RETURN_IF(null_in_list(input_samples, encoder->channels), LC3_NULL_ERROR);
     RETURN_IF(bitdepth != 16 && bitdepth != 24, LC3_ERROR);
     RETURN_IF(!encoder->lc3_br_set, LC3_BITRATE_UNSET_ERROR);
-    *num_bytes = Enc_LC3(encoder, input_samples, bitdepth, output_bytes, scratch, *num_bytes == -1);
+    *num_bytes = Enc_LC3(encoder, input_samples, bitdepth, NULL, output_bytes, scratch, *num_bytes == -1);
     assert(*num_bytes == lc3_enc_get_num_bytes(encoder));
     return LC3_OK;
 }
@@ -255,6 +493,28 @@ LC3_Error lc3_enc24(LC3_Enc *encoder, int32_t **input_samples, void *output_byte
     return lc3_enc(encoder, (void **)input_samples, 24, output_bytes, num_bytes, scratch);
 }
 
+static LC3_Error lc3_enc_nbytes(LC3_Enc *encoder, void **input_samples, int bitdepth, int nbytes, void *output_bytes,
+                                int *num_bytes, void *scratch)
+{
+    LC3_Error err = LC3_OK;
+    RETURN_IF(!encoder || !num_bytes, LC3_NULL_ERROR);
+    err = update_enc_nbytes(encoder, nbytes);
+    RETURN_IF(err != LC3_OK, err);
+    return lc3_enc(encoder, input_samples, bitdepth, output_bytes, num_bytes, scratch);
+}
+
+LC3_Error lc3_enc16_nbytes(LC3_Enc *encoder, int16_t **input_samples, int nbytes, void *output_bytes, int *num_bytes,
+                           void *scratch)
+{
+    return lc3_enc_nbytes(encoder, (void **)input_samples, 16, nbytes, output_bytes, num_bytes, scratch);
+}
+
+LC3_Error lc3_enc24_nbytes(LC3_Enc *encoder, int32_t **input_samples, int nbytes, void *output_bytes, int *num_bytes,
+                           void *scratch)
+{
+    return lc3_enc_nbytes(encoder, (void **)input_samples, 24, nbytes, output_bytes, num_bytes, scratch);
+}
+
 /* decoder functions *********************************************************/
 
 LC3_Error lc3_dec_init(LC3_Dec *decoder, int samplerate, int channels, LC3_PlcMode plc_mode)
@@ -278,10 +538,10 @@ int lc3_dec_get_scratch_size(const LC3_Dec *decoder)
 {
     int size = 0;
     RETURN_IF(decoder == NULL, 0);
-    size = 12 * DYN_MAX_LEN(decoder->fs) + 752;
-    if (decoder->plcMeth != LC3_PLC_STANDARD)
-        size += 2 * MAX_LGW + 8 * DYN_MAX_LPROT(decoder->fs) + 8 * DYN_MAX_LEN(decoder->fs);
+    size = dec_channel_scratch_size(decoder, 0);
     assert(size <= LC3_DEC_MAX_SCRATCH_SIZE);
+    if (decoder->parallel_for)
+        size = decoder->channels * dec_channel_scratch_size(decoder, 1);
     return size;
 }
 
@@ -299,6 +559,149 @@ int lc3_dec_get_error_report(const LC3_Dec *decoder)
     return decoder->error_report;
 }
 
+/* scratch arena functions ***************************************************/
+
+int lc3_scratch_arena_get_size(int samplerate, int channels)
+{
+    RETURN_IF(!lc3_samplerate_supported(samplerate), 0);
+    RETURN_IF(!lc3_channels_supported(channels), 0);
+    return alloc_scratch_arena(NULL, samplerate, channels);
+}
+
+LC3_Error lc3_scratch_arena_init(LC3_ScratchArena *arena, int samplerate, int channels)
+{
+    RETURN_IF(arena == NULL, LC3_NULL_ERROR);
+    RETURN_IF((uintptr_t)arena % 4 != 0, LC3_ALIGN_ERROR);
+    RETURN_IF(!lc3_samplerate_supported(samplerate), LC3_SAMPLERATE_ERROR);
+    RETURN_IF(!lc3_channels_supported(channels), LC3_CHANNELS_ERROR);
+    return FillScratchArena(arena, samplerate, channels);
+}
+
+void *lc3_scratch_arena_get(LC3_ScratchArena *arena)
+{
+    RETURN_IF(arena == NULL, NULL);
+    scratch_arena_begin(arena);
+    return arena->scratch;
+}
+
+LC3_Error lc3_scratch_arena_check(const LC3_ScratchArena *arena)
+{
+    RETURN_IF(arena == NULL, LC3_NULL_ERROR);
+    return scratch_arena_check(arena) ? LC3_ERROR : LC3_OK;
+}
+
+int lc3_dec_get_speculation_size(const LC3_Dec *decoder)
+{
+    RETURN_IF(decoder == NULL, 0);
+    return alloc_dec_speculation(NULL, NULL, decoder->fs_out, decoder->channels, (LC3_PlcMode)decoder->plcMeth);
+}
+
+LC3_Error lc3_dec_set_speculation(LC3_Dec *decoder, void *buffer)
+{
+    RETURN_IF(decoder == NULL, LC3_NULL_ERROR);
+    RETURN_IF((uintptr_t)buffer % 4 != 0, LC3_ALIGN_ERROR);
+    decoder->spec_state = NULL;
+    decoder->spec_pcm   = NULL;
+    decoder->spec_bits  = 0;
+    if (buffer)
+        alloc_dec_speculation(decoder, buffer, decoder->fs_out, decoder->channels, (LC3_PlcMode)decoder->plcMeth);
+    return LC3_OK;
+}
+
+LC3_Error lc3_dec_set_parallel(LC3_Dec *decoder, LC3_ParallelFor parallel_for, void *user)
+{
+    RETURN_IF(decoder == NULL, LC3_NULL_ERROR);
+    decoder->parallel_for  = parallel_for;
+    decoder->parallel_user = user;
+    return LC3_OK;
+}
+
+int lc3_jitter_get_size(int samplerate, float frame_ms, int max_delay_ms, int max_bytes)
+{
+    RETURN_IF(!lc3_samplerate_supported(samplerate), 0);
+    RETURN_IF(!lc3_frame_size_supported(frame_ms), 0);
+    RETURN_IF(max_delay_ms <= 0 || max_delay_ms > JB_MAX_DELAY_MS, 0);
+    RETURN_IF(max_bytes <= 0 || max_bytes > LC3_MAX_CHANNELS * LC3_MAX_BYTES, 0);
+    return alloc_jitter_buffer(NULL, samplerate, (int)(frame_ms * 10), max_delay_ms, max_bytes);
+}
+
+LC3_Error lc3_jitter_init(LC3_JitterBuffer *jb, int samplerate, float frame_ms, int max_delay_ms, int max_bytes)
+{
+    RETURN_IF(jb == NULL, LC3_NULL_ERROR);
+    RETURN_IF((uintptr_t)jb % 4 != 0, LC3_ALIGN_ERROR);
+    RETURN_IF(!lc3_samplerate_supported(samplerate), LC3_SAMPLERATE_ERROR);
+    RETURN_IF(!lc3_frame_size_supported(frame_ms), LC3_FRAMEMS_ERROR);
+    RETURN_IF(max_delay_ms <= 0 || max_delay_ms > JB_MAX_DELAY_MS, LC3_ERROR);
+    RETURN_IF(max_bytes <= 0 || max_bytes > LC3_MAX_CHANNELS * LC3_MAX_BYTES, LC3_NUMBYTES_ERROR);
+    return FillJitterBuffer(jb, samplerate, (int)(frame_ms * 10), max_delay_ms, max_bytes);
+}
+
+LC3_Error lc3_jitter_set_target_loss(LC3_JitterBuffer *jb, float loss)
+{
+    RETURN_IF(jb == NULL, LC3_NULL_ERROR);
+    RETURN_IF(!(loss > 0 && loss <= 0.5f), LC3_ERROR);
+    jb->loss = MAX((int32_t)(loss * 32768 + 0.5f), 1);
+    return LC3_OK;
+}
+
+LC3_Error lc3_jitter_set_timestamp_step(LC3_JitterBuffer *jb, int32_t step)
+{
+    RETURN_IF(jb == NULL, LC3_NULL_ERROR);
+    RETURN_IF(step <= 0, LC3_ERROR);
+    jb->ts_step = step;
+    jitter_buffer_reset(jb);
+    return LC3_OK;
+}
+
+LC3_Error lc3_jitter_put(LC3_JitterBuffer *jb, int32_t timestamp, int32_t arrival_us, const void *bytes, int num_bytes)
+{
+    RETURN_IF(jb == NULL || bytes == NULL, LC3_NULL_ERROR);
+    RETURN_IF(num_bytes <= 0 || num_bytes > jb->max_bytes, LC3_NUMBYTES_ERROR);
+    jitter_buffer_put(jb, (uint32_t)timestamp, (uint32_t)arrival_us, (const uint8_t *)bytes, num_bytes);
+    return LC3_OK;
+}
+
+LC3_Error lc3_jitter_get(LC3_JitterBuffer *jb, int32_t now_us, void *bytes, int *num_bytes)
+{
+    uint8_t *data = NULL;
+    RETURN_IF(jb == NULL || bytes == NULL || num_bytes == NULL, LC3_NULL_ERROR);
+    jitter_buffer_pop(jb, (uint32_t)now_us, &data, num_bytes);
+    memcpy(bytes, data, *num_bytes);
+    return LC3_OK;
+}
+
+static LC3_Error lc3_jitter_dec(LC3_JitterBuffer *jb, LC3_Dec *decoder, int32_t now_us, void **output_samples,
+                                int bitdepth, void *scratch)
+{
+    uint8_t *data      = NULL;
+    int      num_bytes = 0;
+    RETURN_IF(jb == NULL, LC3_NULL_ERROR);
+    RETURN_IF(!decoder || !output_samples || !scratch, LC3_NULL_ERROR);
+    RETURN_IF(null_in_list(output_samples, decoder->channels), LC3_NULL_ERROR);
+    jitter_buffer_pop(jb, (uint32_t)now_us, &data, &num_bytes);
+    /* the frame is decoded in place, error correction may alter it */
+    return Dec_LC3(decoder, data, num_bytes, output_samples, bitdepth, NULL, scratch, num_bytes == 0);
+}
+
+LC3_Error lc3_jitter_dec16(LC3_JitterBuffer *jb, LC3_Dec *decoder, int32_t now_us, int16_t **output_samples,
+                           void *scratch)
+{
+    return lc3_jitter_dec(jb, decoder, now_us, (void **)output_samples, 16, scratch);
+}
+
+LC3_Error lc3_jitter_dec24(LC3_JitterBuffer *jb, LC3_Dec *decoder, int32_t now_us, int32_t **output_samples,
+                           void *scratch)
+{
+    return lc3_jitter_dec(jb, decoder, now_us, (void **)output_samples, 24, scratch);
+}
+
+LC3_Error lc3_jitter_get_stats(const LC3_JitterBuffer *jb, LC3_JitterStats *stats)
+{
+    RETURN_IF(jb == NULL || stats == NULL, LC3_NULL_ERROR);
+    *stats = jb->stats;
+    return LC3_OK;
+}
+
 LC3_EpModeRequest lc3_dec_get_ep_mode_request(const LC3_Dec *decoder)
 {
     RETURN_IF(decoder == NULL, LC3_EPMR_ZERO);
@@ -310,8 +713,12 @@ LC3_Error lc3_dec_set_frame_ms(LC3_Dec *decoder, float frame_ms)
     RETURN_IF(decoder == NULL, LC3_NULL_ERROR);
     RETURN_IF(!lc3_frame_size_supported(frame_ms), LC3_FRAMEMS_ERROR);
     RETURN_IF(decoder->plcMeth == 2 && frame_ms != 10, LC3_FRAMEMS_ERROR);
+#if BTLLC_5MS_MODE
+    RETURN_IF(frame_ms > 5, LC3_FRAMEMS_ERROR); /* the decoder history is sized for 5 ms frames */
+#endif
 
     decoder->frame_dms = (int)(frame_ms * 10);
+    decoder->spec_bits = 0;
     set_dec_frame_params(decoder);
     return LC3_OK;
 }
@@ -328,13 +735,100 @@ int lc3_dec_get_delay(const LC3_Dec *decoder)
     return decoder->frame_length - 2 * decoder->la_zeroes;
 }
 
+int lc3_dec_get_snapshot_size(const LC3_Dec *decoder)
+{
+    RETURN_IF(decoder == NULL, 0);
+    return (int)sizeof(SnapshotHeader) + snapshot_dec_data(decoder, NULL);
+}
+
+LC3_Error lc3_dec_snapshot(const LC3_Dec *decoder, void *snapshot, int size)
+{
+    int state_size = 0;
+    RETURN_IF(decoder == NULL || snapshot == NULL, LC3_NULL_ERROR);
+    RETURN_IF((uintptr_t)snapshot % 4 != 0, LC3_ALIGN_ERROR);
+    RETURN_IF(size < lc3_dec_get_snapshot_size(decoder), LC3_ERROR);
+
+    state_size = snapshot_dec_data(decoder, (SnapshotHeader *)snapshot + 1);
+    snapshot_header(snapshot, decoder->fs_out, decoder->channels, (LC3_PlcMode)decoder->plcMeth, state_size);
+    return LC3_OK;
+}
+
+LC3_Error lc3_dec_restore(LC3_Dec *decoder, const void *snapshot, int size)
+{
+    int                   ch = 0, i = 0, n = 0, pos = 0, images = 0;
+    int                   len[MAX_SNAPSHOT_BUFFERS];
+    void *                buf[MAX_SNAPSHOT_BUFFERS];
+    const SnapshotHeader *hdr      = snapshot;
+    const void *          data     = hdr + 1;
+    LC3_PlcMode           plc_mode = LC3_PLC_STANDARD;
+    LC3_Dec               dec;
+    RETURN_IF(decoder == NULL || snapshot == NULL, LC3_NULL_ERROR);
+    RETURN_IF((uintptr_t)snapshot % 4 != 0, LC3_ALIGN_ERROR);
+
+    plc_mode = (LC3_PlcMode)decoder->plcMeth;
+    RETURN_IF(!snapshot_valid(hdr, size, decoder->fs_out, decoder->channels, plc_mode), LC3_ERROR);
+
+    RETURN_IF(!snapshot_get(data, &pos, hdr->size, &dec, sizeof(dec)), LC3_ERROR);
+    RETURN_IF(dec.fs_out != decoder->fs_out || dec.channels != decoder->channels, LC3_ERROR);
+    RETURN_IF(dec.plcMeth != decoder->plcMeth, LC3_ERROR);
+    RETURN_IF(!lc3_frame_size_supported(dec.frame_dms / 10.0f), LC3_ERROR);
+    RETURN_IF(dec.plcMeth == 2 && dec.frame_dms != 100, LC3_ERROR);
+    images = sizeof(DecSetup) + (decoder->plcMeth != LC3_PLC_STANDARD ? sizeof(AplcSetup) : 0);
+    RETURN_IF(hdr->size - pos < decoder->channels * images, LC3_ERROR);
+
+    /* the speculation buffer and job runner belong to the restoring side */
+    dec.spec_state    = decoder->spec_state;
+    dec.spec_pcm      = decoder->spec_pcm;
+    dec.parallel_for  = decoder->parallel_for;
+    dec.parallel_user = decoder->parallel_user;
+
+    for (ch = 0; ch < decoder->channels; ch++)
+    {
+        DecSetup * setup = decoder->channel_setup[ch];
+        AplcSetup *plcAd = setup->plcAd;
+        snapshot_get(data, &pos, hdr->size, setup, sizeof(*setup));
+        if (plcAd)
+            snapshot_get(data, &pos, hdr->size, plcAd, sizeof(*plcAd));
+    }
+
+    *decoder = dec;
+    alloc_decoder(decoder, decoder->fs_out, decoder->channels, plc_mode); /* rebuild channel pointers */
+    set_dec_frame_params(decoder);                                        /* rebuild table pointers */
+
+    for (ch = 0; ch < decoder->channels; ch++)
+    {
+        n = dec_snapshot_buffers(decoder, ch, buf, len);
+        for (i = 0; i < n; i++)
+            RETURN_IF(!snapshot_get(data, &pos, hdr->size, buf[i], len[i]), LC3_ERROR);
+    }
+    RETURN_IF(pos != hdr->size, LC3_ERROR);
+    return LC3_OK;
+}
+
 static LC3_Error lc3_dec(LC3_Dec *decoder, void *input_bytes, int num_bytes, void **output_samples, int bitdepth,
                          void *scratch, int bfi_ext)
 {
     RETURN_IF(!decoder || !input_bytes || !output_samples || !scratch, LC3_NULL_ERROR);
     RETURN_IF(null_in_list(output_samples, decoder->channels), LC3_NULL_ERROR);
     RETURN_IF(bitdepth != 16 && bitdepth != 24, LC3_ERROR);
-    return Dec_LC3(decoder, input_bytes, num_bytes, output_samples, bitdepth, scratch, bfi_ext);
+    return Dec_LC3(decoder, input_bytes, num_bytes, output_samples, bitdepth, NULL, scratch, bfi_ext);
+}
+
+static LC3_Error lc3_dec_speculate(LC3_Dec *decoder, int bitdepth, void *scratch)
+{
+    RETURN_IF(!decoder || !scratch, LC3_NULL_ERROR);
+    RETURN_IF(decoder->spec_state == NULL, LC3_ERROR);
+    return Dec_LC3_Speculate(decoder, bitdepth, scratch);
+}
+
+LC3_Error lc3_dec16_speculate(LC3_Dec *decoder, void *scratch)
+{
+    return lc3_dec_speculate(decoder, 16, scratch);
+}
+
+LC3_Error lc3_dec24_speculate(LC3_Dec *decoder, void *scratch)
+{
+    return lc3_dec_speculate(decoder, 24, scratch);
 }
 
 LC3_Error lc3_dec16(LC3_Dec *decoder, void *input_bytes, int num_bytes, int16_t **output_samples, void *scratch, int bfi_ext)
@@ -346,3 +840,74 @@ LC3_Error lc3_dec24(LC3_Dec *decoder, void *input_bytes, int num_bytes, int32_t
 {
     return lc3_dec(decoder, input_bytes, num_bytes, (void **)output_samples, 24, scratch, bfi_ext);
 }
+
+/* mixing functions **********************************************************/
+
+LC3_Error lc3_dec_spectrum(LC3_Dec *decoder, void *input_bytes, int num_bytes, int32_t **spectrum, int *exponent,
+                           void *scratch)
+{
+    int       ch = 0;
+    Word16    spec_exp[MAX_CHANNELS];
+    LC3_Error err = LC3_OK;
+    RETURN_IF(!decoder || !input_bytes || !spectrum || !exponent || !scratch, LC3_NULL_ERROR);
+    RETURN_IF(null_in_list((void **)spectrum, decoder->channels), LC3_NULL_ERROR);
+
+    err = Dec_LC3(decoder, input_bytes, num_bytes, (void **)spectrum, 0, spec_exp, scratch, 0);
+    RETURN_IF(err != LC3_OK && err != LC3_DECODE_ERROR, err);
+    for (ch = 0; ch < decoder->channels; ch++)
+    {
+        exponent[ch] = spec_exp[ch];
+    }
+    return err;
+}
+
+LC3_Error lc3_enc_spectrum(LC3_Enc *encoder, int32_t **spectrum, const int *exponent, void *output_bytes,
+                           int *num_bytes, void *scratch)
+{
+    int    ch = 0;
+    Word16 spec_exp[MAX_CHANNELS];
+    RETURN_IF(!encoder || !spectrum || !exponent || !output_bytes || !num_bytes || !scratch, LC3_NULL_ERROR);
+    RETURN_IF(null_in_list((void **)spectrum, encoder->channels), LC3_NULL_ERROR);
+    RETURN_IF(!encoder->lc3_br_set, LC3_BITRATE_UNSET_ERROR);
+
+    for (ch = 0; ch < encoder->channels; ch++)
+    {
+        RETURN_IF(exponent[ch] < -128 || exponent[ch] > 128, LC3_ERROR);
+        spec_exp[ch] = (Word16)exponent[ch];
+    }
+    *num_bytes = Enc_LC3(encoder, (void **)spectrum, 0, spec_exp, output_bytes, scratch, 0);
+    assert(*num_bytes == lc3_enc_get_num_bytes(encoder));
+    return LC3_OK;
+}
+
+LC3_Error lc3_spectrum_mix(int32_t *mix, int *mix_exponent, const int32_t *spectrum, int exponent, float gain,
+                           int length)
+{
+    int    gain_exp = 0, gain_q15 = 0;
+    Word16 mix_exp = 0;
+    RETURN_IF(!mix || !mix_exponent || !spectrum, LC3_NULL_ERROR);
+    RETURN_IF(length <= 0 || length > LC3_MAX_SAMPLES, LC3_ERROR);
+    RETURN_IF(exponent < -128 || exponent > 128 || *mix_exponent < -128 || *mix_exponent > 128, LC3_ERROR);
+    RETURN_IF(!(gain > -65536.0f && gain < 65536.0f), LC3_ERROR);
+
+    /* gain = gain_q15 * 2^(gain_exp - 15) */
+    gain_q15 = MIN((int)(frexpf(gain, &gain_exp) * 32768), 32767);
+    mix_exp  = (Word16)*mix_exponent;
+    processSpectrumMix_fx((Word32 *)mix, &mix_exp, (const Word32 *)spectrum, (Word16)exponent, (Word16)gain_q15,
+                          (Word16)gain_exp, (Word16)length);
+    *mix_exponent = mix_exp;
+    return LC3_OK;
+}
+
+/* transrating functions *****************************************************/
+
+LC3_Error lc3_transrate(LC3_Enc *encoder, LC3_Dec *decoder, void *input_bytes, int num_bytes, void *output_bytes,
+                        int *num_bytes_out, void *scratch)
+{
+    RETURN_IF(!encoder || !decoder || !input_bytes || !output_bytes || !num_bytes_out || !scratch, LC3_NULL_ERROR);
+    RETURN_IF(!encoder->lc3_br_set, LC3_BITRATE_UNSET_ERROR);
+    RETURN_IF(encoder->fs != decoder->fs || encoder->yLen != decoder->yLen, LC3_SAMPLERATE_ERROR);
+    RETURN_IF(encoder->frame_dms != decoder->frame_dms, LC3_FRAMEMS_ERROR);
+    RETURN_IF(encoder->channels != decoder->channels, LC3_CHANNELS_ERROR);
+    return Transrate_LC3(encoder, decoder, input_bytes, num_bytes, output_bytes, num_bytes_out, scratch);
+}
@@ -55,10 +55,14 @@ typedef __int32 int32_t;
 #define LC3_DEC_MAX_SIZE 20352
 
 /*! Maximum scratch size needed by lc3_enc16() or lc3_enc24().*/
-#define LC3_ENC_MAX_SCRATCH_SIZE 6784
+#define LC3_ENC_MAX_SCRATCH_SIZE 6848
 
 /*! Maximum scratch size needed by lc3_dec16() or lc3_dec24(). */
-#define LC3_DEC_MAX_SCRATCH_SIZE 16514  /* to BE corrected */
+#define LC3_DEC_MAX_SCRATCH_SIZE 16578  /* to BE corrected */
+
+/*! Alignment of the scratch memory returned by lc3_scratch_arena_get() and of the MDCT / IMDCT work
+ *  buffers carved from any scratch memory. */
+#define LC3_SCRATCH_ALIGN 64
 
 /*! Decoder packet loss concealment mode */
 typedef enum
@@ -67,6 +71,29 @@ typedef enum
     LC3_PLC_ADVANCED = 1  /*!< Enhanced concealment method */
 } LC3_PlcMode;
 
+/*! Encoder complexity level. Higher levels skip optional analysis stages to save CPU cycles at
+ *  the cost of quality. All levels produce standard compliant bitstreams. The quantizer always
+ *  runs its rate loop and residual coding, they take a few percent of the encoder only. The
+ *  pitch lag range is not reduced at any level, the open loop pitch search takes about 2% of the
+ *  encoder and a shorter range gives octave errors on low voices.
+ *
+ *  Encode time relative to LC3_ENC_COMPLEXITY_FULL and segmental SNR at 64 / 240 kbps, measured
+ *  with msvc/Test.wav, 48 kHz stereo, 5 ms frames:
+ *
+ *      FULL       100%    32.9 dB / 72.9 dB
+ *      LOW         82%    36.6 dB / 68.9 dB
+ *      MINIMAL     72%    38.3 dB / 68.3 dB
+ *
+ *  SNR does not weight the noise perceptually. TNS and LTPF shape the noise under the signal,
+ *  so at low bitrates the SNR goes up when they are disabled. */
+typedef enum
+{
+    LC3_ENC_COMPLEXITY_FULL    = 0, /*!< All encoder tools enabled */
+    LC3_ENC_COMPLEXITY_LOW     = 1, /*!< TNS disabled */
+    LC3_ENC_COMPLEXITY_MINIMAL = 2  /*!< As LC3_ENC_COMPLEXITY_LOW and no resampler, pitch
+                                         analysis, LTPF or attack detector */
+} LC3_EncComplexity;
+
 /*! Error protection mode. LC3_EP_ZERO differs to LC3_EP_OFF in that
  *  errors can be detected but not corrected. */
 typedef enum
@@ -124,6 +151,30 @@ typedef enum
 
 typedef struct LC3_Enc LC3_Enc; /*!< Opaque encoder struct. */
 typedef struct LC3_Dec LC3_Dec; /*!< Opaque decoder struct. */
+typedef struct LC3_ScratchArena LC3_ScratchArena; /*!< Opaque scratch arena. */
+typedef struct LC3_JitterBuffer LC3_JitterBuffer; /*!< Opaque adaptive jitter buffer. */
+
+/*! Jitter buffer statistics, see lc3_jitter_get_stats(). Counters start at lc3_jitter_init(),
+ *  delays are in microseconds. The playout delay is measured from the fastest frame of the last
+ *  two seconds, so it is the delay added by the jitter buffer on top of the minimum network delay. */
+typedef struct
+{
+    int32_t received;     /*!< Frames put into the buffer, duplicates not included */
+    int32_t late;         /*!< Frames that arrived after their deadline and were concealed */
+    int32_t dropped;      /*!< Duplicates and frames too far off the playout position */
+    int32_t played;       /*!< Frames handed to the decoder */
+    int32_t concealed;    /*!< Frames missing at their deadline, concealed as lost */
+    int32_t stretched;    /*!< Concealed frames inserted to raise the playout delay */
+    int32_t skipped;      /*!< Frames dropped to lower the playout delay */
+    int32_t resyncs;      /*!< Restarts after a timestamp discontinuity */
+    int32_t delay;        /*!< Playout delay at the last deadline */
+    int32_t target;       /*!< Target playout delay */
+    int32_t buffer_delay; /*!< Mean time the played frames spent in the buffer */
+} LC3_JitterStats;
+
+/*! Job runner for parallel decoding. It has to call job(ctx, i) for i = 0 .. njobs - 1, possibly
+ *  concurrently, and return when all calls have returned. See lc3_dec_set_parallel(). */
+typedef void (*LC3_ParallelFor)(void *user, void (*job)(void *ctx, int index), void *ctx, int njobs);
 
 /*! \addtogroup Misc
  *  \{ */
@@ -145,6 +196,44 @@ int lc3_channels_supported(int channels);
  */
 int lc3_samplerate_supported(int samplerate);
 
+/*! Get the size of a scratch arena. One arena can serve as scratch memory for all encoders and
+ *  decoders of up to the given samplerate and number of channels that are run from the same
+ *  thread, since scratch memory does not persist between function calls. This includes decoders
+ *  with a job runner set by lc3_dec_set_parallel(), which need one scratch slice per channel.
+ *
+ *  \param[in]  samplerate  Highest sampling rate of the encoders and decoders using the arena.
+ *  \param[in]  channels    Highest number of channels of the decoders using the arena.
+ *  \return                 Size in bytes or 0 on error.
+ */
+int lc3_scratch_arena_get_size(int samplerate, int channels);
+
+/*! Initialize a scratch arena.
+ *
+ *  \param[out] arena       Pointer to allocated memory of lc3_scratch_arena_get_size() bytes.
+ *  \param[in]  samplerate  Highest sampling rate of the encoders and decoders using the arena.
+ *  \param[in]  channels    Highest number of channels of the decoders using the arena.
+ *  \return                 LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_scratch_arena_init(LC3_ScratchArena *arena, int samplerate, int channels);
+
+/*! Get the scratch memory of an arena, aligned to LC3_SCRATCH_ALIGN bytes. It can be passed as
+ *  scratch to any lc3_enc16(), lc3_enc24(), lc3_dec16() or lc3_dec24() call of the thread owning
+ *  the arena. If the library is built with DEBUG_SCRATCH the memory is poisoned on every call.
+ *
+ *  \param[in]  arena       Arena initialized by lc3_scratch_arena_init().
+ *  \return                 Pointer to scratch memory or NULL on error.
+ */
+void *lc3_scratch_arena_get(LC3_ScratchArena *arena);
+
+/*! Check the arena after an encoder or decoder call. If the library is built with DEBUG_SCRATCH
+ *  this detects scratch regions carved outside of the arena or into each other and writes past
+ *  its end. Only calls on the thread that got the arena are checked. Otherwise it always succeeds.
+ *
+ *  \param[in]  arena       Arena initialized by lc3_scratch_arena_init().
+ *  \return                 LC3_OK on success or LC3_ERROR if the arena was overrun.
+ */
+LC3_Error lc3_scratch_arena_check(const LC3_ScratchArena *arena);
+
 /*! \}
  *  \addtogroup Encoder
  *  \{ */
@@ -194,6 +283,25 @@ LC3_Error lc3_enc16(LC3_Enc *encoder, int16_t **input_samples, void *output_byte
  */
 LC3_Error lc3_enc24(LC3_Enc *encoder, int32_t **input_samples, void *output_bytes, int *num_bytes, void *scratch);
 
+/*! Encode LC3 frame with 16 bit input into a given number of bytes.
+ *
+ *  The byte count replaces the bitrate set by lc3_enc_set_bitrate() for this and all following
+ *  frames. Switching the byte count is a constant time operation, so it can change every frame.
+ *  Only available with error protection disabled. See lc3_enc16() for the other parameters.
+ *
+ *  \param[in]  nbytes          Number of bytes of the encoded frame for all channels.
+ *  \return                     LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_enc16_nbytes(LC3_Enc *encoder, int16_t **input_samples, int nbytes, void *output_bytes, int *num_bytes,
+                           void *scratch);
+
+/*! Encode LC3 frame with 24 bit input into a given number of bytes.
+ *
+ *  See lc3_enc16_nbytes() for parameter documentation.
+ */
+LC3_Error lc3_enc24_nbytes(LC3_Enc *encoder, int32_t **input_samples, int nbytes, void *output_bytes, int *num_bytes,
+                           void *scratch);
+
 /*! Get the size of the LC3 encoder struct for a samplerate / channel configuration.
  *  If memory is not restricted LC3_ENC_MAX_SIZE can be used for all configurations.
  *
@@ -304,6 +412,69 @@ LC3_Error lc3_enc_set_ep_mode_request(LC3_Enc *encoder, LC3_EpModeRequest epmr);
  */
 LC3_Error lc3_enc_set_bandwidth(LC3_Enc* encoder, int bandwidth);
 
+/*! Set encoder complexity level. The default is LC3_ENC_COMPLEXITY_FULL. The level can be
+ *  changed between any two frames, e.g. to shed load when the system is overloaded, and the
+ *  decoder does not need to be notified. Note that without LTPF (LC3_ENC_COMPLEXITY_MINIMAL) the
+ *  decoder has no pitch information for concealment of following lost frames. Leaving
+ *  LC3_ENC_COMPLEXITY_MINIMAL restarts the resampler and pitch analysis from silence.
+ *
+ *  \param[in]  encoder     Encoder handle.
+ *  \param[in]  level       Complexity level.
+ *  \return                 LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_enc_set_complexity(LC3_Enc *encoder, LC3_EncComplexity level);
+
+/*! Get the size of the silence cache. It depends on the channels.
+ *
+ *  \param[in]  encoder     Encoder handle.
+ *  \return                 Size in bytes or 0 on error.
+ */
+int lc3_enc_get_silence_cache_size(const LC3_Enc *encoder);
+
+/*! Attach a silence cache to the encoder. On steady digital silence the encoder keeps the last
+ *  coded frame per channel and repeats it without running the codec stages. The output is the
+ *  same with and without the cache. The cache is off after lc3_enc_init() and stays attached
+ *  across lc3_enc_restore().
+ *
+ *  \param[in]  encoder     Encoder handle.
+ *  \param[in]  buffer      4-byte aligned buffer of lc3_enc_get_silence_cache_size() bytes, or
+ *                          NULL to detach the cache.
+ *  \return                 LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_enc_set_silence_cache(LC3_Enc *encoder, void *buffer);
+
+/*! Get the size of a snapshot of the encoder state. It depends on the samplerate, channels and
+ *  frame duration.
+ *
+ *  \param[in]  encoder     Encoder handle.
+ *  \return                 Size in bytes or 0 on error.
+ */
+int lc3_enc_get_snapshot_size(const LC3_Enc *encoder);
+
+/*! Save the encoder state. The snapshot holds the state with its pointers cleared and only the
+ *  part of the sample history that is needed for the next frame. The pointers are rebuilt by
+ *  lc3_enc_restore(), so the snapshot can be restored into another encoder, e.g. to migrate a
+ *  stream to another thread or host running the same library build, or to undo a trial encode.
+ *
+ *  \param[in]  encoder     Encoder handle.
+ *  \param[out] snapshot    4-byte aligned buffer of at least lc3_enc_get_snapshot_size() bytes.
+ *  \param[in]  size        Size of snapshot in bytes.
+ *  \return                 LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_enc_snapshot(const LC3_Enc *encoder, void *snapshot, int size);
+
+/*! Restore the encoder state from a snapshot. The encoder must have been initialized with the
+ *  samplerate and channels of the encoder the snapshot was taken from. A silence cache attached
+ *  with lc3_enc_set_silence_cache() stays attached.
+ *
+ *  \param[in]  encoder     Encoder handle.
+ *  \param[in]  snapshot    Snapshot written by lc3_enc_snapshot().
+ *  \param[in]  size        Size of snapshot in bytes.
+ *  \return                 LC3_OK on success, LC3_ERROR if the snapshot does not match. If
+ *                          the snapshot is damaged the encoder must be initialized again.
+ */
+LC3_Error lc3_enc_restore(LC3_Enc *encoder, const void *snapshot, int size);
+
 /*! \}
  *  \addtogroup Decoder
  *  \{ */
@@ -401,6 +572,8 @@ int lc3_dec_get_delay(const LC3_Dec *decoder);
 /*! Set the frame length for LC3 decoder. Allowed values are 10 (default), 7.5, 5, 2.5 ms.
  *  Not all lengths may be enabled, in that case LC3_FRAMEMS_ERROR is returned.
  *  This only works correcly if the encoder was configured with the same vale.
+ *  Builds with BTLLC_5MS_MODE keep the decoder history for 5 ms frames only, they have to be
+ *  set to 5 or 2.5 ms before the first frame.
  *
  *  \param[in]  decoder     Decoder handle.
  *  \param[in]  frame_ms    Frame length in ms.
@@ -451,5 +624,285 @@ LC3_EpModeRequest lc3_dec_get_ep_mode_request(const LC3_Dec *decoder);
  */
 int lc3_dec_get_error_report(const LC3_Dec *decoder);
 
+/*! Get the size of a snapshot of the decoder state. It depends on the samplerate, channels,
+ *  plc_mode and frame duration.
+ *
+ *  \param[in]  decoder     Decoder handle.
+ *  \return                 Size in bytes or 0 on error.
+ */
+int lc3_dec_get_snapshot_size(const LC3_Dec *decoder);
+
+/*! Save the decoder state. The snapshot holds the state with its pointers cleared and only the
+ *  part of the sample history that is needed for the next frame. The pointers are rebuilt by
+ *  lc3_dec_restore(), so the snapshot can be restored into another decoder running the same
+ *  library build.
+ *
+ *  \param[in]  decoder     Decoder handle.
+ *  \param[out] snapshot    4-byte aligned buffer of at least lc3_dec_get_snapshot_size() bytes.
+ *  \param[in]  size        Size of snapshot in bytes.
+ *  \return                 LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_dec_snapshot(const LC3_Dec *decoder, void *snapshot, int size);
+
+/*! Restore the decoder state from a snapshot. The decoder must have been initialized with the
+ *  samplerate, channels and plc_mode of the decoder the snapshot was taken from. A speculation
+ *  buffer set with lc3_dec_set_speculation() and a job runner set with lc3_dec_set_parallel()
+ *  stay attached, a pending speculatively concealed frame is discarded.
+ *
+ *  \param[in]  decoder     Decoder handle.
+ *  \param[in]  snapshot    Snapshot written by lc3_dec_snapshot().
+ *  \param[in]  size        Size of snapshot in bytes.
+ *  \return                 LC3_OK on success, LC3_ERROR if the snapshot does not match. If
+ *                          the snapshot is damaged the decoder must be initialized again.
+ */
+LC3_Error lc3_dec_restore(LC3_Dec *decoder, const void *snapshot, int size);
+
+/*! Get the size of the buffer needed for speculative concealment.
+ *
+ *  \param[in]  decoder     Decoder handle.
+ *  \return                 Size in bytes or 0 on error.
+ */
+int lc3_dec_get_speculation_size(const LC3_Dec *decoder);
+
+/*! Enable speculative concealment. After a good frame, lc3_dec16_speculate() or
+ *  lc3_dec24_speculate() conceal a loss of the next frame ahead of time. If the next frame is lost
+ *  the decoder only outputs the precomputed result, so a lost frame costs less than a good one.
+ *  The output is identical to concealing without speculation.
+ *
+ *  \param[in]  decoder     Decoder handle.
+ *  \param[in]  buffer      4-byte aligned buffer of lc3_dec_get_speculation_size() bytes or NULL to
+ *                          disable speculative concealment.
+ *  \return                 LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_dec_set_speculation(LC3_Dec *decoder, void *buffer);
+
+/*! Conceal a loss of the next frame ahead of time, e.g. from idle time after decoding a frame. The
+ *  result is used by the next call to lc3_dec16() if that frame is lost and discarded otherwise.
+ *  The function may run on another thread than the decoder but not concurrently with any other
+ *  call using the same decoder or scratch memory.
+ *
+ *  \param[in]  decoder     Decoder handle with speculation enabled by lc3_dec_set_speculation().
+ *  \param[in]  scratch     Scratch memory of lc3_dec_get_scratch_size() bytes.
+ *  \return                 LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_dec16_speculate(LC3_Dec *decoder, void *scratch);
+
+/*! Conceal a loss of the next frame ahead of time for lc3_dec24(). See lc3_dec16_speculate().
+ *
+ *  \param[in]  decoder     Decoder handle with speculation enabled by lc3_dec_set_speculation().
+ *  \param[in]  scratch     Scratch memory of lc3_dec_get_scratch_size() bytes.
+ *  \return                 LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_dec24_speculate(LC3_Dec *decoder, void *scratch);
+
+/*! Decode the channels of a frame in parallel. The bitstream of all channels is parsed first, in
+ *  order, so that a bit error detected in one channel conceals the following channels as in the
+ *  sequential decode. The synthesis of each channel is then handed to parallel_for as one job, and
+ *  every channel works on its own slice of the scratch memory. With a job runner set,
+ *  lc3_dec_get_scratch_size() grows by the number of channels and may exceed
+ *  LC3_DEC_MAX_SCRATCH_SIZE, a scratch arena has to be sized for the number of channels. The
+ *  output is identical to the sequential decode. Builds with complexity instrumentation (WMOPS)
+ *  decode the channels one after the other.
+ *
+ *  \param[in]  decoder         Decoder handle.
+ *  \param[in]  parallel_for    Job runner or NULL to decode the channels one after the other.
+ *  \param[in]  user            Passed on to parallel_for.
+ *  \return                     LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_dec_set_parallel(LC3_Dec *decoder, LC3_ParallelFor parallel_for, void *user);
+
+/*! \}
+ *  \addtogroup JitterBuffer
+ *  \{ */
+
+/*! Get the size of an adaptive jitter buffer.
+ *
+ *  \param[in]  samplerate      Sampling rate of the stream.
+ *  \param[in]  frame_ms        Frame length in ms.
+ *  \param[in]  max_delay_ms    Highest playout delay the buffer may adapt to, at most 1000 ms.
+ *  \param[in]  max_bytes       Largest frame, all channels included.
+ *  \return                     Size in bytes or 0 on error.
+ */
+int lc3_jitter_get_size(int samplerate, float frame_ms, int max_delay_ms, int max_bytes);
+
+/*! Initialize an adaptive jitter buffer. The buffer takes timestamped frames in any order and
+ *  hands them to the decoder at their deadline, or a lost frame if they are not there in time. The
+ *  playout delay follows the (1 - loss) quantile of the transit delay of the last four seconds,
+ *  see lc3_jitter_set_target_loss(). The delay grows by one frame when a missing frame is waited
+ *  for, which costs one concealed frame, and shrinks by skipping a frame while the buffer holds
+ *  more than needed. The buffer is not thread safe, calls have to be serialized.
+ *
+ *  \param[out] jb              Pointer to allocated memory of lc3_jitter_get_size() bytes.
+ *  \param[in]  samplerate      Sampling rate of the stream.
+ *  \param[in]  frame_ms        Frame length in ms.
+ *  \param[in]  max_delay_ms    Highest playout delay the buffer may adapt to, at most 1000 ms.
+ *  \param[in]  max_bytes       Largest frame, all channels included.
+ *  \return                     LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_jitter_init(LC3_JitterBuffer *jb, int samplerate, float frame_ms, int max_delay_ms, int max_bytes);
+
+/*! Set the share of frames that may arrive too late. Lower values cost playout delay. The
+ *  default is 0.01.
+ *
+ *  \param[in]  jb              Jitter buffer handle.
+ *  \param[in]  loss            Late loss rate, greater than 0 and at most 0.5.
+ *  \return                     LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_jitter_set_target_loss(LC3_JitterBuffer *jb, float loss);
+
+/*! Set the timestamp increment between two frames. The default is the number of samples per
+ *  frame, as for RTP timestamps at the sampling rate. Use 1 for frame sequence numbers. Changing
+ *  the increment restarts the buffer.
+ *
+ *  \param[in]  jb              Jitter buffer handle.
+ *  \param[in]  step            Timestamp increment per frame.
+ *  \return                     LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_jitter_set_timestamp_step(LC3_JitterBuffer *jb, int32_t step);
+
+/*! Put a received frame into the jitter buffer. Timestamps and times may wrap around, a jump of
+ *  the timestamps restarts the buffer after a few frames.
+ *
+ *  \param[in]  jb              Jitter buffer handle.
+ *  \param[in]  timestamp       Timestamp of the frame, see lc3_jitter_set_timestamp_step().
+ *  \param[in]  arrival_us      Arrival time in microseconds, on the clock of lc3_jitter_get().
+ *  \param[in]  bytes           Frame as produced by lc3_enc16() or lc3_enc24().
+ *  \param[in]  num_bytes       Number of bytes, at most max_bytes of lc3_jitter_init().
+ *  \return                     LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_jitter_put(LC3_JitterBuffer *jb, int32_t timestamp, int32_t arrival_us, const void *bytes, int num_bytes);
+
+/*! Take the next frame out of the jitter buffer. This has to be called once per frame duration,
+ *  from the audio clock. A num_bytes of 0 signals a lost frame, the decoder has to conceal it.
+ *  Before the first frame was received the result is always a lost frame.
+ *
+ *  \param[in]  jb              Jitter buffer handle.
+ *  \param[in]  now_us          Current time in microseconds.
+ *  \param[out] bytes           Buffer of at least max_bytes of lc3_jitter_init().
+ *  \param[out] num_bytes       Number of bytes written to bytes.
+ *  \return                     LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_jitter_get(LC3_JitterBuffer *jb, int32_t now_us, void *bytes, int *num_bytes);
+
+/*! Take the next frame out of the jitter buffer and decode it to 16 bit PCM output, a lost frame
+ *  is concealed. See lc3_jitter_get() and lc3_dec16().
+ *
+ *  \param[in]  jb              Jitter buffer handle.
+ *  \param[in]  decoder         Decoder handle.
+ *  \param[in]  now_us          Current time in microseconds.
+ *  \param[out] output_samples  Array of pointers to output channel buffers.
+ *  \param      scratch         Scratch memory of lc3_dec_get_scratch_size() bytes.
+ *  \return                     Result of lc3_dec16(), LC3_DECODE_ERROR for a concealed frame.
+ */
+LC3_Error lc3_jitter_dec16(LC3_JitterBuffer *jb, LC3_Dec *decoder, int32_t now_us, int16_t **output_samples,
+                           void *scratch);
+
+/*! Take the next frame out of the jitter buffer and decode it to 24 bit PCM output. See
+ *  lc3_jitter_dec16().
+ */
+LC3_Error lc3_jitter_dec24(LC3_JitterBuffer *jb, LC3_Dec *decoder, int32_t now_us, int32_t **output_samples,
+                           void *scratch);
+
+/*! Get the jitter buffer statistics.
+ *
+ *  \param[in]  jb              Jitter buffer handle.
+ *  \param[out] stats           Statistics.
+ *  \return                     LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_jitter_get_stats(const LC3_JitterBuffer *jb, LC3_JitterStats *stats);
+
+/*! \}
+ *  \addtogroup Mixing
+ *  \{ */
+
+/*! Decode compressed LC3 frame to its MDCT spectrum.
+ *
+ *  Streams with the same samplerate and frame length can be mixed in the MDCT domain with
+ *  lc3_spectrum_mix() and encoded again with lc3_enc_spectrum(), which saves the inverse transform
+ *  and LTPF of the decoder and the transform, resampling and pitch analysis of the encoder. A
+ *  spectrum holds one value per output sample, bin k is spectrum[k] * 2^(exponent - 31).
+ *
+ *  The time domain tools can not be applied to a spectrum, so this differs from lc3_dec16() in two
+ *  ways. The LTP postfilter is not applied, a frame that would be postfiltered is delivered
+ *  without it. A lost frame is concealed in the MDCT domain by noise substitution, also where
+ *  LC3_PLC_ADVANCED would select time domain concealment. A decoder should be used either with
+ *  this function or with lc3_dec16() / lc3_dec24(), switching restarts the output from silence.
+ *
+ *  \param[in]  decoder         Decoder initialized by lc3_dec_init().
+ *  \param[in]  input_bytes     Input bytes, see lc3_dec16().
+ *  \param[in]  num_bytes       Number of valid bytes in input_bytes, 0 for a lost frame.
+ *  \param[out] spectrum        Array of pointers to spectrum channel buffers of frame length values.
+ *  \param[out] exponent        Exponent of each channel spectrum.
+ *  \param      scratch         Scratch memory of lc3_dec_get_scratch_size() bytes.
+ *  \return                     LC3_OK on success or appropriate error code. As for lc3_dec16() the
+ *                              spectrum is still valid for LC3_DECODE_ERROR.
+ */
+LC3_Error lc3_dec_spectrum(LC3_Dec *decoder, void *input_bytes, int num_bytes, int32_t **spectrum, int *exponent,
+                           void *scratch);
+
+/*! Encode MDCT spectra to a compressed LC3 frame, typically a mix of lc3_dec_spectrum() output.
+ *
+ *  The encoder signals LTPF inactive and skips the attack detector, as these need the time signal.
+ *  An encoder should be used either with this function or with lc3_enc16() / lc3_enc24(),
+ *  switching restarts the transform from silence.
+ *
+ *  \param[in]  encoder         Encoder handle initialized by lc3_enc_init().
+ *  \param[in]  spectrum        Array of pointers to spectrum channel buffers of frame length values.
+ *  \param[in]  exponent        Exponent of each channel spectrum.
+ *  \param[out] output_bytes    Output buffer, see lc3_enc16().
+ *  \param[out] num_bytes       Number of bytes written to output_bytes.
+ *  \param      scratch         Scratch memory of lc3_enc_get_scratch_size() bytes.
+ *  \return                     LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_enc_spectrum(LC3_Enc *encoder, int32_t **spectrum, const int *exponent, void *output_bytes,
+                           int *num_bytes, void *scratch);
+
+/*! Add a weighted spectrum to a mix, mix = mix + gain * spectrum. The mix is renormalized, its
+ *  exponent is updated. To start a mix, set it to zero with any exponent, the result does not depend
+ *  on it. Adding a zero spectrum or a zero gain leaves the mix unchanged. A negative gain removes a
+ *  spectrum again, e.g. the own signal of a conference participant from the sum of all of them.
+ *
+ *  \param[in,out] mix          Mix of length values.
+ *  \param[in,out] mix_exponent Exponent of the mix.
+ *  \param[in]  spectrum        Spectrum to add.
+ *  \param[in]  exponent        Exponent of spectrum.
+ *  \param[in]  gain            Weight of spectrum.
+ *  \param[in]  length          Number of values, at most LC3_MAX_SAMPLES.
+ *  \return                     LC3_OK on success or appropriate error code.
+ */
+LC3_Error lc3_spectrum_mix(int32_t *mix, int *mix_exponent, const int32_t *spectrum, int exponent, float gain,
+                           int length);
+
+/*! \}
+ *  \addtogroup Transrating
+ *  \{ */
+
+/*! Convert a compressed LC3 frame to the bitrate of an encoder without decoding it to PCM.
+ *
+ *  The side information of the frame (scale factors, TNS and LTPF parameters and bandwidth) is
+ *  carried over and only the spectrum is quantized again, to lc3_enc_get_num_bytes() of encoder.
+ *  Transform, resampling and pitch analysis are skipped on both sides. The result is close to
+ *  decoding and encoding again, a stream reduced to a lower bitrate keeps the bandwidth and TNS
+ *  decisions of the original encoder.
+ *
+ *  The decoder only keeps track of the input bitrate, it is not used to decode audio and should not
+ *  be shared with lc3_dec16(). Encoder and decoder must have the same samplerate, frame length and
+ *  number of channels. The encoder bitrate can be changed between frames with
+ *  lc3_enc_set_bitrate(). A lost or broken input frame can not be converted, the receiver has to
+ *  conceal it, so num_bytes_out is 0 in that case.
+ *
+ *  \param[in]  encoder         Encoder initialized by lc3_enc_init(), bitrate set.
+ *  \param[in]  decoder         Decoder initialized by lc3_dec_init().
+ *  \param[in]  input_bytes     Input frame.
+ *  \param[in]  num_bytes       Number of valid bytes in input_bytes, 0 for a lost frame.
+ *  \param[out] output_bytes    Output buffer, see lc3_enc16().
+ *  \param[out] num_bytes_out   Number of bytes written to output_bytes.
+ *  \param      scratch         Scratch memory of lc3_enc_get_scratch_size() bytes.
+ *  \return                     LC3_OK on success, LC3_DECODE_ERROR if the input frame is lost or
+ *                              broken or another appropriate error code.
+ */
+LC3_Error lc3_transrate(LC3_Enc *encoder, LC3_Dec *decoder, void *input_bytes, int num_bytes, void *output_bytes,
+                        int *num_bytes_out, void *scratch);
+
 /*! \} */
 #endif /* LC3 */
@@ -54,8 +54,8 @@ void processMdct_fx(
 #endif
 
     /* Buffers overlap since they are not used at the same time */
-    buf        = (Word16 *)scratchAlign(scratchBuffer, 0); /* Size = 2 * MAX_LEN */
-    workBuffer = (Word32 *)scratchAlign(scratchBuffer, 0); /* Size = 4 * MAX_LEN */
+    buf        = (Word16 *)scratchAlignSimd(scratchBuffer, 0); /* Size = 2 * MAX_LEN + LC3_SCRATCH_ALIGN */
+    workBuffer = (Word32 *)scratchAlignSimd(scratchBuffer, 0); /* Size = 4 * MAX_LEN + LC3_SCRATCH_ALIGN */
 
     /* Init (constant per sample rate) */
     z = (N << 1) - wLen; /* number of leading zeros in window */
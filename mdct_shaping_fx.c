@@ -11,7 +11,8 @@
 
 
 
-void processMdctShaping_fx(Word32 x[], Word16 scf[], Word16 scf_exp[], const Word16 bands_offset[], Word16 fdns_npts)
+static inline void processMdctShaping_body(Word32 x[], Word16 scf[], Word16 scf_exp[], const Word16 bands_offset[],
+                                           Word16 fdns_npts)
 {
     Counter i, j;
 
@@ -64,3 +65,19 @@ void processScfScaling(Word16 scf_exp[], Word16 fdns_npts, Word16 *x_e)
 #endif
 }
 
+/* generic version for configurations without specialized kernels, see kernels_cfg.h */
+void processMdctShaping_fx(Word32 x[], Word16 scf[], Word16 scf_exp[], const Word16 bands_offset[], Word16 fdns_npts)
+{
+    processMdctShaping_body(x, scf, scf_exp, bands_offset, fdns_npts);
+}
+
+/* one instance per configuration, fs_idx, frame_dms and bands_number are constants */
+#define MDCT_SHAPING_CFG(cfg, cfg_fs_idx, cfg_frame_dms, cfg_bands_number)                                             \
+    void processMdctShaping_##cfg##_fx(Word32 x[], Word16 scf[], Word16 scf_exp[], const Word16 bands_offset[],        \
+                                       Word16 fdns_npts)                                                               \
+    {                                                                                                                  \
+        UNUSED(fdns_npts);                                                                                             \
+        processMdctShaping_body(x, scf, scf_exp, bands_offset, cfg_bands_number);                                      \
+    }
+
+LC3_KERNEL_CONFIGS(MDCT_SHAPING_CFG)
@@ -11,16 +11,22 @@
 
 /*************************************************************************/
 
+#define NF_LCG_LANES 8
 
+/* jump-ahead constants of nfseed = 13849 + nfseed*31821 (mod 2^16):
+   seed(k+1+j) = nf_lcg_a[j]*seed(k) + nf_lcg_c[j] (mod 2^16) */
+static const Word16 nf_lcg_a[NF_LCG_LANES] = {31821, -20695, -29867, 5265, 27549, 27193, -28891, -1503};
+static const Word16 nf_lcg_c[NF_LCG_LANES] = {13849, -26722, 22687, -7700, 31253, 6762, 32763, 18584};
 
-void processNoiseFilling_fx(Word32 xq[], Word16 nfseed, Word16 xq_e, Word16 fac_ns_idx, Word16 BW_cutoff_idx,
-                            Word16 frame_dms, Word16 fac_ns_pc, Word16 spec_inv_idx, Word8 *scratchBuffer)
+static inline void processNoiseFilling_body(Word32 xq[], Word16 nfseed, Word16 xq_e, Word16 fac_ns_idx,
+                                            Word16 BW_cutoff_idx, Word16 frame_dms, Word16 fac_ns_pc,
+                                            Word16 spec_inv_idx, Word8 *scratchBuffer)
 {
     Dyn_Mem_Deluxe_In(
-        Counter k;
-        Word16  nzeros, fac_ns, *ind, c;
+        Counter k, j;
+        Word16  nzeros, fac_ns, *ind, c, lanes, seed;
         Word16  noisefillwidth, noisefillstart, N;
-        Word32  L_tmp, L_tmp_neg, L_tmp_pc, L_tmp_neg_pc;
+        Word32  L_tmp, L_tmp_neg, L_tmp_pc, L_tmp_neg_pc, L_pos, L_neg;
     );
 
     ind = (Word16 *)scratchAlign(scratchBuffer, 0); /* Size = 2 * MAX_LEN bytes */
@@ -46,43 +52,35 @@ void processNoiseFilling_fx(Word32 xq[], Word16 nfseed, Word16 xq_e, Word16 fac_
         BREAK;
     }
 
+    /* zero run scan without branches: the counter restarts on a non zero bin and every
+       bin is written to ind[], the write position only advances for bins to be filled */
     nzeros = -2 * noisefillwidth - 1; 
 
     FOR (k = noisefillstart - noisefillwidth; k < noisefillstart + noisefillwidth; k++)
     {
+        nzeros = add(nzeros, 1);
         if (xq[k] != 0)
         {
             nzeros = -2 * noisefillwidth - 1; 
         }
-        if (xq[k] == 0)
-        {
-            nzeros = add(nzeros, 1);
-        }
     }
 
     FOR (k = noisefillstart; k < N - noisefillwidth; k++)
     {
+        nzeros = add(nzeros, 1);
         if (xq[k + noisefillwidth] != 0)
         {
             nzeros = -2 * noisefillwidth - 1; 
         }
-        if (xq[k + noisefillwidth] == 0)
-        {
-            nzeros = add(nzeros, 1);
-        }
-        if (nzeros >= 0)
-        {
-            ind[c++] = k; 
-        }
+        ind[c] = k; 
+        c      = add(c, sub(1, lshr(nzeros, 15)));
     }
 
     FOR (k = N - noisefillwidth; k < N; k++)
     {
         nzeros = add(nzeros, 1);
-        if (nzeros >= 0)
-        {
-            ind[c++] = k; 
-        }
+        ind[c] = k; 
+        c      = add(c, sub(1, lshr(nzeros, 15)));
     }
 
     IF (c > 0)
@@ -93,34 +91,51 @@ void processNoiseFilling_fx(Word32 xq[], Word16 nfseed, Word16 xq_e, Word16 fac_
         L_tmp_pc     = L_shr(L_deposit_l(fac_ns_pc), sub(xq_e, 16));
         L_tmp_neg_pc = L_negate(L_tmp_pc);
 
-        FOR (k = 0; k < c; k++)
+        /* NF_LCG_LANES seeds are derived from one base seed, the lanes are independent */
+        FOR (k = 0; k < c; k += lanes)
         {
-            nfseed = extract_l(L_mac0(13849, nfseed, 31821));
-            IF (nfseed >= 0)
+            lanes = s_min(NF_LCG_LANES, sub(c, k));
+            seed  = nfseed; 
+            FOR (j = 0; j < lanes; j++)
             {
-                IF (ind[k] < spec_inv_idx)
+                seed  = extract_l(L_mac0(nf_lcg_c[j], nfseed, nf_lcg_a[j]));
+                L_pos = L_tmp; 
+                L_neg = L_tmp_neg; 
+                if (sub(ind[k + j], spec_inv_idx) >= 0)
                 {
-                    xq[ind[k]] = L_tmp; 
+                    L_pos = L_tmp_pc; 
+                    L_neg = L_tmp_neg_pc; 
                 }
-                ELSE
+                xq[ind[k + j]] = L_pos; 
+                if (seed < 0)
                 {
-                    xq[ind[k]] = L_tmp_pc; 
-                }
-            }
-            IF (nfseed < 0)
-            {
-                IF (ind[k] < spec_inv_idx)
-                {
-                    xq[ind[k]] = L_tmp_neg; 
-                }
-                ELSE
-                {
-                    xq[ind[k]] = L_tmp_neg_pc; 
+                    xq[ind[k + j]] = L_neg; 
                 }
             }
+            nfseed = seed; /* seed of the last lane is the base of the next block */
         }
     }
 
     Dyn_Mem_Deluxe_Out();
 }
 
+/* generic version for configurations without specialized kernels, see kernels_cfg.h */
+void processNoiseFilling_fx(Word32 xq[], Word16 nfseed, Word16 xq_e, Word16 fac_ns_idx, Word16 BW_cutoff_idx,
+                            Word16 frame_dms, Word16 fac_ns_pc, Word16 spec_inv_idx, Word8 *scratchBuffer)
+{
+    processNoiseFilling_body(xq, nfseed, xq_e, fac_ns_idx, BW_cutoff_idx, frame_dms, fac_ns_pc, spec_inv_idx,
+                             scratchBuffer);
+}
+
+/* one instance per configuration, fs_idx, frame_dms and bands_number are constants */
+#define NOISE_FILLING_CFG(cfg, cfg_fs_idx, cfg_frame_dms, cfg_bands_number)                                            \
+    void processNoiseFilling_##cfg##_fx(Word32 xq[], Word16 nfseed, Word16 xq_e, Word16 fac_ns_idx,                    \
+                                        Word16 BW_cutoff_idx, Word16 frame_dms, Word16 fac_ns_pc,                      \
+                                        Word16 spec_inv_idx, Word8 *scratchBuffer)                                     \
+    {                                                                                                                  \
+        UNUSED(frame_dms);                                                                                             \
+        processNoiseFilling_body(xq, nfseed, xq_e, fac_ns_idx, BW_cutoff_idx, cfg_frame_dms, fac_ns_pc,                \
+                                 spec_inv_idx, scratchBuffer);                                                         \
+    }
+
+LC3_KERNEL_CONFIGS(NOISE_FILLING_CFG)
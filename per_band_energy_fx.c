@@ -12,9 +12,9 @@
 /* #define BIT_EXACT */
 
 
-void processPerBandEnergy_fx(Word32 *d2_fx, Word16 *d2_fx_exp, Word32 *d_fx, Word16 d_fx_exp,
-                             const Word16 *band_offsets, Word16 fs_idx, Word16 n_bands, Word16 linear, Word16 frame_dms,
-                             Word8 *scratchBuffer)
+static inline void processPerBandEnergy_body(Word32 *d2_fx, Word16 *d2_fx_exp, Word32 *d_fx, Word16 d_fx_exp,
+                                             const Word16 *band_offsets, Word16 fs_idx, Word16 n_bands, Word16 linear,
+                                             Word16 frame_dms, Word8 *scratchBuffer)
 {
     Dyn_Mem_Deluxe_In(
         Counter i, k, band;
@@ -22,6 +22,7 @@ void processPerBandEnergy_fx(Word32 *d2_fx, Word16 *d2_fx_exp, Word32 *d_fx, Wor
         Word16  s1;
         Word16  s2;
         Word32  nrg;
+        Word32  L_fold;
         Word16  smax;
         Word16  tmp16;
         Word16  nbands;
@@ -155,17 +156,19 @@ void processPerBandEnergy_fx(Word32 *d2_fx, Word16 *d2_fx_exp, Word32 *d_fx, Wor
     /* proceed with band offsets > 2 */
     FOR (; band < n_bands; band++)
     {
-        /* normalization */
-        k        = i;  
+        /* normalization: norm_l() of a negative value equals norm_l() of its complement, so the
+           smallest norm_l() of the non zero bins is the one of the OR over the sign folded bins.
+           The OR reduction has no order and no branches and can run over the band in lanes */
+        L_fold   = 0; 
         s1       = 15; 
 
         stopBand = s_min(band_offsets[band + 1], maxBwBin);
-        FOR (; k < stopBand; k++)
+        FOR (k = i; k < stopBand; k++)
         {
-            s = norm_l(d_fx[k]);
-            if (d_fx[k] != 0)
-                s1 = s_min(s1, s);
+            L_fold = L_or(L_fold, L_xor(d_fx[k], L_shr_pos(d_fx[k], 31)));
         }
+        if (L_fold != 0)
+            s1 = s_min(s1, norm_l(L_fold));
 
         nbands = sub(band_offsets[band + 1], band_offsets[band]);
         ASSERT(nbands < 32);
@@ -210,3 +213,26 @@ void processPerBandEnergy_fx(Word32 *d2_fx, Word16 *d2_fx_exp, Word32 *d_fx, Wor
     Dyn_Mem_Deluxe_Out();
 }
 
+/* generic version for configurations without specialized kernels, see kernels_cfg.h */
+void processPerBandEnergy_fx(Word32 *d2_fx, Word16 *d2_fx_exp, Word32 *d_fx, Word16 d_fx_exp,
+                             const Word16 *band_offsets, Word16 fs_idx, Word16 n_bands, Word16 linear, Word16 frame_dms,
+                             Word8 *scratchBuffer)
+{
+    processPerBandEnergy_body(d2_fx, d2_fx_exp, d_fx, d_fx_exp, band_offsets, fs_idx, n_bands, linear, frame_dms,
+                              scratchBuffer);
+}
+
+/* one instance per configuration, fs_idx, frame_dms and bands_number are constants */
+#define PER_BAND_ENERGY_CFG(cfg, cfg_fs_idx, cfg_frame_dms, cfg_bands_number)                                          \
+    void processPerBandEnergy_##cfg##_fx(Word32 *d2_fx, Word16 *d2_fx_exp, Word32 *d_fx, Word16 d_fx_exp,              \
+                                         const Word16 *band_offsets, Word16 fs_idx, Word16 n_bands,                    \
+                                         Word16 linear, Word16 frame_dms, Word8 *scratchBuffer)                        \
+    {                                                                                                                  \
+        UNUSED(fs_idx);                                                                                                \
+        UNUSED(n_bands);                                                                                               \
+        UNUSED(frame_dms);                                                                                             \
+        processPerBandEnergy_body(d2_fx, d2_fx_exp, d_fx, d_fx_exp, band_offsets, cfg_fs_idx, cfg_bands_number,        \
+                                  linear, cfg_frame_dms, scratchBuffer);                                               \
+    }
+
+LC3_KERNEL_CONFIGS(PER_BAND_ENERGY_CFG)
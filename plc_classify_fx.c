@@ -99,10 +99,7 @@ Word16 spectral_centroid_fx_lc(Word16 old_scf_q[], const Word16 *band_offsets, W
     old_scf_q_mod_exp = (Word16 *)scratchAlign(old_scf_q_mod, sizeof(*old_scf_q_mod) * M); /* Size = 2 * M */
 
     /* Linear Domain */
-    FOR (i = 0; i < M; i++)
-    {
-        old_scf_q_mod[i] = BASOP_Util_InvLog2_16(old_scf_q[i], &old_scf_q_mod_exp[i]);
-    }
+    BASOP_Util_InvLog2_16_vec(old_scf_q, old_scf_q_mod, old_scf_q_mod_exp, M);
 
     /* De-emphasis */
     FOR (i = 0; i < M; i++)
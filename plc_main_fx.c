@@ -40,10 +40,12 @@ void processPLCmain_fx(LC3_Dec* decoder, Word16 plcMeth, Word16 *concealMethod,
         processPLCupdateSpec_fx(q_old_d_fx, q_old_fx_exp, q_d_fx, q_fx_exp, yLen);
     }
 
+#if !BTLLC_5MS_MODE
     IF (plcAd != NULL &&  (sub(plcAd->PhECU_frame_ms , 10)==0) )  
     {
         processPLCspec2shape_fx(prev_bfi, bfi, q_old_d_fx, yLen, plcAd->PhECU_oold_grp_shape_fx, plcAd->PhECU_old_grp_shape_fx);
     }
+#endif
  
 }
 
@@ -108,7 +108,7 @@ Word16 rand_phase_fx(const Word16 seed, Word16 *sin_F, Word16 *cos_F);
 
 static Word16 imax2_jacobsen_mag_fx(const Word16 *y_re, const Word16 *y_im, const Word16 special);
 static void   fft_spec2_sqrt_approx_fx(const Word16 x[], Word16 xMagSqrt[], const Word16 N);
-static Word16 sqrtMagnApprox_fx(const Word16 re, const Word16 im);
+static void   sqrtMagnApprox_vec_fx(const Word16 *re, const Word16 *im_rev, Word16 *mag, const Word16 n);
 
 static void rotate_W16_fx(Word16 re_in, Word16 im_in, Word16 cosFactor, Word16 sinFactor, Word16 *re_out_ptr,
    Word16 *im_out_ptr)
@@ -120,6 +120,24 @@ static void rotate_W16_fx(Word16 re_in, Word16 im_in, Word16 cosFactor, Word16 s
    return;
 }
 
+/* rotate n bins of the flipped fft format by the same angle, re[] is walked forward and
+   im_rev[] backward; each bin is independent so the loop maps onto SIMD lanes */
+static void rotate_W16_vec_fx(Word16 *re, Word16 *im_rev, Word16 cosFactor, Word16 sinFactor, Word16 n)
+{
+   Counter i;
+   Word16  re_in, im_in;
+   BASOP_sub_sub_start("PhECU::rotate_W16_vec_fx");
+   FOR(i = 0; i < n; i++)
+   {
+      re_in      = re[i];
+      im_in      = im_rev[-i];
+      re[i]      = msu_r(L_mult(re_in, cosFactor), im_in, sinFactor);
+      im_rev[-i] = mac_r(L_mult(re_in, sinFactor), im_in, cosFactor);
+   }
+   BASOP_sub_sub_end();
+   return;
+}
+
 static void valley_magnitude_adj_fx(Word16 *re_ptr, Word16 *im_ptr, Word16 uniFactor, Word16 cosFactor)
 {
    Word16 scale_fx;
@@ -1368,6 +1386,8 @@ void subst_spec_fx(
 
     get_sin_cosQ10opt(Xph_short, &peak_sin_F, &peak_cos_F);
 
+    /* the whole peak area shares one evolution angle, rotate it as a block first */
+    rotate_W16_vec_fx(pReX, pImX, peak_cos_F, peak_sin_F, s_max(segmentLen, 0));
 
     ASSERT(pReX == &(X[i])); /*before peak*/
     FOR(j = 0; j < segmentLen; j++)
@@ -1376,7 +1396,8 @@ void subst_spec_fx(
  
         UNUSED(ph_dith);
         *seed = extract_l(L_mac0(13849, *seed, 31821));
-        rotate_W16_fx(*pReX, *pImX, peak_cos_F, peak_sin_F, &tmp, &im); /* should be inlined */
+        tmp = *pReX; /* rotated above */
+        im  = *pImX;
         UNUSED(re);
 
         *seed = rand_phase_fx(*seed, &sin_F, &cos_F);        
@@ -2157,7 +2178,7 @@ static void ola_add(const Word16 *x,     /* i: Input signal 1 */
 }
 
 /*-----------------------------------------------------------------------------
-* magnSqrtApprox_fx()
+* sqrtMagnApprox_vec_fx()
 *
 * Approximation of sqrt(Square magnitude) of fft spectrum
 * if min_abs <= 0.4142135*max_abs
@@ -2166,58 +2187,69 @@ static void ola_add(const Word16 *x,     /* i: Input signal 1 */
 *     abs = 0.84*max_abs + 0.561*min_abs
 * end
 *
+* Block version over n bins, re[] is read forward and im_rev[] backward as stored
+* in the flipped fft format. The coefficient pair is selected without branches,
+* so the loop body maps onto SIMD lanes.
+*
 * Note: even to handle the dynamics of sqrt(re^2+im^2) located on
 *       a scaled unit circle. One need to scale down the results
 *       with a factor 2, that is Q_out = Q_in - 1
 *       sqrt(32768.^2+32768.^2) results in = 23170 Q0-1,
 *       which corresponds to 46341 in the Q0 domain
 *----------------------------------------------------------------------------*/
-Word16 sqrtMagnApprox_fx(                 /* o : sqrt of magnitude square spectrum  Q_in-1*/
-    const Word16 re, /* i : Real part                          Q_in */
-    const Word16 im  /* i : Imag part                          Q_in */
-)
-{
-    /* Constants for Approximation of sqrt(Square magnitude) of fft spectrum
-    * >> num2str(round(0.4142135]*2.^15))
-    *    ans = 13573
-    * >> num2str(round([0.99 0.197 0.84 0.561]*2.^14))
-    *    ans = 16220   3228  13763   9191
-    */
-
+/* Constants for Approximation of sqrt(Square magnitude) of fft spectrum
+* >> num2str(round(0.4142135]*2.^15))
+*    ans = 13573
+* >> num2str(round([0.99 0.197 0.84 0.561]*2.^14))
+*    ans = 16220   3228  13763   9191
+*/
 #define C_0p4142135_Q15 13573
 
 #define C_0p99_Q14 16220
 #define C_0p197_Q14 3228
 #define C_0p84_Q14 13763
 #define C_0p561_Q14 9191
-    Word16 sgn_bit, re_abs, im_abs, max_abs, min_abs, sum;
-    Word16 jcoeffs[2][2] = { {C_0p99_Q14, C_0p197_Q14}, {C_0p84_Q14, C_0p561_Q14} };
+
+static const Word16 sqrtMagnApprox_max_coef[2] = { C_0p99_Q14, C_0p84_Q14 };
+static const Word16 sqrtMagnApprox_min_coef[2] = { C_0p197_Q14, C_0p561_Q14 };
+
+void sqrtMagnApprox_vec_fx(const Word16 *re,     /* i : Real parts                          Q_in   */
+                           const Word16 *im_rev, /* i : Imag parts, read backwards          Q_in   */
+                           Word16 *      mag,    /* o : sqrt of magnitude square spectrum  Q_in-1 */
+                           const Word16  n       /* i : Number of bins                             */
+)
+{
+    Counter i;
+    Word16  sgn_bit, re_abs, im_abs, max_abs, min_abs;
 
 #ifdef DYNMEM_COUNT
-    Dyn_Mem_In("sqrtMagnApprox_fx", sizeof(struct {
-    Word16 sgn_bit, re_abs, im_abs, max_abs, min_abs, sum;
-    Word16 jcoeffs[2][2];
+    Dyn_Mem_In("sqrtMagnApprox_vec_fx", sizeof(struct {
+    Counter i;
+    Word16  sgn_bit, re_abs, im_abs, max_abs, min_abs;
     }));
 #endif
 
-    BASOP_sub_sub_start("PhECU::sqrtMagnApprox_fx");
+    BASOP_sub_sub_start("PhECU::sqrtMagnApprox_vec_fx");
 
-    /* Get values and move pointers */
-    re_abs = abs_s(re); /* 1 cycle */
-    im_abs = abs_s(im); /* 1 cycle */
+    FOR(i = 0; i < n; i++)
+    {
+        re_abs = abs_s(re[i]);         /* 1 cycle */
+        im_abs = abs_s(im_rev[-i]);    /* 1 cycle */
 
-    /* Find max and min value */
-    min_abs = s_min(re_abs, im_abs); /* 1 cycle */
-    max_abs = s_max(re_abs, im_abs); /* 1 cycle  */
+        /* Find max and min value */
+        min_abs = s_min(re_abs, im_abs); /* 1 cycle */
+        max_abs = s_max(re_abs, im_abs); /* 1 cycle  */
+
+        /* Calc approximation depending on relation */
+        sgn_bit = lshr(sub(mult(max_abs, C_0p4142135_Q15), min_abs), 15); /* 3 cycles */
+        mag[i]  = mac_r(L_mult(max_abs, sqrtMagnApprox_max_coef[sgn_bit]), min_abs,
+                       sqrtMagnApprox_min_coef[sgn_bit]); /* 2 cycles */
+    }
 
-    /* Calc approximation depending on relation */
-    sgn_bit = lshr(sub(mult(max_abs, C_0p4142135_Q15), min_abs), 15);                    /* 3 cycles */
-    sum     = mac_r(L_mult(max_abs, jcoeffs[sgn_bit][0]), min_abs, jcoeffs[sgn_bit][1]); /* 2 cycles */
 #ifdef DYNMEM_COUNT
     Dyn_Mem_Out();
 #endif
     BASOP_sub_sub_end();
-    return sum;
 }
 
 /*-----------------------------------------------------------------------------
@@ -2242,14 +2274,12 @@ void fft_spec2_sqrt_approx_fx(const Word16 x[],        /* i : Input vector: comp
     const Word16 N           /* i : Input vector x length */
 )
 {
-    Counter       i;
     Word16        l;
     const Word16 *pRe, *pIm;
     Word16 *      pMagSqrt;
 
 #ifdef DYNMEM_COUNT
     Dyn_Mem_In("fft_spec2_sqrt_approx_fx", sizeof(struct {
-    Counter       i;
     Word16        l;
     const Word16 *pRe, *pIm;
     Word16 *      pMagSqrt;
@@ -2270,10 +2300,9 @@ void fft_spec2_sqrt_approx_fx(const Word16 x[],        /* i : Input vector: comp
     l = s_min(l, (LPROT48K_RED / 2 - 1) +    DELTA_CORR_F0_INT); 
     /* at 48 k the top 8 khz are always zero, and further peaks are not
                         located above LPROT48K_RED 32 kHz  */
-    FOR(i = 0; i < l; i++)
-    {
-    *pMagSqrt++ = sqrtMagnApprox_fx(*pRe++, *pIm--);  
-    }
+    sqrtMagnApprox_vec_fx(pRe, pIm, pMagSqrt, l);
+    pRe += l;
+    pMagSqrt += l;
 
     /* The sqrt magnitude square at N/2 - only real component */
     *pMagSqrt = mult(abs_s(*pRe), C_0p99_Q14);  
@@ -2585,67 +2614,32 @@ void get_sin_cosQ10opt(Word16 phase,    /* Q10 0..1023  i.e. 1024=2*pi */
     Word16 * ptrCos  /* Q15 */
 )
 {
-    Word16 sign_val, idx, idx2, idx3;
+    Word16 sign_mask, idx;
 
 #ifdef DYNMEM_COUNT
-    Dyn_Mem_In("get_sin_cosQ10", sizeof(struct { Word16 sign_val, idx, idx2, idx3; }));
+    Dyn_Mem_In("get_sin_cosQ10", sizeof(struct { Word16 sign_mask, idx; }));
 #endif
 
     BASOP_sub_sub_start("PhECU::get_sin_cosQ10opt");
 
     /* sin table  has a range up to  pi/2  (256+1)=257 coeffs*/
+    /* branchless: the quarter wave index is folded with abs and the half wave sign is applied
+       with a mask, so the lookup can run in SIMD lanes with a gather */
 
-    sign_val = shr_pos_pos(phase, 9);   /* highest bit is  the sinus sign */
-    idx      = s_and(phase, 0x1ff); /* mask away sign */
-
-    idx2 = sub(idx, 256);
-    if (idx2 < 0)
-    { /*rising sine part */
-    *ptrSin = sin_quarterQ15_fx[idx];   
-    }
-
-    idx3 = sub(512, idx);
-    if (idx2 >= 0)
-    { /* decaying part, reverse idx */
-    *ptrSin = sin_quarterQ15_fx[idx3];   
-    }
-
-    if (sign_val != 0)
-    {
-    *ptrSin = negate(*ptrSin); /*no move when inlined , no sat as max in table is 32767 */
-    }
+    sign_mask = negate(shr_pos_pos(phase, 9));                 /* highest bit is  the sinus sign, 0 or -1 */
+    idx       = sub(256, abs_s(sub(256, s_and(phase, 0x1ff)))); /* rising part idx, decaying part 512-idx */
+    *ptrSin   = sub(s_xor(sin_quarterQ15_fx[idx], sign_mask), sign_mask); /* no sat as max in table is 32767 */
 
     /*cos*/
-    idx = add(phase, 256);   /* +pi/2,  i.e. move to cos phase */
-    idx = s_and(idx, 0x3ff); /* wrap on 10 bits  limit  */
-
-    sign_val = shr_pos_pos(idx, 9);   /* highest bit is  the sign */
-    idx      = s_and(idx, 0x1ff);      /*  mask away sign */
-
-    idx2 = sub(idx, 256);
-    if (idx2 < 0)
-    { /*rising sine part */
-    *ptrCos = sin_quarterQ15_fx[idx];   
-    }
-
-    idx3 = sub(512, idx);
-    if (idx2 >= 0)
-    { /* decaying part, reverse idx*/
-    *ptrCos = sin_quarterQ15_fx[idx3];   
-    }
-
-    if (sign_val != 0)
-    {
-    *ptrCos = negate(*ptrCos); /* no move when inlined , no sat as max in table is 32767  */
-    }
+    phase     = s_and(add(phase, 256), 0x3ff); /* +pi/2,  i.e. move to cos phase, wrap on 10 bits */
+    sign_mask = negate(shr_pos_pos(phase, 9));
+    idx       = sub(256, abs_s(sub(256, s_and(phase, 0x1ff))));
+    *ptrCos   = sub(s_xor(sin_quarterQ15_fx[idx], sign_mask), sign_mask);
 
 #ifdef DYNMEM_COUNT
     Dyn_Mem_Out();
 #endif
     BASOP_sub_sub_end();
-
-#ifdef NONBE_PLC2_SINQ10_WMOPS_SAVE
-#endif 
 }
 
 
@@ -81,30 +81,22 @@ void plc_phEcu_peak_locator_fx(const Word16 *inp, /* i: vector with values >=0
   
 
    /*  xor high/low pairs of delta_inp and save sign changes */
+   /*  branchless compaction: location and value are always stored and the write position only
+       advances on a sign change, the value copy is merged into the same pass */
    prev_delta = sub(inp[1], inp[0]);  /*  precompute very first delta */
+   k          = 0;
 
    FOR(n = 1;  n < inp_len_minus1; n++)
    {   /* sign change analysis */
       curr_delta = sub(inp[n + 1], inp[n]);    /*  n+1 ,n ,   are loop ptrs   */
-      if (s_xor(prev_delta, curr_delta) < 0)   /* a "0" delta  treated as a  positive sign */
-      {
-         *p_tmp++ = n;               /* store sign change bin locations , location n in the inp[] signal */
-      }
+      p_tmp[k]                       = n;      /* sign change bin location , location n in the inp[] signal */
+      cand_pairs[k + pairs_start]    = inp[n];
+      k          = add(k, lshr(s_xor(prev_delta, curr_delta), 15)); /* a "0" delta  treated as a  positive sign */
       prev_delta = curr_delta; 
    }
 
-   L_sub(0, 0); /* account for length calculaton */
-   k = (Word16)(p_tmp - &(sc_idx[pairs_start]));  
-
-    
-   /* copy sign change location values to a pairs array */
    /* leave one initial sc_idx location open for a potential initial DC value */
-
    ASSERT(pairs_start >= 0 && ((k - 1) + pairs_start) < (inp_len +2));
-   FOR(j = 0; j < k; j++)
-   {
-      cand_pairs[j + pairs_start] = inp[sc_idx[j + pairs_start]];     /*  the indirect  should be  calculated */
-   }
 
 
    /* filter away a potential  single initial/trailing  plateau
@@ -14,6 +14,7 @@
 /*****************************************************************************/
 
 static Word32 TDC_Dot_product(const Word16 x[], const Word16 y[], const Word16 lg);
+static void   TDC_Dot_product_x4(const Word16 x[], const Word16 y[], const Word16 lg, Word32 sum[4]);
 static void   TDC_highPassFiltering_fx(const Word16 L_buffer, Word16 exc2[], const Word16 l_fir_fer,
                                        const Word16 *hp_filt);
 static Word32 TDC_calcGainp(Word16 x[], Word16 y[], Word16 lg);
@@ -69,7 +70,7 @@ void processTimeDomainConcealment_Apply_fx(const Word16 pitch_int, const Word16
 {
     Counter       i;
     Word16        s, s1, c1, c2, len, len_hp, cnt, g_fx, ilen, Tc, nextInc, beforeNextInc;
-    Word32        tmp32, tmp32_2;
+    Word32        tmp32, tmp32_2, hp_sum[4];
     Word16        gain_p_loc;
     Word32        gain_c_32_fx;
     Word16        gain_c_16_fx, gain_c_16_fx_exp, gain_inov_fx, gain_inov_fx_exp, ilen_exp;
@@ -82,7 +83,7 @@ void processTimeDomainConcealment_Apply_fx(const Word16 pitch_int, const Word16
     Dyn_Mem_In("processTimeDomainConcealment_Apply_fx", sizeof(struct {
                    Counter i;
                    Word16  s, s1, c1, c2, len, len_hp, cnt, g_fx, ilen, Tc, nextInc, beforeNextInc;
-                   Word32  tmp32, tmp32_2;
+                   Word32  tmp32, tmp32_2, hp_sum[4];
                    Word16  gain_p_loc;
                    Word32  gain_c_32_fx;
                    Word16  gain_c_16_fx, gain_c_16_fx_exp, gain_inov_fx, gain_inov_fx_exp, ilen_exp;
@@ -150,7 +151,8 @@ void processTimeDomainConcealment_Apply_fx(const Word16 pitch_int, const Word16
      *---------------------------------------------------------------*/
 
     /* pointer inits */
-    exc_fx       = (Word16 *)scratchAlign(scratchBuffer,
+    exc_fx       = (Word16 *)scratchAlign(scratchBuffer, 0); /* exc_buf_past */
+    exc_fx       = (Word16 *)scratchAlign(exc_fx,
                                     sizeof(Word16) * len_pi_lf_2); /* MAX_PITCH+MAX_LEN/2 + MAX_LEN+MDCT_MEM_LEN_MAX */
     synth_mem_fx = (Word16 *)scratchAlign(exc_fx, sizeof(*exc_fx) * len);           /* M */
     x_pre_fx     = (Word16 *)scratchAlign(synth_mem_fx, sizeof(*synth_mem_fx) * lpc_order); /* MAX_PITCH+MAX_LEN/2+M+1 */
@@ -477,7 +479,15 @@ void processTimeDomainConcealment_Apply_fx(const Word16 pitch_int, const Word16
     ELSE
     {
         c1 = sub(0x7FFF, *cum_alpha);
-        FOR (i = 0; i < len_hp; i++)
+        FOR (i = 0; i < sub(len_hp, 3); i += 4)
+        {
+            TDC_Dot_product_x4(&exc2_fx[i], hp_filt_fx, TDC_L_FIR_HP, hp_sum);
+            exc2_fx[i]     = round_fx(L_mac0(Mpy_32_16(hp_sum[0], (*cum_alpha)), c1, exc2_fx[i])); 
+            exc2_fx[i + 1] = round_fx(L_mac0(Mpy_32_16(hp_sum[1], (*cum_alpha)), c1, exc2_fx[i + 1])); 
+            exc2_fx[i + 2] = round_fx(L_mac0(Mpy_32_16(hp_sum[2], (*cum_alpha)), c1, exc2_fx[i + 2])); 
+            exc2_fx[i + 3] = round_fx(L_mac0(Mpy_32_16(hp_sum[3], (*cum_alpha)), c1, exc2_fx[i + 3])); 
+        }
+        FOR (; i < len_hp; i++)
         {
             /* Return value of dot product is Q1 */
             tmp32      = Mpy_32_16(TDC_Dot_product(&exc2_fx[i], hp_filt_fx, TDC_L_FIR_HP), (*cum_alpha) /*Q15*/);
@@ -696,6 +706,48 @@ static Word32 TDC_Dot_product(const Word16 x[], const Word16 y[], const Word16 l
     return sum;
 }
 
+/*
+ * TDC_Dot_product_x4
+ *
+ * Parameters:
+ *   x     i: x vector, lg+3 values read   Q0
+ *   y     i: y vector                     Q0
+ *   lg    i: vector length                Q0
+ *   sum   o: dot products of x[k..], k=0..3  Q1
+ *
+ * Function:
+ *   four dot products over neighbouring windows of x, each lane accumulates
+ *   in the same order as TDC_Dot_product
+ *
+ * Returns:
+ *   void
+ */
+static void TDC_Dot_product_x4(const Word16 x[], const Word16 y[], const Word16 lg, Word32 sum[4])
+{
+    Dyn_Mem_Deluxe_In(
+        Counter i;
+        Word32  s0, s1, s2, s3;
+    );
+
+    s0 = L_mac0(1L, x[0], y[0]);
+    s1 = L_mac0(1L, x[1], y[0]);
+    s2 = L_mac0(1L, x[2], y[0]);
+    s3 = L_mac0(1L, x[3], y[0]);
+    FOR (i = 1; i < lg; i++)
+    {
+        s0 = L_mac0(s0, x[i], y[i]);
+        s1 = L_mac0(s1, x[i + 1], y[i]);
+        s2 = L_mac0(s2, x[i + 2], y[i]);
+        s3 = L_mac0(s3, x[i + 3], y[i]);
+    }
+    sum[0] = s0; 
+    sum[1] = s1; 
+    sum[2] = s2; 
+    sum[3] = s3; 
+
+    Dyn_Mem_Deluxe_Out();
+}
+
 /*
  * TDC_highPassFiltering_fx
  *
@@ -716,9 +768,19 @@ static void TDC_highPassFiltering_fx(const Word16 L_buffer, Word16 exc2[], const
 {
     Dyn_Mem_Deluxe_In(
         Counter i;
+        Word32  sum[4];
     );
 
-    FOR (i = 0; i < L_buffer; i++)
+    /* in place: output i only overwrites exc2[i], which no later window reads */
+    FOR (i = 0; i < sub(L_buffer, 3); i += 4)
+    {
+        TDC_Dot_product_x4(&exc2[i], hp_filt, l_fir_fer, sum);
+        exc2[i]     = round_fx(L_sub(sum[0], 1)); 
+        exc2[i + 1] = round_fx(L_sub(sum[1], 1)); 
+        exc2[i + 2] = round_fx(L_sub(sum[2], 1)); 
+        exc2[i + 3] = round_fx(L_sub(sum[3], 1)); 
+    }
+    FOR (; i < L_buffer; i++)
     {
         exc2[i] = round_fx(L_sub(TDC_Dot_product(&exc2[i], hp_filt, l_fir_fer), 1)); 
     }
@@ -911,28 +973,31 @@ static void TDC_LPC_synthesis_fx(const Word16 sh, const Word16 a[], const Word16
         Counter i;
         Word16  a0;
         Word16  q;
-        Word32(*syn_kern)(Word32 L_tmp, const Word16 a[], const Word16 y[]
-    ););
+    );
 
     ASSERT(m == 16 || m == 8);
 
-    if (sub(m, 16) == 0)
+    q        = add(norm_s(a[0]), 1);
+    a0       = shr(a[0], sh);
+
+    /* the recursion feeds back the rounded output, a block or impulse response
+       formulation would not be bit-exact; call the kernel directly so it inlines */
+    IF (sub(m, 16) == 0)
     {
-        syn_kern = syn_kern_16;
+        FOR (i = 0; i < lg; i++)
+        {
+            y[i] = round_fx_sat(L_shl_sat(syn_kern_16(L_mult(a0, x[i]), a, &y[i]), q));
+        }
     }
 #ifdef NONBE_PLC3_NB_LPC_ORDER
-    if (sub(m, 8) == 0)
+    IF (sub(m, 8) == 0)
     {
-        syn_kern = syn_kern_8;
+        FOR (i = 0; i < lg; i++)
+        {
+            y[i] = round_fx_sat(L_shl_sat(syn_kern_8(L_mult(a0, x[i]), a, &y[i]), q));
+        }
     }
 #endif
-    q        = add(norm_s(a[0]), 1);
-    a0       = shr(a[0], sh);
-
-    FOR (i = 0; i < lg; i++)
-    {
-        y[i] = round_fx_sat(L_shl_sat(syn_kern(L_mult(a0, x[i]), a, &y[i]), q)); 
-    }
 
     Dyn_Mem_Deluxe_Out();
 }
@@ -956,61 +1021,49 @@ static void TDC_LPC_residu_fx(const Word16 *a, Word16 *x, Word16 *y, Word16 lg,
 {
     Dyn_Mem_Deluxe_In(
         Word16  a_exp;
-        Word32  s;
-        Counter i;
+        Word32  s0, s1, s2, s3;
+        Counter i, j;
     );
 
+#ifdef NONBE_PLC3_NB_LPC_ORDER
     ASSERT(m == 16 || m == 8);
+#else
+    ASSERT(m == 16);
+#endif
 
     a_exp = add(norm_s(a[0]), 1);
     a_exp = add(a_exp, 1);
 
-    IF (sub(m, 16) == 0)
+    /* block FIR, four neighbouring outputs share each coefficient load and every
+       output keeps the scalar accumulation order, so saturation behaves the same */
+    FOR (i = 0; i < sub(lg, 3); i += 4)
     {
-        FOR (i = 0; i < lg; i++)
+        s0 = L_mult(x[i], a[0]);
+        s1 = L_mult(x[i + 1], a[0]);
+        s2 = L_mult(x[i + 2], a[0]);
+        s3 = L_mult(x[i + 3], a[0]);
+        FOR (j = 1; j <= m; j++)
         {
-            s = L_mult(x[i], a[0]);
-            s = L_mac_sat(s, x[i - 1], a[1]);
-            s = L_mac_sat(s, x[i - 2], a[2]);
-            s = L_mac_sat(s, x[i - 3], a[3]);
-            s = L_mac_sat(s, x[i - 4], a[4]);
-            s = L_mac_sat(s, x[i - 5], a[5]);
-            s = L_mac_sat(s, x[i - 6], a[6]);
-            s = L_mac_sat(s, x[i - 7], a[7]);
-            s = L_mac_sat(s, x[i - 8], a[8]);
-            s = L_mac_sat(s, x[i - 9], a[9]);
-            s = L_mac_sat(s, x[i - 10], a[10]);
-            s = L_mac_sat(s, x[i - 11], a[11]);
-            s = L_mac_sat(s, x[i - 12], a[12]);
-            s = L_mac_sat(s, x[i - 13], a[13]);
-            s = L_mac_sat(s, x[i - 14], a[14]);
-            s = L_mac_sat(s, x[i - 15], a[15]);
-            s = L_mac_sat(s, x[i - 16], a[16]);
-
-            s    = L_shl_sat(s, a_exp);
-            y[i] = round_fx_sat(s); 
+            s0 = L_mac_sat(s0, x[i - j], a[j]);
+            s1 = L_mac_sat(s1, x[i + 1 - j], a[j]);
+            s2 = L_mac_sat(s2, x[i + 2 - j], a[j]);
+            s3 = L_mac_sat(s3, x[i + 3 - j], a[j]);
         }
+        y[i]     = round_fx_sat(L_shl_sat(s0, a_exp));
+        y[i + 1] = round_fx_sat(L_shl_sat(s1, a_exp));
+        y[i + 2] = round_fx_sat(L_shl_sat(s2, a_exp));
+        y[i + 3] = round_fx_sat(L_shl_sat(s3, a_exp));
     }
-#ifdef NONBE_PLC3_NB_LPC_ORDER
-    IF (sub(m, 8) == 0)
+
+    FOR (; i < lg; i++)
     {
-        FOR (i = 0; i < lg; i++)
+        s0 = L_mult(x[i], a[0]);
+        FOR (j = 1; j <= m; j++)
         {
-            s = L_mult(x[i], a[0]);
-            s = L_mac_sat(s, x[i - 1], a[1]);
-            s = L_mac_sat(s, x[i - 2], a[2]);
-            s = L_mac_sat(s, x[i - 3], a[3]);
-            s = L_mac_sat(s, x[i - 4], a[4]);
-            s = L_mac_sat(s, x[i - 5], a[5]);
-            s = L_mac_sat(s, x[i - 6], a[6]);
-            s = L_mac_sat(s, x[i - 7], a[7]);
-            s = L_mac_sat(s, x[i - 8], a[8]);
-
-            s    = L_shl_sat(s, a_exp);
-            y[i] = round_fx_sat(s); 
+            s0 = L_mac_sat(s0, x[i - j], a[j]);
         }
+        y[i] = round_fx_sat(L_shl_sat(s0, a_exp));
     }
-#endif
 
     Dyn_Mem_Deluxe_Out();
 }
@@ -39,7 +39,7 @@ Word16 plc_norm_corr_blocks_fx(                     /* o:  norm_corr range  [-1
 {
     Word16  scale0, scale1, scale2, scale_min, shift, prod_exp, acc_margin;
     Word32  L_prod, L_inv, L_tmp0 = 0, L_tmp1 = 0, L_tmp2 = 0;
-    Word16  norm_corr, curr, pred;
+    Word16  norm_corr, curr, pred, n_lanes;
     Counter m, b;
     Word32  L_ce[MAX_ACCS][MAX_BLOCKS];
 
@@ -47,7 +47,7 @@ Word16 plc_norm_corr_blocks_fx(                     /* o:  norm_corr range  [-1
     Dyn_Mem_In("plc_norm_corr_blocks_fx", sizeof(struct {
                    Word16  scale0, scale1, scale2, scale_min, shift, prod_exp, acc_margin;
                    Word32  L_prod, L_inv, L_tmp0, L_tmp1, L_tmp2;
-                   Word16  norm_corr, curr, pred;
+                   Word16  norm_corr, curr, pred, n_lanes;
                    Counter m, b;
                    Word32  L_ce[MAX_ACCS][MAX_BLOCKS];
                }));
@@ -60,27 +60,28 @@ Word16 plc_norm_corr_blocks_fx(                     /* o:  norm_corr range  [-1
     ASSERT(((float)tot_len / (float)n_blocks) <= (float)(1 << l2_base_len));
     ASSERT(inshift > 0);
 
+    /* lane-major sweep over contiguous samples: the n_blocks interleaved accumulators
+       advance together, one stride of lanes per step, each lane keeps its own order */
     FOR (b = 0; b < n_blocks; b++)
-    { /* block loop with  fixed pre_down shifting(inshift) of input signal  */
-        curr   = shr_pos(currFrame[b], inshift);
-        pred   = shr_pos(predFrame[b], inshift);
-        L_tmp2 = L_deposit_l(0);
-        L_tmp0 = L_msu0(L_tmp2, curr, pred); /*   acc L_tmp0 on negative side to avoid saturation for  (-1*-1)  */
-        L_tmp1 = L_msu0(L_tmp2, pred, pred); /*   acc_energy on negative side    */
-        L_tmp2 = L_msu0(L_tmp2, curr, curr); /*   acc_energy on negative side    */
-
-        FOR (m = (b + n_blocks); m < tot_len; m += n_blocks)
-        { /* interleaved accumulation over total length */
-            curr   = shr_pos(currFrame[m], inshift);
-            pred   = shr_pos(predFrame[m], inshift);
-            L_tmp0 = L_msu0(L_tmp0, curr, pred);
-            L_tmp1 = L_msu0(L_tmp1, pred, pred);
-            L_tmp2 = L_msu0(L_tmp2, curr, curr);
-        }
+    { /* first stride, fixed pre_down shifting(inshift) of input signal  */
+        curr       = shr_pos(currFrame[b], inshift);
+        pred       = shr_pos(predFrame[b], inshift);
+        L_ce[0][b] = L_msu0(0, curr, pred); /*   acc corr on negative side to avoid saturation for  (-1*-1)  */
+        L_ce[1][b] = L_msu0(0, pred, pred); /*   acc_energy on negative side    */
+        L_ce[2][b] = L_msu0(0, curr, curr); /*   acc_energy on negative side    */
+    }
 
-        L_ce[0][b] = L_add(L_tmp0, 0); /* account for moves from register to stack memory */
-        L_ce[1][b] = L_add(L_tmp1, 0);
-        L_ce[2][b] = L_add(L_tmp2, 0);
+    FOR (m = n_blocks; m < tot_len; m += n_blocks)
+    { /* interleaved accumulation over total length */
+        n_lanes = s_min(n_blocks, sub(tot_len, m));
+        FOR (b = 0; b < n_lanes; b++)
+        {
+            curr       = shr_pos(currFrame[m + b], inshift);
+            pred       = shr_pos(predFrame[m + b], inshift);
+            L_ce[0][b] = L_msu0(L_ce[0][b], curr, pred);
+            L_ce[1][b] = L_msu0(L_ce[1][b], pred, pred);
+            L_ce[2][b] = L_msu0(L_ce[2][b], curr, curr);
+        }
     }
 
     /* aggregate  interleaved subsections */
@@ -21,7 +21,6 @@ Word16 pvq_dec_deidx_fx(                          /* out BER detected 1 , ok==0
 {
     Dyn_Mem_Deluxe_In(
         Word16      BER_flag;
-        UWord32     h_mem[1 + KMAX_FX + 1];
         PvqEntry_fx entry;
     );
 
@@ -29,7 +28,7 @@ Word16 pvq_dec_deidx_fx(                          /* out BER detected 1 , ok==0
 
     /* get_size will likely be called before this function,     as the range decoder needs the size to fetch the index
      */
-    entry = get_size_mpvq_calc_offset_fx(dim, k_val, h_mem); /* TBD should be made into tables for N=16,10,6  */
+    entry = get_size_mpvq_fx(dim, k_val); /* offsets from the precomputed tables for N=16,10,6 */
 
     entry.lead_sign_ind = LS_ind;         
     entry.index         = L_deposit_l(0); /* only  in case dim == 1 */
@@ -44,7 +43,7 @@ Word16 pvq_dec_deidx_fx(                          /* out BER detected 1 , ok==0
             entry.index = 0;  /* return something deterministic/valid, and LOW complex  */
         }
     }
-    mpvq_deindex_fx(&entry, h_mem, y); /* actual deindexing  */
+    mpvq_deindex_fx(&entry, y); /* actual deindexing  */
 
     Dyn_Mem_Deluxe_Out();
     return BER_flag;
@@ -14,135 +14,6 @@
 #define SIGNBIT_SHRT_FX 0x8000
 
 
-static void initOffsets_fx(Word16 dim_in, UWord32 *h_mem,
-                           Word16 k_val_in) /* may be removed with tables for N=16,10,6  */
-{
-    UWord32 k_val_prev, k_val_curr;
-    UWord32 k_val, UL_k_val_in;
-#ifdef DYNMEM_COUNT
-    Dyn_Mem_In("initOffsets_fx", sizeof(struct {
-                   UWord32 k_val_prev, k_val_curr;
-                   UWord32 k_val, UL_k_val_in;
-               }));
-#endif
-
-    h_mem[0] = UL_deposit_l(0);
-    h_mem[1] = UL_deposit_l(1);
-
-    UL_k_val_in = UL_deposit_l(k_val_in);
-    IF (sub(dim_in, 2) == 0)
-    {
-        FOR (k_val = 2; k_val <= UL_k_val_in; k_val++)
-        {
-            h_mem[k_val] = UL_subNsD(UL_lshl(k_val, 1), 1U); 
-        }
-        h_mem[k_val] = UL_k_val_in; 
-    }
-    ELSE
-    {
-        k_val_prev = UL_deposit_l(1U);
-        FOR (k_val_curr = 2; k_val_curr <= UL_k_val_in; k_val_curr++)
-        {
-            h_mem[k_val_curr] = UL_addNsD(1U, UL_Mpy_32_32(k_val_curr, UL_lshl(k_val_prev, 1))); 
-            k_val_prev        = UL_addNsD(k_val_curr, 0U);
-        }
-        h_mem[k_val_curr] = UL_Mpy_32_32(k_val_curr, k_val_prev); 
-    }
-
-#ifdef DYNMEM_COUNT
-    Dyn_Mem_Out();
-#endif
-}
-
-static void a_fwd_fx(UWord32 *a_in,   /* i/o: offsets   */
-                     Word16   n_items /* i  :  items, k's  */
-)
-{
-    UWord32  a_1, a_in0;
-    Counter  i;
-    UWord32 *a_in_prev_ptr;
-
-#ifdef DYNMEM_COUNT
-    Dyn_Mem_In("a_fwd_fx", sizeof(struct {
-                   UWord32  a_1, a_in0;
-                   Counter  i;
-                   UWord32 *a_in_prev_ptr;
-               }));
-#endif
-
-    a_in0 = UL_deposit_l(1);
-
-    a_in_prev_ptr = &(a_in[-1]);
-    FOR (i = 1; i <= n_items; i++)
-    {
-        a_1              = UL_addNsD(a_in0, UL_addNsD(a_in_prev_ptr[i], a_in[i]));
-        a_in_prev_ptr[i] = a_in0; 
-        a_in0            = UL_addNsD(a_1, 0U);
-    }
-    a_in_prev_ptr[i] = a_in0; 
-
-#ifdef DYNMEM_COUNT
-    Dyn_Mem_Out();
-#endif
-}
-
-static void a_bwd_fx(UWord32 *a_in,   /* i/o: offsets   */
-                     Word16   n_items /* i:  n_items  */
-)
-{
-    UWord32  a_1, a_in0;
-    Counter  i;
-    UWord32 *a_in_prev_ptr;
-
-#ifdef DYNMEM_COUNT
-    Dyn_Mem_In("a_bwd_fx", sizeof(struct {
-                   UWord32  a_1, a_in0;
-                   Counter  i;
-                   UWord32 *a_in_prev_ptr;
-               }));
-#endif
-
-    a_in0         = UL_deposit_l(0);
-    a_in_prev_ptr = &(a_in[-1]);
-
-    FOR (i = 1; i <= n_items; i++)
-    {
-        a_1              = UL_subNsD(UL_subNsD(a_in[i], a_in0), a_in_prev_ptr[i]);
-        a_in_prev_ptr[i] = a_in0; 
-        a_in0            = UL_addNsD(a_1, 0U);
-    }
-    a_in_prev_ptr[i] = a_in0; 
-
-#ifdef DYNMEM_COUNT
-    Dyn_Mem_Out();
-#endif
-}
-
-static void a_u_fwd_fx(UWord32 *a_u_in, Word16 k_val_in, Word16 mem_size_m1)
-{
-    UWord32 u_kp1_prev, u_kp1;
-    UWord32 u_k_prev;
-
-#ifdef DYNMEM_COUNT
-    Dyn_Mem_In("a_u_fwd_fx", sizeof(struct {
-                   UWord32 u_kp1_prev, u_kp1;
-                   UWord32 u_k_prev;
-               }));
-#endif
-
-    u_kp1_prev = a_u_in[mem_size_m1]; 
-    u_k_prev   = UL_lshr(a_u_in[k_val_in], 1);
-
-    a_fwd_fx(&a_u_in[1], k_val_in);
-
-    u_kp1               = UL_lshr(a_u_in[k_val_in], 1);
-    a_u_in[mem_size_m1] = UL_addNsD(1U, UL_addNsD(u_kp1_prev, UL_addNsD(u_k_prev, u_kp1)));
-
-#ifdef DYNMEM_COUNT
-    Dyn_Mem_Out();
-#endif
-}
-
 static Word16 get_lead_sign_fx(UWord32 *ind)
 {
     Word16 leading_sign;
@@ -202,27 +73,29 @@ static void mind2vec_fx(Word16   dim_in,       /* i:  dimension        */
                         Word16   k_max_local,  /* i:  nb unit pulses   */
                         Word16   leading_sign, /* i: leading sign  */
                         UWord32  ind,          /* i:  index            */
-                        Word16 * vec_out,      /* o:  pulse train      */
-                        UWord32 *h_in          /* i:  offset vector   A=1+2U  */
+                        Word16 * vec_out       /* o:  pulse train      */
 )
 {
-    Counter pos;
-    Word16  k_acc, k_delta;
-    UWord32 UL_tmp_offset, UL_diff;
-    UWord16 sgn;
+    Counter        pos;
+    Word16         k_acc, k_delta;
+    UWord32        UL_tmp_offset, UL_diff;
+    UWord16        sgn;
+    const UWord32 *h_in;
 
 #ifdef DYNMEM_COUNT
     Dyn_Mem_In("mind2vec_fx", sizeof(struct {
-                   Counter pos;
-                   Word16  k_acc, k_delta;
-                   UWord32 UL_tmp_offset, UL_diff;
-                   UWord16 sgn;
+                   Counter        pos;
+                   Word16         k_acc, k_delta;
+                   UWord32        UL_tmp_offset, UL_diff;
+                   UWord16        sgn;
+                   const UWord32 *h_in;
                }));
 #endif
 
     k_acc = k_max_local; 
     FOR (pos = 0; pos < dim_in; pos++)
     {
+        h_in = mpvq_offsets[sub(dim_in, pos)]; /* offsets A=1+2U of the remaining positions */
 
         IF (ind != 0)
         {
@@ -249,8 +122,6 @@ static void mind2vec_fx(Word16   dim_in,       /* i:  dimension        */
         }
 
         k_max_local = setval_update_sign_fx(k_delta, k_max_local, &leading_sign, &ind, &vec_out[pos]);
-
-        a_bwd_fx(h_in, add(k_max_local, 1));
     }
 
 #ifdef DYNMEM_COUNT
@@ -258,22 +129,15 @@ static void mind2vec_fx(Word16   dim_in,       /* i:  dimension        */
 #endif
 }
 
-PvqEntry_fx get_size_mpvq_calc_offset_fx(                   /* o : size, dim, k_val        */
-                                         Word16   dim_in,   /* i : dimension                */
-                                         Word16   k_val_in, /* i : nb unit pulses           */
-                                         UWord32 *h_mem     /* o : offsets                  */
+PvqEntry_fx get_size_mpvq_fx(                   /* o : size, dim, k_val        */
+                             Word16 dim_in,   /* i : dimension                */
+                             Word16 k_val_in  /* i : nb unit pulses           */
 )
 {
-    Counter     i;
     PvqEntry_fx entry;
-    Word16      kp1;
 
 #ifdef DYNMEM_COUNT
-    Dyn_Mem_In("get_size_mpvq_calc_offset_fx", sizeof(struct {
-                   Counter     i;
-                   PvqEntry_fx entry;
-                   Word16      kp1;
-               }));
+    Dyn_Mem_In("get_size_mpvq_fx", sizeof(struct { PvqEntry_fx entry; }));
 #endif
 
     entry.dim   = dim_in;   
@@ -283,22 +147,11 @@ PvqEntry_fx get_size_mpvq_calc_offset_fx(                   /* o : size, dim, k_
     entry.lead_sign_ind = 0; 
 
     ASSERT(dim_in <= M);
-    ASSERT(tabledKMAX[dim_in] != 0);
+    ASSERT(k_val_in <= KMAX_FX);
 
-    /* tabled values for worst case K */ /* made into table lookup for N=16, 10, 6  */
-    kp1 = add(k_val_in, 1);
-    FOR (i = 0; i <= kp1; i++) /* A+U copying */
-    {
-        h_mem[i] =
-            UL_addNsD(MPVQ_offs_ptr[dim_in][i], 0U); /* a vector  copying is needed as MPVQ recursion is in place */
-    }
-    /* special handling of last  U offset   in k+1 column  */
-    if (sub(k_val_in, tabledKMAX[dim_in]) != 0)
-    {
-        h_mem[kp1] = UL_lshr(h_mem[kp1], 1); /* (A+1)/2 , convert from  A(K+1) to  U(K+1)  domain */
-    }
-    entry.size =
-        UL_addNsD(1U, UL_addNsD(h_mem[kp1], UL_lshr(h_mem[k_val_in], 1))); /* MPVQ size calc. 1 + H(K+1) + (A(K)>>1) */
+    /* MPVQ size calc. 1 + U(K+1) + (A(K)>>1) */
+    entry.size = UL_addNsD(1U, UL_addNsD(UL_lshr(mpvq_offsets[dim_in][add(k_val_in, 1)], 1),
+                                         UL_lshr(mpvq_offsets[dim_in][k_val_in], 1)));
 
 #ifdef DYNMEM_COUNT
     Dyn_Mem_Out();
@@ -312,7 +165,6 @@ PvqEntry_fx get_size_mpvq_calc_offset_fx(                   /* o : size, dim, k_
  *-------------------------------------------------------------------*/
 void mpvq_deindex_fx(                           /* o :  void                        */
                      const PvqEntry_fx *entry,  /* i :  sign_ind, index, dim, k_val */
-                     UWord32 *          h_mem,  /* i :  A/U offsets                 */
                      Word16 *           vec_out /* o :  pulse train                 */
 )
 {
@@ -332,7 +184,7 @@ void mpvq_deindex_fx(                           /* o :  void
 
     IF (entry->k_val != 0)
     {
-        mind2vec_fx(entry->dim, entry->k_val, leading_sign, entry->index, vec_out, h_mem);
+        mind2vec_fx(entry->dim, entry->k_val, leading_sign, entry->index, vec_out);
     }
 #ifdef DYNMEM_COUNT
     Dyn_Mem_Out();
@@ -424,45 +276,35 @@ static void vec2mind_fx(Word16        dim_in,        /* i :  dim
                         const Word16 *vec_in,        /* i :  PVQ pulse train           */
                         UWord32 *     next_sign_ind, /* o :  pushed leading sign       */
                         UWord32 *     index,         /* o :  MPVQ index                */
-                        UWord32 *     N_MPVQ_ptr,    /* o :  size(N_MPVQ(dim,K_val_in))*/
-                        UWord32 *     h_mem)              /* o :  offsets                   */
+                        UWord32 *     N_MPVQ_ptr)    /* o :  size(N_MPVQ(dim,K_val_in))*/
 {
     Counter pos;
-    Word16  mem_size_m1, k_val_acc, tmp_val;
-    UWord32 tmp_h;
+    Word16  k_val_acc, tmp_val;
 
 #ifdef DYNMEM_COUNT
     Dyn_Mem_In("vec2mind_fx", sizeof(struct {
                    Counter pos;
-                   Word16  mem_size_m1, k_val_acc, tmp_val;
-                   UWord32 tmp_h;
+                   Word16  k_val_acc, tmp_val;
                }));
 #endif
 
-    mem_size_m1    = add(k_val_in, 1);
     *next_sign_ind = UL_deposit_h(SIGNBIT_SHRT_FX);
 
     pos = sub(dim_in, 2);
     vec2mind_two_fx(&vec_in[pos], &k_val_acc, next_sign_ind, index);
-    initOffsets_fx(3, h_mem, k_val_in);
-
-    tmp_h = h_mem[k_val_acc]; 
     FOR (pos--; pos >= 0; pos--)
     {
         tmp_val = vec_in[pos]; 
         enc_push_sign(tmp_val, next_sign_ind, index);
 
-        *index = UL_addNsD(*index, tmp_h);
+        /* offset of the pulses right of pos, row of the positions from pos to the end */
+        *index = UL_addNsD(*index, mpvq_offsets[sub(dim_in, pos)][k_val_acc]);
 
         k_val_acc = add(k_val_acc, abs_s(tmp_val));
-
-        IF (pos != 0)
-        {
-            a_u_fwd_fx(h_mem, k_val_in, mem_size_m1);
-        }
-        tmp_h = UL_addNsD(h_mem[k_val_acc], 0U);
     }
-    *N_MPVQ_ptr = UL_addNsD(1U, UL_addNsD(UL_lshr(tmp_h, 1), h_mem[mem_size_m1])); 
+    ASSERT(k_val_acc == k_val_in);
+    *N_MPVQ_ptr = UL_addNsD(1U, UL_addNsD(UL_lshr(mpvq_offsets[dim_in][k_val_in], 1),
+                                         UL_lshr(mpvq_offsets[dim_in][add(k_val_in, 1)], 1))); 
 
 #ifdef DYNMEM_COUNT
     Dyn_Mem_Out();
@@ -476,13 +318,11 @@ PvqEntry_fx mpvq_index_fx(                          /* o : leading_sign_index, i
 )
 {
     PvqEntry_fx result;
-    UWord32     h_mem[1 + KMAX_FX + 1];
     UWord32     lead_sign_ind;
 
 #ifdef DYNMEM_COUNT
     Dyn_Mem_In("mpvq_index_fx", sizeof(struct {
                    PvqEntry_fx result;
-                   UWord32     h_mem[1 + KMAX_FX + 1];
                    UWord32     lead_sign_ind;
                }));
 #endif
@@ -493,7 +333,7 @@ PvqEntry_fx mpvq_index_fx(                          /* o : leading_sign_index, i
     result.k_val = k_val_local; 
     result.dim   = dim_in;      
 
-    vec2mind_fx(dim_in, k_val_local, vec_in, &lead_sign_ind, &result.index, &result.size, h_mem);
+    vec2mind_fx(dim_in, k_val_local, vec_in, &lead_sign_ind, &result.index, &result.size);
 
     result.lead_sign_ind = u_extract_l(lead_sign_ind);
 
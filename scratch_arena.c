@@ -0,0 +1,152 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+
+#include "functions.h"
+
+#ifdef DEBUG_SCRATCH
+#if defined(_MSC_VER)
+#define SCRATCH_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define SCRATCH_THREAD_LOCAL _Thread_local
+#else
+#define SCRATCH_THREAD_LOCAL __thread
+#endif
+
+/* arena handed out last on this thread, every thread runs its own arena */
+static SCRATCH_THREAD_LOCAL LC3_ScratchArena *scratch_arena_active = NULL;
+#endif
+
+/* if arena is null only size is reported. Parallel decoders take one aligned slice per channel */
+int alloc_scratch_arena(LC3_ScratchArena *arena, int samplerate, int channels)
+{
+    int dec_size     = DYN_DEC_SCRATCH_SIZE(samplerate) + DYN_DEC_SCRATCH_SIZE_APLC(samplerate);
+    int scratch_size = 0;
+
+    if (channels > 1)
+    {
+        dec_size = channels * ((dec_size + LC3_SCRATCH_ALIGN - 1) & ~(LC3_SCRATCH_ALIGN - 1));
+    }
+    scratch_size = MAX(DYN_ENC_SCRATCH_SIZE(DYN_MAX_LEN(samplerate)), dec_size);
+
+    if (arena)
+    {
+        uintptr_t ptr  = ((uintptr_t)(arena + 1) + LC3_SCRATCH_ALIGN - 1) & ~(uintptr_t)(LC3_SCRATCH_ALIGN - 1);
+        arena->scratch = (Word8 *)ptr;
+        arena->size    = scratch_size;
+    }
+
+    return (int)sizeof(LC3_ScratchArena) + LC3_SCRATCH_ALIGN - 1 + scratch_size + SCRATCH_GUARD_LEN;
+}
+
+LC3_Error FillScratchArena(LC3_ScratchArena *arena, int samplerate, int channels)
+{
+    memset(arena, 0, sizeof(*arena));
+    alloc_scratch_arena(arena, samplerate, channels);
+    return LC3_OK;
+}
+
+/* called before the arena is used for an encoder or decoder call */
+void scratch_arena_begin(LC3_ScratchArena *arena)
+{
+#ifdef DEBUG_SCRATCH
+    memset(arena->scratch, SCRATCH_POISON, arena->size);
+    memset(arena->scratch + arena->size, SCRATCH_GUARD, SCRATCH_GUARD_LEN);
+    arena->violations    = 0;
+    arena->num_regions   = 0;
+    scratch_arena_active = arena;
+#else
+    UNUSED(arena);
+#endif
+}
+
+/* returns nonzero if the last call overran the arena */
+int scratch_arena_check(const LC3_ScratchArena *arena)
+{
+#ifdef DEBUG_SCRATCH
+    int i = 0;
+
+    for (i = 0; i < SCRATCH_GUARD_LEN; i++)
+    {
+        if (arena->scratch[arena->size + i] != (Word8)SCRATCH_GUARD)
+        {
+            return 1;
+        }
+    }
+    return arena->violations != 0;
+#else
+    UNUSED(arena);
+    return 0;
+#endif
+}
+
+/* scratchAlign() for DEBUG_SCRATCH builds. scratchAlign(ptr, offset) carves the region [ptr, ptr + offset)
+   and starts the next one behind it. Regions that leave the active arena are counted as violations, and so
+   are regions that intersect a live region without starting at the same address, since buffers that are
+   reused on purpose are carved again from their start. offset 0 starts a new chain of regions, e.g. in a
+   called function. Its base is handed over memory, so it ends all regions that reach beyond the base */
+void *scratch_align_check(void *ptr, int offset)
+{
+    Word8 *region = (Word8 *)ptr + offset;
+
+#ifdef DEBUG_SCRATCH
+    LC3_ScratchArena *arena = scratch_arena_active;
+    Word8 *           start = (Word8 *)ptr;
+    Word32            i = 0, n = 0;
+
+    if (arena == NULL)
+    {
+        return region;
+    }
+
+    if (start < arena->scratch || region > arena->scratch + arena->size)
+    {
+        arena->violations++;
+    }
+
+    if (offset == 0)
+    {
+        for (i = 0; i < arena->num_regions; i++)
+        {
+            if (arena->region_end[i] <= start)
+            {
+                arena->region_start[n] = arena->region_start[i];
+                arena->region_end[n]   = arena->region_end[i];
+                n++;
+            }
+        }
+        arena->num_regions = n;
+        return region;
+    }
+
+    for (i = 0; i < arena->num_regions; i++)
+    {
+        if (arena->region_start[i] == start)
+        {
+            arena->region_end[i] = MAX(arena->region_end[i], region);
+            return region;
+        }
+    }
+    for (i = 0; i < arena->num_regions; i++)
+    {
+        if (start < arena->region_end[i] && region > arena->region_start[i])
+        {
+            arena->violations++;
+        }
+    }
+    if (arena->num_regions < SCRATCH_MAX_REGIONS)
+    {
+        arena->region_start[arena->num_regions] = start;
+        arena->region_end[arena->num_regions]   = region;
+        arena->num_regions++;
+    }
+#endif
+
+    return region;
+}
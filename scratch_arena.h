@@ -0,0 +1,37 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+#ifndef SCRATCH_ARENA_H
+#define SCRATCH_ARENA_H
+
+#include "constants.h"
+
+#ifdef DEBUG_SCRATCH
+#define SCRATCH_POISON 0xA5
+#define SCRATCH_GUARD 0xCD
+#define SCRATCH_GUARD_LEN LC3_SCRATCH_ALIGN
+#define SCRATCH_MAX_REGIONS 64 /* live regions tracked per call, more are not checked for intersections */
+#else
+#define SCRATCH_GUARD_LEN 0
+#endif
+
+/* Scratch memory shared by all encoders and decoders run from one thread */
+struct LC3_ScratchArena
+{
+    Word8 *scratch;    /* LC3_SCRATCH_ALIGN aligned working memory */
+    Word32 size;       /* size of scratch in bytes, without guard */
+    Word32 violations; /* regions carved outside of scratch or into each other, DEBUG_SCRATCH only */
+#ifdef DEBUG_SCRATCH
+    Word8 *region_start[SCRATCH_MAX_REGIONS]; /* [start, end) of the regions carved so far */
+    Word8 *region_end[SCRATCH_MAX_REGIONS];
+    Word32 num_regions;
+#endif
+};
+
+#endif
@@ -27,7 +27,7 @@ int alloc_decoder(LC3_Dec *decoder, int samplerate, int channels, LC3_PlcMode pl
     for (ch = 0; ch < channels; ch++)
     {
         DecSetup *setup = balloc(decoder, &size, sizeof(DecSetup));
-        int q_old_len = MIN(samplerate/100, MAX_BW);  /* default init to 10ms frame size q_old length */
+        int q_old_len = MIN(DYN_MAX_DEC_LEN(samplerate), MAX_DEC_BW);  /* q_old length of the longest decoder frame */
         int x_old_len = DYN_MAX_LEN_PCM_PLC(samplerate) ; /* max(pitchmax + frame ms,  M+1 + pitchmax + frame/2) */
         int fs_idx    = (samplerate/10000);   /* floor= integer truncation is needed  here */ 
 
@@ -56,10 +56,13 @@ int alloc_decoder(LC3_Dec *decoder, int samplerate, int channels, LC3_PlcMode pl
         }
         if (plc_mode != LC3_PLC_STANDARD)
         {
-            int max_plocs = DYN_MAX_PLOCS(samplerate);
+            int max_plocs = DYN_PHECU_PLOCS(samplerate);
             plcAd         = balloc(decoder, &size, sizeof(*setup->plcAd));
-            PhECU_f0est    = balloc(decoder, &size, sizeof(*setup->plcAd->PhECU_f0est) * max_plocs);
-            PhECU_plocs    = balloc(decoder, &size, sizeof(*setup->plcAd->PhECU_plocs) * max_plocs);
+            if (max_plocs > 0)
+            {
+                PhECU_f0est    = balloc(decoder, &size, sizeof(*setup->plcAd->PhECU_f0est) * max_plocs);
+                PhECU_plocs    = balloc(decoder, &size, sizeof(*setup->plcAd->PhECU_plocs) * max_plocs);
+            }
         }
         q_old_res_fx = balloc(decoder, &size, sizeof(*setup->q_old_res_fx) * MIN(max_len, MAX_BW));
         if (decoder)
@@ -160,20 +163,23 @@ LC3_Error FillDecSetup(LC3_Dec *decoder, int samplerate, int channels, LC3_PlcMo
           setup->plcAd->PhECU_oold_Ltot_exp_fx = UNINIT_OR_UNSAFE_OOLD_SENTINEL;
           setup->plcAd->PhECU_old_Ltot_exp_fx = LTOT_INIT_FLAG;
 
-
+#if !BTLLC_5MS_MODE
           for (i = 0; i < MAX_LGW; i++)
           {
              setup->plcAd->PhECU_oold_grp_shape_fx[i] = GRP_SHAPE_INIT; /* negative value will be replaced in very first calculation */
              setup->plcAd->PhECU_old_grp_shape_fx[i] = GRP_SHAPE_INIT;
           }
+#endif
           /* t_adv=ctrl.FRAME/2 + ctrl.PhECU.LprotOrg/2 - ctrl.PhECU.LA + LDWIN_OLAP/2; */
           i = add(add(decoder->frame_length, setup->plcAd->PhECU_LprotOrg_fx), setup->plcAd->PhECU_LDWIN_OLAP);
           setup->plcAd->PhECU_t_adv = sub(shr_pos(i, 1), setup->plcAd->PhECU_LA);
 
+#if !BTLLC_5MS_MODE
             for (i = 0; i < MAX_LGW; i++)
             {
                 setup->plcAd->PhECU_mag_chg_1st[i] = 32767;
             }
+#endif
             setup->plcAd->PhECU_beta_mute = 16384;
         }
     }
@@ -252,64 +258,150 @@ void set_dec_frame_params(LC3_Dec *decoder)
       }
    }
 
+   decoder->kernels = select_kernels(decoder->fs_idx, decoder->frame_dms);
+
+   init_dec_bitrate_tab(decoder);
+
 }
 LC3_Error update_dec_bitrate(LC3_Dec *decoder, int ch, Word16 nBytes)
 {
-    int tmp = 0, totalBits = 0;
-    int channel_bytes = 0;
-
+    const DecBitrateTab *tab = &decoder->br_tab;
     DecSetup *setup = decoder->channel_setup[ch];
-    channel_bytes   = nBytes;
+    int       i     = 0;
 
-    setup->targetBytes          = channel_bytes; 
+    if (nBytes < MIN_NBYTES || nBytes > MAX_NBYTES)
+    {
+        return LC3_NUMBYTES_ERROR;
+    }
+
+    setup->targetBytes          = nBytes;
     setup->total_bits           = shl(setup->targetBytes, 3);
-    setup->enable_lpc_weighting = (setup->total_bits < 480);
+    setup->enable_lpc_weighting = nBytes < tab->lpc_weighting_max_bytes;
     setup->quantizedGainOff =
         -(s_min(115, setup->total_bits / (10 * (decoder->fs_idx + 1))) + 105 + 5 * (decoder->fs_idx + 1));
-    tmp       = i_mult(80, decoder->fs_idx);
-    totalBits = setup->total_bits;
 
-    SWITCH (decoder->frame_dms)
+    setup->ltpf_scale_fac_idx = -1;
+    for (i = 0; i < 4; i++)
     {
-    case 25:
-        setup->enable_lpc_weighting = 0;
-        /* total_bits * 2.4 */
-        totalBits = extract_l(L_shr(L_mult0(19661, setup->total_bits), 13));
-        BREAK;
-    case 50:
-        setup->enable_lpc_weighting = setup->total_bits < 240;
-        totalBits                   = sub(i_mult(setup->total_bits, 2), 160);
-        BREAK;
-    case 100:
-        BREAK;
+        if (nBytes < tab->ltpf_scale_max_bytes[i])
+        {
+            setup->ltpf_scale_fac_idx = i;
+            break;
+        }
     }
 
-    if (channel_bytes < MIN_NBYTES || channel_bytes > MAX_NBYTES)
-    {
-        return LC3_NUMBYTES_ERROR;
-    }
+    return LC3_OK;
+}
 
-    if (sub(totalBits, add(320, tmp)) < 0)
+static Word16 dec_lpc_weighting(LC3_Dec *decoder, Word16 total_bits)
+{
+    SWITCH (decoder->frame_dms)
     {
-        setup->ltpf_scale_fac_idx = 0; 
+    case 25: return 0;
+    case 50: return total_bits < 240;
+    default: return total_bits < 480;
     }
-    else if (sub(totalBits, add(400, tmp)) < 0)
+}
+
+static Word16 dec_ltpf_total_bits(LC3_Dec *decoder, Word16 total_bits)
+{
+    SWITCH (decoder->frame_dms)
     {
-        setup->ltpf_scale_fac_idx = 1; 
+    case 25:
+        /* total_bits * 2.4 */
+        return extract_l(L_shr(L_mult0(19661, total_bits), 13));
+    case 50:
+        return sub(i_mult(total_bits, 2), 160);
+    default:
+        return total_bits;
     }
-    else if (sub(totalBits, add(480, tmp)) < 0)
+}
+
+/* find the steps of the bitrate dependent parameters for the current frame size, not time critical */
+void init_dec_bitrate_tab(LC3_Dec *decoder)
+{
+    DecBitrateTab *tab = &decoder->br_tab;
+    Word16         tmp = i_mult(80, decoder->fs_idx);
+    Word16         b = 0, i = 0;
+
+    for (b = MIN_NBYTES; b <= MAX_NBYTES && dec_lpc_weighting(decoder, shl(b, 3)); b++)
+        ;
+    tab->lpc_weighting_max_bytes = b;
+
+    /* ltpf_scale_fac_idx i for totalBits below 320 + 80 * i + tmp */
+    b = MIN_NBYTES;
+    for (i = 0; i < 4; i++)
     {
-        setup->ltpf_scale_fac_idx = 2; 
+        for (; b <= MAX_NBYTES && sub(dec_ltpf_total_bits(decoder, shl(b, 3)), add(add(320, i_mult(80, i)), tmp)) < 0; b++)
+            ;
+        tab->ltpf_scale_max_bytes[i] = b;
     }
-    else if (sub(totalBits, add(560, tmp)) < 0)
+}
+
+/* scratch of one Dec_LC3_Channel() call, parallel channels get slices rounded up to LC3_SCRATCH_ALIGN */
+int dec_channel_scratch_size(const LC3_Dec *decoder, int slice)
+{
+    int size = DYN_DEC_SCRATCH_SIZE(decoder->fs);
+
+    if (decoder->plcMeth != LC3_PLC_STANDARD)
+        size += DYN_DEC_SCRATCH_SIZE_APLC(decoder->fs);
+    if (slice)
+        size = (size + LC3_SCRATCH_ALIGN - 1) & ~(LC3_SCRATCH_ALIGN - 1);
+
+    return size;
+}
+
+/* speculation buffer: decoder state image followed by the output of the concealed next frame,
+   only the size is returned if decoder is NULL */
+int alloc_dec_speculation(LC3_Dec *decoder, void *buffer, int samplerate, int channels, LC3_PlcMode plc_mode)
+{
+    size_t size       = 0;
+    int    state_size = alloc_decoder(NULL, samplerate, channels, plc_mode);
+    void * spec_state = NULL, *spec_pcm = NULL;
+
+    spec_state = balloc(buffer, &size, state_size);
+    spec_pcm   = balloc(buffer, &size, sizeof(Word32) * channels * DYN_MAX_LEN(samplerate));
+
+    if (decoder && buffer)
     {
-        setup->ltpf_scale_fac_idx = 3; 
+        decoder->spec_state = spec_state;
+        decoder->spec_pcm   = spec_pcm;
     }
-    else
+
+    return (int)size;
+}
+
+/* channel buffers of a state snapshot, only the part that carries over to the next frame */
+int dec_snapshot_buffers(const LC3_Dec *decoder, int ch, void **buf, int *len)
+{
+    DecSetup *setup   = decoder->channel_setup[ch];
+    int       max_len = DYN_MAX_LEN_EXT(decoder->fs_out);
+    int       n       = 0;
+
+    buf[n]   = setup->ltpf_mem_x;
+    len[n++] = sizeof(*setup->ltpf_mem_x) * decoder->ltpf_mem_x_len;
+    buf[n]   = setup->ltpf_mem_y;
+    len[n++] = sizeof(*setup->ltpf_mem_y) * decoder->ltpf_mem_y_len;
+    buf[n]   = setup->stDec_ola_mem_fx;
+    len[n++] = sizeof(*setup->stDec_ola_mem_fx) * decoder->stDec_ola_mem_fx_len;
+    buf[n]   = setup->q_old_res_fx;
+    len[n++] = sizeof(*setup->q_old_res_fx) * MIN(max_len, MAX_BW);
+    buf[n]   = setup->q_old_d_fx;
+    len[n++] = sizeof(*setup->q_old_d_fx) * MIN(DYN_MAX_DEC_LEN(decoder->fs_out), MAX_DEC_BW);
+
+    if (setup->plcAd)
     {
-        setup->ltpf_scale_fac_idx = -1; 
+        /* PhECU_X_sav_fx runs from q_old_d_fx into x_old_tot_fx, both are kept as one block */
+        len[n - 1] = (int)((Word8 *)&setup->plcAd->x_old_tot_fx[DYN_MAX_LEN_PCM_PLC(decoder->fs_out)] -
+                           (Word8 *)setup->q_old_d_fx);
+        if (setup->plcAd->PhECU_f0est)
+        {
+            buf[n]   = setup->plcAd->PhECU_f0est;
+            len[n++] = sizeof(*setup->plcAd->PhECU_f0est) * DYN_PHECU_PLOCS(decoder->fs_out);
+            buf[n]   = setup->plcAd->PhECU_plocs;
+            len[n++] = sizeof(*setup->plcAd->PhECU_plocs) * DYN_PHECU_PLOCS(decoder->fs_out);
+        }
     }
 
-    return LC3_OK;
+    return n;
 }
-
@@ -11,8 +11,9 @@
 #define SETUP_DEC_LC3_H
 
 #include "constants.h"
+#include "kernels_cfg.h"
 
-typedef struct
+typedef struct AplcSetup
 {
     Word16 *x_old_tot_fx;      /* MAX_LEN_PCM_PLC_TOT    */
     Word32 *PhECU_f0est;       /* MAX_PLOCS            interpolated plocs  */
@@ -61,11 +62,13 @@ typedef struct
     Word32  PhECU_L_old_xfp_w_E_fx;
     Word16  PhECU_oold_xfp_w_E_exp_fx;   /* input Word16 xfp exponnet  */
     Word16  PhECU_old_xfp_w_E_exp_fx;  
+    Word16  PhECU_margin_xfp; 
+#if !BTLLC_5MS_MODE
     Word16  PhECU_oold_grp_shape_fx[MAX_LGW] ALIGN_BUFFER_STRUCT;
     Word16  PhECU_old_grp_shape_fx[MAX_LGW] ALIGN_BUFFER_STRUCT;
-    Word16  PhECU_margin_xfp; 
     Word16  PhECU_mag_chg_1st[MAX_LGW] ALIGN_BUFFER_STRUCT;
     Word16  PhECU_Xavg[MAX_LGW] ALIGN_BUFFER_STRUCT;
+#endif
     Word16  old_scf_q[M] ALIGN_BUFFER_STRUCT;
     Word16  old_old_scf_q[M] ALIGN_BUFFER_STRUCT;
     Word16  tdc_A[M + 1] ALIGN_BUFFER_STRUCT;
@@ -111,6 +114,13 @@ typedef struct
     Word16 last_size;
 } DecSetup;
 
+/* Bitrate dependent parameters are step functions of the channel bytes, the steps are kept here */
+typedef struct
+{
+    Word16 lpc_weighting_max_bytes; /* lpc weighting enabled below */
+    Word16 ltpf_scale_max_bytes[4]; /* ltpf_scale_fac_idx i below entry i, -1 above all */
+} DecBitrateTab;
+
 /* Constants and sampling rate derived values go in this struct */
 struct LC3_Dec
 {
@@ -119,12 +129,18 @@ struct LC3_Dec
     const Word16 *W_fx;
 #endif
     const Word16 *bands_offset;
+    const LC3_Kernels *kernels;  /* selected in set_dec_frame_params() */
     Word32        fs;           /* sampling rate, 44.1 maps to 48 */
     Word32        fs_out;       /* output sampling rate */
     Word16        fs_idx;       /* sampling rate index */
     Word16        frame_length; /* sampling rate index */
     Word16        channels;     /* number of channels */
     Word16        plcMeth;      /* PLC method for all channels */
+    LC3_Dec *     spec_state;   /* state after concealing the next frame or NULL if speculation is off */
+    Word32 *      spec_pcm;     /* output of the concealed next frame, channels * DYN_MAX_LEN */
+    Word16        spec_bits;    /* bits per sample of spec_pcm or 0 if no concealed frame is pending */
+    LC3_ParallelFor parallel_for;  /* runs the channels of a frame as parallel jobs or NULL */
+    void *        parallel_user; /* user argument of parallel_for */
     Word16        frame_dms;    /* frame length in dms (decimilliseconds, 10^-4)*/
     Word16        last_size;    /* size of last frame, without error protection */
     Word16        ep_enabled;   /* error protection enabled */
@@ -148,6 +164,7 @@ struct LC3_Dec
     Word16 ltpf_mem_x_len;
     Word16 ltpf_mem_y_len;
     Word16 BW_cutoff_bits;
+    DecBitrateTab br_tab;
 };
 
 #endif
@@ -114,6 +114,10 @@ void set_enc_frame_params(LC3_Enc *encoder)
         encoder->ltpf_mem_in_len    = LTPF_MEMIN_LEN;
         BREAK;
     }
+
+    encoder->kernels = select_kernels(encoder->fs_idx, encoder->frame_dms);
+
+    init_enc_bitrate_tab(encoder);
 }
 
 /* change encoder bitrate */
@@ -187,81 +191,200 @@ LC3_Error update_enc_bitrate(LC3_Enc *encoder, int bitrate)
 			setup->n_pc = 0;// fec_get_n_pc(encoder->epmode, setup->n_pccw, channel_bytes);
         }
 
-        if (encoder->fs_in == 44100)
-        {
-            max_bytes = MAX_NBYTES;
-        }
-        else
-        {
-            max_bytes = MAX_NBYTES_RED;
-        }
-
-        if (setup->targetBytes < MIN_NBYTES || setup->targetBytes > max_bytes)
+        if (setup->targetBytes < MIN_NBYTES || setup->targetBytes > encoder->br_tab.max_bytes)
         {
             return LC3_BITRATE_ERROR;
         }
 
-        setup->total_bits = shl(setup->targetBytes, 3);
-        setup->targetBitsInit =
-            sub(setup->total_bits,
-                add(encoder->envelope_bits,
-                    add(encoder->global_gain_bits, add(encoder->noise_fac_bits, encoder->BW_cutoff_bits))));
-        setup->targetBitsInit = sub(setup->targetBitsInit, sub(17, norm_s(sub(encoder->yLen, 1))));
-        if (setup->total_bits > 1280)
-        {
-            setup->targetBitsInit = sub(setup->targetBitsInit, 1);
-        }
-        if (setup->total_bits > 2560)
-        {
-            setup->targetBitsInit = sub(setup->targetBitsInit, 1);
-        }
+        setup->silence_bytes = 0;
+        set_enc_channel_bytes(encoder, setup, setup->targetBytes);
+    }
 
-        setup->targetBitsAri = setup->total_bits;
+    encoder->bitrate = bitrate;
 
-        SWITCH (encoder->frame_dms)
-        {
-        case 25:
-            /* 9830 = 2.4 * 2^12 */
-            setup->ltpf_enable =
-                sub(extract_l(L_shr(L_mult0(9830, setup->total_bits), 12)), add(560, i_mult(80, encoder->fs_idx))) < 0;
-            setup->enable_lpc_weighting = 0;
-            BREAK;
-        case 50:
-            setup->ltpf_enable = sub(sub(i_mult(setup->total_bits, 2), 160), add(560, i_mult(80, encoder->fs_idx))) < 0;
-            setup->enable_lpc_weighting = setup->total_bits < 240;
-            BREAK;
-        case 100:
-            setup->enable_lpc_weighting = setup->total_bits < 480;
-            setup->ltpf_enable          = sub(setup->total_bits, add(560, i_mult(80, encoder->fs_idx))) < 0;
-            BREAK;
-        }
+    return LC3_OK;
+}
 
-        setup->quantizedGainOff =
-            -(s_min(115, setup->total_bits / (10 * (encoder->fs_idx + 1))) + 105 + 5 * (encoder->fs_idx + 1));
-        if (encoder->frame_dms == 100 && ((encoder->fs_in >= 44100 && setup->targetBytes >= 100) ||
-                                          (encoder->fs_in == 32000 && setup->targetBytes >= 81))
-#ifdef NONBE_FIX_NO_ATTACK_AT_HIGH_BR
-            && setup->targetBytes < 340
-#endif
-            )
-        {
-            setup->attack_handling = 1;
-        }
-        else
-        {
-            /* reset attack detector for bitrate switching */
-            setup->attack_handling      = 0;
-            setup->attdec_filter_mem[0] = 0;
-            setup->attdec_filter_mem[1] = 0;
-            setup->attdec_detected      = 0;
-            setup->attdec_position      = 0;
-            setup->attdec_acc_energy    = 0;
-            setup->attdec_scaling       = 0;
-        }
+/* change encoder frame size, constant cost for per frame switching */
+LC3_Error update_enc_nbytes(LC3_Enc *encoder, int nbytes)
+{
+    int ch = 0, channel_bytes = 0;
+
+    if (encoder->epmode > 0)
+    {
+        return LC3_EPMODE_ERROR;
     }
 
-    encoder->bitrate = bitrate;
+    if (nbytes < MIN_NBYTES * encoder->channels || nbytes > encoder->br_tab.max_bytes * encoder->channels)
+    {
+        return LC3_NUMBYTES_ERROR;
+    }
+
+    for (ch = 0; ch < encoder->channels; ch++)
+    {
+        channel_bytes = nbytes / encoder->channels + (ch < (nbytes % encoder->channels));
+        set_enc_channel_bytes(encoder, encoder->channel_setup[ch], channel_bytes);
+    }
+
+    /* smallest bitrate giving nbytes, keeps lc3_enc_get_num_bytes() consistent */
+    encoder->bitrate    = ((Word32)nbytes * 8 * encoder->fs_in + encoder->frame_length - 1) / encoder->frame_length;
+    encoder->lc3_br_set = 1;
 
     return LC3_OK;
 }
 
+/* set bitrate dependent channel parameters, bytes must be in range */
+void set_enc_channel_bytes(LC3_Enc *encoder, EncSetup *setup, Word16 bytes)
+{
+    const EncBitrateTab *tab = &encoder->br_tab;
+
+    if (bytes != setup->silence_bytes)
+    {
+        setup->silence_bytes = 0; /* the silence frame is only repeated at its size */
+    }
+
+    setup->targetBytes    = bytes;
+    setup->total_bits     = shl(bytes, 3);
+    setup->targetBitsInit = sub(setup->total_bits, tab->side_bits);
+    if (setup->total_bits > 1280)
+    {
+        setup->targetBitsInit = sub(setup->targetBitsInit, 1);
+    }
+    if (setup->total_bits > 2560)
+    {
+        setup->targetBitsInit = sub(setup->targetBitsInit, 1);
+    }
+
+    setup->targetBitsAri        = setup->total_bits;
+    setup->ltpf_enable          = bytes < tab->ltpf_max_bytes;
+    setup->enable_lpc_weighting = bytes < tab->lpc_weighting_max_bytes;
+    setup->quantizedGainOff =
+        -(s_min(115, setup->total_bits / (10 * (encoder->fs_idx + 1))) + 105 + 5 * (encoder->fs_idx + 1));
+
+    if (bytes >= tab->attack_min_bytes && bytes < tab->attack_max_bytes)
+    {
+        setup->attack_handling = 1;
+    }
+    else
+    {
+        /* reset attack detector for bitrate switching */
+        setup->attack_handling      = 0;
+        setup->attdec_filter_mem[0] = 0;
+        setup->attdec_filter_mem[1] = 0;
+        setup->attdec_detected      = 0;
+        setup->attdec_position      = 0;
+        setup->attdec_acc_energy    = 0;
+        setup->attdec_scaling       = 0;
+    }
+}
+
+/* resampler, pitch analysis, LTPF and attack detector restart from silence, as after init */
+void reset_enc_pitch_state(EncSetup *setup)
+{
+    memset(setup->resamp_mem32, 0, sizeof(setup->resamp_mem32));
+    memset(setup->r12k8_mem_50, 0, sizeof(setup->r12k8_mem_50));
+    memset(setup->r12k8_mem_in, 0, sizeof(setup->r12k8_mem_in));
+    memset(setup->r12k8_mem_out, 0, sizeof(setup->r12k8_mem_out));
+    memset(setup->olpa_mem_s12k8, 0, sizeof(setup->olpa_mem_s12k8));
+    memset(setup->olpa_mem_s6k4, 0, sizeof(setup->olpa_mem_s6k4));
+    memset(setup->ltpf_mem_in, 0, sizeof(setup->ltpf_mem_in));
+    setup->olpa_mem_s6k4_exp     = 0;
+    setup->olpa_mem_pitch        = 0;
+    setup->ltpf_mem_in_exp       = 0;
+    setup->ltpf_mem_normcorr     = 0;
+    setup->ltpf_mem_mem_normcorr = 0;
+    setup->ltpf_mem_ltpf_on      = 0;
+    setup->ltpf_mem_pitch        = 0;
+    setup->attdec_filter_mem[0]  = 0;
+    setup->attdec_filter_mem[1]  = 0;
+    setup->attdec_detected       = 0;
+    setup->attdec_position       = 0;
+    setup->attdec_acc_energy     = 0;
+    setup->attdec_scaling        = 0;
+}
+
+static Word16 enc_ltpf_enable(LC3_Enc *encoder, Word16 total_bits)
+{
+    SWITCH (encoder->frame_dms)
+    {
+    case 25:
+        /* 9830 = 2.4 * 2^12 */
+        return sub(extract_l(L_shr(L_mult0(9830, total_bits), 12)), add(560, i_mult(80, encoder->fs_idx))) < 0;
+    case 50:
+        return sub(sub(i_mult(total_bits, 2), 160), add(560, i_mult(80, encoder->fs_idx))) < 0;
+    default:
+        return sub(total_bits, add(560, i_mult(80, encoder->fs_idx))) < 0;
+    }
+}
+
+static Word16 enc_lpc_weighting(LC3_Enc *encoder, Word16 total_bits)
+{
+    SWITCH (encoder->frame_dms)
+    {
+    case 25: return 0;
+    case 50: return total_bits < 240;
+    default: return total_bits < 480;
+    }
+}
+
+static Word16 enc_attack_handling(LC3_Enc *encoder, Word16 bytes)
+{
+#ifdef DISABLE_ATTACK_HANDLING_5MS
+    /* code 5 ms frames as the releases before attack handling was enabled for them */
+    IF (encoder->frame_dms == 50)
+    {
+        return 0;
+    }
+#endif
+    /* 5 ms frames use the bitrate range of 10 ms frames */
+    IF (encoder->frame_dms == 50)
+    {
+        bytes = shl(bytes, 1);
+    }
+    return (encoder->frame_dms == 100 || encoder->frame_dms == 50) &&
+           ((encoder->fs_in >= 44100 && bytes >= 100) || (encoder->fs_in == 32000 && bytes >= 81))
+#ifdef NONBE_FIX_NO_ATTACK_AT_HIGH_BR
+           && bytes < 340
+#endif
+        ;
+}
+
+/* find the steps of the bitrate dependent parameters for the current frame size, not time critical */
+void init_enc_bitrate_tab(LC3_Enc *encoder)
+{
+    EncBitrateTab *tab = &encoder->br_tab;
+    Word16         b   = 0;
+
+    tab->max_bytes = encoder->fs_in == 44100 ? MAX_NBYTES : MAX_NBYTES_RED;
+    tab->side_bits = add(encoder->envelope_bits,
+                         add(encoder->global_gain_bits, add(encoder->noise_fac_bits, encoder->BW_cutoff_bits)));
+    tab->side_bits = add(tab->side_bits, sub(17, norm_s(sub(encoder->yLen, 1))));
+
+    for (b = MIN_NBYTES; b <= tab->max_bytes && enc_ltpf_enable(encoder, shl(b, 3)); b++)
+        ;
+    tab->ltpf_max_bytes = b;
+
+    for (b = MIN_NBYTES; b <= tab->max_bytes && enc_lpc_weighting(encoder, shl(b, 3)); b++)
+        ;
+    tab->lpc_weighting_max_bytes = b;
+
+    for (b = MIN_NBYTES; b <= tab->max_bytes && !enc_attack_handling(encoder, b); b++)
+        ;
+    tab->attack_min_bytes = b;
+    for (; b <= tab->max_bytes && enc_attack_handling(encoder, b); b++)
+        ;
+    tab->attack_max_bytes = b;
+}
+
+
+/* channel buffers of a state snapshot, only the part that carries over to the next frame */
+int enc_snapshot_buffers(const LC3_Enc *encoder, int ch, void **buf, int *len)
+{
+    EncSetup *setup = encoder->channel_setup[ch];
+    int       n     = 0;
+
+    buf[n]   = setup->stEnc_mdct_mem;
+    len[n++] = sizeof(*setup->stEnc_mdct_mem) * encoder->stEnc_mdct_mem_len;
+
+    return n;
+}
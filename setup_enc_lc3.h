@@ -11,6 +11,7 @@
 #define SETUP_ENC_LC3_H
 
 #include "constants.h"
+#include "kernels_cfg.h"
 
 #define X_EXP		15
 #define RESAMP_EXP	17
@@ -20,6 +21,7 @@ typedef struct
 {
     Word16 *stEnc_mdct_mem; /* MDCT_MEM_LEN_MAX */
     Word32 *mdct_mem32;     /* MDCT_MEM_LEN_MAX */
+    Word16  silence_bytes;  /* size of the cached silence frame, 0 if the state is not at rest */
     Word32  targetBitsOff;
     Word16  targetBytes;
     Word16  total_bits;
@@ -58,6 +60,17 @@ typedef struct
     Word16 n_pc;
 } EncSetup;
 
+/* Bitrate dependent parameters are step functions of the channel bytes, the steps are kept here */
+typedef struct
+{
+    Word16 max_bytes;               /* largest channel byte count */
+    Word16 side_bits;               /* side info bits subtracted for targetBitsInit */
+    Word16 ltpf_max_bytes;          /* ltpf enabled below */
+    Word16 lpc_weighting_max_bytes; /* lpc weighting enabled below */
+    Word16 attack_min_bytes;        /* attack handling enabled from */
+    Word16 attack_max_bytes;        /* attack handling enabled below */
+} EncBitrateTab;
+
 /* Constants and sampling rate derived values go in this struct */
 struct LC3_Enc
 {
@@ -66,6 +79,8 @@ struct LC3_Enc
     const Word16 *W_fx;
 #endif
     const Word16 *bands_offset;
+    const LC3_Kernels *kernels; /* selected in set_enc_frame_params() */
+    UWord8 *silence_cache;      /* MAX_NBYTES per channel, set by lc3_enc_set_silence_cache() or NULL */
 
     Word32 fs;           /* encoder sampling rate 44.1 -> 48 */
     Word32 fs_in;        /* input sampling rate */
@@ -76,6 +91,7 @@ struct LC3_Enc
     Word16 epmode;       /* error protection mode */
     Word16 frame_dms;    /* frame length in dms (decimilliseconds, 10^-4)*/
     Word8  lc3_br_set;   /* indicate if bitrate has been set */
+    Word8  complexity;   /* LC3_EncComplexity, may change between frames */
 
     Word16 yLen;
 #if !BTLLC_5MS_MODE
@@ -98,6 +114,7 @@ struct LC3_Enc
     Word32 bandwidth;
     Word16 bw_ctrl_cutoff_bin;
     Word16 bw_index;
+    EncBitrateTab br_tab;
 };
 
 #endif
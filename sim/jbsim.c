@@ -0,0 +1,502 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+/* Trace driven simulation of the adaptive jitter buffer, built with "make jbsim".
+
+   The frames of a stream are delivered at the arrival times of a network trace and taken out of the
+   jitter buffer once per frame duration on the receiver clock. A trace is a text file with one line
+   per frame in sending order, "send_ms arrival_ms", where an arrival time below 0 marks a lost frame.
+   Lines starting with # are skipped. Without a trace file a synthetic one is generated: a fixed
+   network delay plus exponential jitter, random losses and delay spikes in which the frames queue
+   up and arrive in a burst.
+
+   Every frame carries its index in 4 extra bytes, so the mouth to ear latency (playout time minus
+   send time) is known for every played frame. The result is compared with the lowest fixed playout
+   delay that would have lost the same number of frames, which is only known in hindsight. With -o
+   a test signal is encoded, the frames go through the jitter buffer and the decoded output is
+   written to a wav file. */
+
+#include "lc3.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tinywaveout_c.h"
+
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define TAG_BYTES 4
+#define NETWORK_DELAY_MS 20.0 /* fixed part of the delay of synthetic traces */
+#define SPIKE_MS 150.0        /* highest delay spike of synthetic traces */
+
+/* struct to hold command line arguments */
+typedef struct
+{
+    char * traceFilename;
+    char * saveFilename;
+    char * outputFilename;
+    int    samplerate;
+    float  frame_ms;
+    float  target;
+    int    max_delay;
+    int    frames;
+    double jitter;
+    double loss;
+    double spikes;
+    double drift;
+    int    seed;
+    int    bitrate;
+} Arguments;
+
+/* one frame of the trace, times in us */
+typedef struct
+{
+    int64_t send;
+    int64_t arrival; /* < 0 if lost */
+    int     index;
+} Packet;
+
+static const char *const USAGE_MESSAGE =
+    "Usage: jbsim [OPTIONS] [TRACE]\n\n"
+    "  TRACE                   Text file with one line \"send_ms arrival_ms\" per frame, arrival < 0\n"
+    "                          for lost frames. Without it a synthetic trace is generated.\n\n"
+    "Jitter buffer options:\n"
+    "  -samplerate N           Sampling rate, default 48000.\n"
+    "  -frame_ms N             Frame length in ms, default 5.\n"
+    "  -target N               Target late loss in percent, default 1.\n"
+    "  -max_delay N            Highest playout delay in ms, default 200.\n"
+    "  -drift N                Receiver clock runs N ppm slower than the sender clock, default 0.\n\n"
+    "Synthetic trace options:\n"
+    "  -frames N               Number of frames, default 12000.\n"
+    "  -jitter N               Mean of the exponential jitter in ms, default 5.\n"
+    "  -loss N                 Random loss in percent, default 1.\n"
+    "  -spikes N               Delay spikes per minute, default 2.\n"
+    "  -seed N                 Random seed, default 1.\n"
+    "  -save FILE              Write the trace to FILE.\n\n"
+    "Decoding options:\n"
+    "  -o FILE                 Encode a test signal and write the decoded output to FILE.\n"
+    "  -bitrate N              Bitrate of the test signal, default 64000.\n";
+
+static void parseCmdl(int ac, char **av, Arguments *arg);
+static void exit_if(int condition, const char *message);
+
+static uint32_t seed;
+
+/* uniform in (0, 1) */
+static double uniform(void)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return ((double)(seed >> 8) + 0.5) / 16777216.0;
+}
+
+static Packet *generate_trace(const Arguments *arg, int64_t frame_us, int *n)
+{
+    Packet *trace = malloc(arg->frames * sizeof(Packet));
+    double  spike = 0;
+    int     i;
+
+    exit_if(!trace, "Out of memory!");
+    seed = (uint32_t)arg->seed;
+    for (i = 0; i < arg->frames; i++)
+    {
+        double delay = NETWORK_DELAY_MS - arg->jitter * log(uniform());
+
+        /* a spike holds back the following frames, they drain at twice the frame rate */
+        if (uniform() < arg->spikes * arg->frame_ms / 60000)
+        {
+            spike = MAX(spike, SPIKE_MS * (0.3 + 0.7 * uniform()));
+        }
+        delay += spike;
+        spike = MAX(spike - 2 * arg->frame_ms, 0);
+
+        trace[i].send    = i * frame_us;
+        trace[i].arrival = uniform() * 100 < arg->loss ? -1 : trace[i].send + (int64_t)(delay * 1000);
+        trace[i].index   = i;
+    }
+    *n = arg->frames;
+    return trace;
+}
+
+static Packet *read_trace(const char *file, int *n)
+{
+    FILE *  f     = fopen(file, "r");
+    Packet *trace = NULL;
+    char    line[256];
+    int     size = 0;
+
+    exit_if(!f, "Error opening trace file!");
+    *n = 0;
+    while (fgets(line, sizeof(line), f))
+    {
+        double send = 0, arrival = 0;
+        if (line[0] == '#' || sscanf(line, "%lf %lf", &send, &arrival) != 2)
+        {
+            continue;
+        }
+        if (*n == size)
+        {
+            size  = size ? 2 * size : 4096;
+            trace = realloc(trace, size * sizeof(Packet));
+            exit_if(!trace, "Out of memory!");
+        }
+        trace[*n].send    = (int64_t)(send * 1000);
+        trace[*n].arrival = arrival < 0 ? -1 : (int64_t)(arrival * 1000);
+        trace[*n].index   = *n;
+        (*n)++;
+    }
+    fclose(f);
+    exit_if(*n == 0, "Empty trace file!");
+    return trace;
+}
+
+static void save_trace(const char *file, const Packet *trace, int n)
+{
+    FILE *f = fopen(file, "w");
+    int   i;
+
+    exit_if(!f, "Error creating trace file!");
+    fprintf(f, "# send_ms arrival_ms\n");
+    for (i = 0; i < n; i++)
+    {
+        fprintf(f, "%.3f %.3f\n", trace[i].send / 1000.0, trace[i].arrival < 0 ? -1.0 : trace[i].arrival / 1000.0);
+    }
+    fclose(f);
+}
+
+static int compare_arrival(const void *a, const void *b)
+{
+    const Packet *x = a, *y = b;
+    if (x->arrival != y->arrival)
+    {
+        return (x->arrival > y->arrival) - (x->arrival < y->arrival);
+    }
+    return x->index - y->index;
+}
+
+static int compare_int64(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* two tones and noise, frame by frame */
+static void make_frame(int16_t *pcm, int frame_length, int samplerate, long frame)
+{
+    int i;
+    for (i = 0; i < frame_length; i++)
+    {
+        double t = (double)(frame * frame_length + i) / samplerate;
+        double x = 8000 * sin(2 * 3.14159265 * 440 * t) + 4000 * sin(2 * 3.14159265 * 1250 * t) +
+                   1000 * (uniform() - 0.5);
+        pcm[i] = (int16_t)x;
+    }
+}
+
+/* encode the test signal, frame i is kept at i * LC3_MAX_BYTES */
+static uint8_t *encode_frames(const Arguments *arg, int frames, int frame_length, int *frame_bytes)
+{
+    LC3_Enc *encoder = malloc(lc3_enc_get_size(arg->samplerate, 1));
+    void *   scratch = NULL;
+    uint8_t *frame_buf;
+    int16_t  pcm[LC3_MAX_SAMPLES];
+    int16_t *input16[] = {pcm};
+    int      i, nbytes = 0;
+
+    exit_if(!encoder, "Out of memory!");
+    exit_if(lc3_enc_init(encoder, arg->samplerate, 1), "Encoder init failed!");
+    exit_if(lc3_enc_set_frame_ms(encoder, arg->frame_ms), "Encoder init failed!");
+    exit_if(lc3_enc_set_bitrate(encoder, arg->bitrate), "Invalid bitrate!");
+    *frame_bytes = lc3_enc_get_num_bytes(encoder);
+    scratch      = malloc(lc3_enc_get_scratch_size(encoder));
+    frame_buf    = malloc((size_t)frames * LC3_MAX_BYTES);
+    exit_if(!scratch || !frame_buf, "Out of memory!");
+
+    seed = 1;
+    for (i = 0; i < frames; i++)
+    {
+        make_frame(pcm, frame_length, arg->samplerate, i);
+        exit_if(lc3_enc16(encoder, input16, frame_buf + (size_t)i * LC3_MAX_BYTES, &nbytes, scratch),
+                "Encoding failed!");
+        exit_if(nbytes != *frame_bytes, "Unexpected frame size!");
+    }
+    free(scratch);
+    free(encoder);
+    return frame_buf;
+}
+
+int main(int ac, char **av)
+{
+    Arguments         arg;
+    Packet *          trace = NULL, *arrivals = NULL;
+    LC3_JitterBuffer *jb      = NULL;
+    LC3_JitterStats   stats;
+    LC3_Dec *         decoder = NULL;
+    WAVEFILEOUT *     output_wav = NULL;
+    void *            scratch    = NULL;
+    uint8_t *         frames     = NULL;
+    uint8_t           packet[LC3_MAX_BYTES + TAG_BYTES];
+    int16_t           pcm[LC3_MAX_SAMPLES];
+    int16_t *         output16[] = {pcm};
+    int               sample_buf[LC3_MAX_SAMPLES];
+    int64_t *         latency = NULL, *network = NULL;
+    int64_t           frame_us, tick, end = 0, latency_sum = 0;
+    int               n = 0, i, next = 0, n_latency = 0, n_network = 0, lost = 0, frame_bytes = 0, frame_length;
+    int               ticks = 0, last = -1, last_played = -1;
+    double            tick_us;
+
+    parseCmdl(ac, av, &arg);
+
+    /* 44.1 kHz uses the 48 kHz frame length */
+    frame_length = (int)(arg.frame_ms * (arg.samplerate == 44100 ? 48000 : arg.samplerate) / 1000);
+    frame_us = (int64_t)frame_length * 1000000 / arg.samplerate;
+    tick_us  = (double)frame_length * 1000000 / arg.samplerate * (1 + arg.drift * 1e-6);
+
+    trace = arg.traceFilename ? read_trace(arg.traceFilename, &n) : generate_trace(&arg, frame_us, &n);
+    if (arg.saveFilename)
+    {
+        save_trace(arg.saveFilename, trace, n);
+    }
+
+    jb = malloc(lc3_jitter_get_size(arg.samplerate, arg.frame_ms, arg.max_delay, LC3_MAX_BYTES + TAG_BYTES));
+    exit_if(!jb, "Invalid jitter buffer configuration!");
+    exit_if(lc3_jitter_init(jb, arg.samplerate, arg.frame_ms, arg.max_delay, LC3_MAX_BYTES + TAG_BYTES),
+            "Invalid jitter buffer configuration!");
+    exit_if(lc3_jitter_set_target_loss(jb, arg.target / 100), "Invalid target loss!");
+
+    if (arg.outputFilename)
+    {
+        frames  = encode_frames(&arg, n, frame_length, &frame_bytes);
+        decoder = malloc(lc3_dec_get_size(arg.samplerate, 1, LC3_PLC_ADVANCED));
+        exit_if(!decoder, "Out of memory!");
+        exit_if(lc3_dec_init(decoder, arg.samplerate, 1, LC3_PLC_ADVANCED), "Decoder init failed!");
+        exit_if(lc3_dec_set_frame_ms(decoder, arg.frame_ms), "Decoder init failed!");
+        scratch = malloc(lc3_dec_get_scratch_size(decoder));
+        exit_if(!scratch, "Out of memory!");
+        output_wav = CreateWav(arg.outputFilename, arg.samplerate, 1, 16);
+        exit_if(!output_wav, "Error creating wav file!");
+    }
+    else
+    {
+        frame_bytes = 20; /* payload is not decoded */
+        memset(packet, 0, sizeof(packet));
+    }
+
+    /* frames in order of arrival */
+    arrivals = malloc(n * sizeof(Packet));
+    latency  = malloc(n * sizeof(int64_t));
+    network  = malloc(n * sizeof(int64_t));
+    exit_if(!arrivals || !latency || !network, "Out of memory!");
+    memcpy(arrivals, trace, n * sizeof(Packet));
+    qsort(arrivals, n, sizeof(Packet), compare_arrival);
+    for (i = 0; i < n; i++)
+    {
+        if (trace[i].arrival < 0)
+        {
+            lost++;
+        }
+        else
+        {
+            network[n_network++] = trace[i].arrival - trace[i].send;
+            end                  = MAX(end, trace[i].arrival);
+            last                 = i;
+        }
+    }
+    while (next < n && arrivals[next].arrival < 0)
+    {
+        next++;
+    }
+
+    /* receiver clock, runs until the last frame was played or could not be played anymore */
+    end += (int64_t)arg.max_delay * 1000 + 4 * frame_us;
+    for (ticks = 0; (tick = (int64_t)(ticks * tick_us)) <= end && last_played < last; ticks++)
+    {
+        int nbytes = 0;
+
+        for (; next < n && arrivals[next].arrival <= tick; next++)
+        {
+            int32_t  ts    = arrivals[next].index * frame_length;
+            uint32_t index = (uint32_t)arrivals[next].index;
+
+            if (frames)
+            {
+                memcpy(packet, frames + (size_t)index * LC3_MAX_BYTES, frame_bytes);
+            }
+            memcpy(packet + frame_bytes, &index, TAG_BYTES);
+            exit_if(lc3_jitter_put(jb, ts, (int32_t)(uint32_t)arrivals[next].arrival, packet, frame_bytes + TAG_BYTES),
+                    "lc3_jitter_put failed!");
+        }
+
+        exit_if(lc3_jitter_get(jb, (int32_t)(uint32_t)tick, packet, &nbytes), "lc3_jitter_get failed!");
+        if (nbytes > 0)
+        {
+            uint32_t index;
+            memcpy(&index, packet + nbytes - TAG_BYTES, TAG_BYTES);
+            last_played        = (int)index;
+            latency[n_latency] = tick - trace[index].send;
+            latency_sum += latency[n_latency++];
+            nbytes -= TAG_BYTES;
+        }
+        if (decoder)
+        {
+            /* same as lc3_jitter_dec16() without the index */
+            LC3_Error err = lc3_dec16(decoder, packet, nbytes, output16, scratch, nbytes == 0);
+            exit_if(err && err != LC3_DECODE_ERROR, "Decoding failed!");
+            for (i = 0; i < frame_length; i++)
+            {
+                sample_buf[i] = pcm[i];
+            }
+            WriteWavLong(output_wav, sample_buf, frame_length);
+        }
+    }
+
+    exit_if(lc3_jitter_get_stats(jb, &stats), "lc3_jitter_get_stats failed!");
+    qsort(latency, n_latency, sizeof(int64_t), compare_int64);
+    qsort(network, n_network, sizeof(int64_t), compare_int64);
+
+    printf("Frames:              %d\n", n);
+    printf("Network loss:        %.2f %%\n", 100.0 * lost / n);
+    printf("Late loss:           %.2f %%\n", 100.0 * stats.late / n);
+    printf("Concealed frames:    %.2f %% (%d lost, %d stretched)\n",
+           100.0 * (stats.concealed + stats.stretched) / MAX(stats.played + stats.concealed + stats.stretched, 1),
+           stats.concealed, stats.stretched);
+    printf("Skipped frames:      %d\n", stats.skipped);
+    printf("Dropped frames:      %d\n", stats.dropped);
+    printf("Resyncs:             %d\n", stats.resyncs);
+    if (n_latency > 0)
+    {
+        printf("Latency:             mean %.1f ms, median %.1f ms, p95 %.1f ms\n",
+               latency_sum / 1000.0 / n_latency, latency[n_latency / 2] / 1000.0,
+               latency[(n_latency * 95) / 100] / 1000.0);
+        printf("Buffer delay:        mean %.1f ms\n", stats.buffer_delay / 1000.0);
+    }
+    if (n_network > stats.late)
+    {
+        /* a fixed playout delay loses all frames slower than itself */
+        printf("Fixed delay, same loss: %.1f ms\n", network[n_network - 1 - stats.late] / 1000.0);
+    }
+
+    if (output_wav)
+    {
+        CloseWav(output_wav);
+    }
+    free(trace);
+    free(arrivals);
+    free(latency);
+    free(network);
+    free(jb);
+    free(decoder);
+    free(scratch);
+    free(frames);
+    return 0;
+}
+
+static void parseCmdl(int ac, char **av, Arguments *arg)
+{
+    int pos = 1;
+
+    memset(arg, 0, sizeof(*arg));
+    arg->samplerate = 48000;
+    arg->frame_ms   = 5;
+    arg->target     = 1;
+    arg->max_delay  = 200;
+    arg->frames     = 12000;
+    arg->jitter     = 5;
+    arg->loss       = 1;
+    arg->spikes     = 2;
+    arg->seed       = 1;
+    arg->bitrate    = 64000;
+
+    for (; pos < ac && av[pos][0] == '-'; pos++)
+    {
+        if (!strcmp(av[pos], "-h"))
+        {
+            puts(USAGE_MESSAGE);
+            exit(0);
+        }
+        else if (pos + 1 == ac)
+        {
+            exit_if(1, USAGE_MESSAGE);
+        }
+        else if (!strcmp(av[pos], "-samplerate"))
+        {
+            arg->samplerate = atoi(av[++pos]);
+        }
+        else if (!strcmp(av[pos], "-frame_ms"))
+        {
+            arg->frame_ms = (float)atof(av[++pos]);
+        }
+        else if (!strcmp(av[pos], "-target"))
+        {
+            arg->target = (float)atof(av[++pos]);
+        }
+        else if (!strcmp(av[pos], "-max_delay"))
+        {
+            arg->max_delay = atoi(av[++pos]);
+        }
+        else if (!strcmp(av[pos], "-drift"))
+        {
+            arg->drift = atof(av[++pos]);
+        }
+        else if (!strcmp(av[pos], "-frames"))
+        {
+            arg->frames = atoi(av[++pos]);
+        }
+        else if (!strcmp(av[pos], "-jitter"))
+        {
+            arg->jitter = atof(av[++pos]);
+        }
+        else if (!strcmp(av[pos], "-loss"))
+        {
+            arg->loss = atof(av[++pos]);
+        }
+        else if (!strcmp(av[pos], "-spikes"))
+        {
+            arg->spikes = atof(av[++pos]);
+        }
+        else if (!strcmp(av[pos], "-seed"))
+        {
+            arg->seed = atoi(av[++pos]);
+        }
+        else if (!strcmp(av[pos], "-save"))
+        {
+            arg->saveFilename = av[++pos];
+        }
+        else if (!strcmp(av[pos], "-o"))
+        {
+            arg->outputFilename = av[++pos];
+        }
+        else if (!strcmp(av[pos], "-bitrate"))
+        {
+            arg->bitrate = atoi(av[++pos]);
+        }
+        else
+        {
+            exit_if(1, "Unknown option!");
+        }
+    }
+
+    exit_if(pos + 1 < ac, USAGE_MESSAGE);
+    if (pos < ac)
+    {
+        arg->traceFilename = av[pos];
+    }
+    exit_if(!arg->traceFilename && arg->frames <= 0, "Invalid number of frames!");
+}
+
+/* check condition and if it fails, exit with error message */
+static void exit_if(int condition, const char *message)
+{
+    if (condition)
+    {
+        puts(message);
+        exit(1);
+    }
+}
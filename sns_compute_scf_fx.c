@@ -93,9 +93,10 @@ void processSnsComputeScf_fx(Word32 *d2_fx, Word16 d2_fx_exp, Word16 fs_idx, Wor
     nf = sub(s_max(nf, -25965), 6803);
 
 /* Log-domain */
+    BASOP_Util_Log2_16_vec(d3_fx, d3_fx_exp, d4_fx, MAX_BANDS_NUMBER);
     FOR (i = 0; i < MAX_BANDS_NUMBER; i++)
     {
-        d4_fx[i] = s_max(nf, BASOP_Util_Log2_16(d3_fx[i], d3_fx_exp[i])); 
+        d4_fx[i] = s_max(nf, d4_fx[i]); 
     }
 
     /* Downsampling */
@@ -11,8 +11,8 @@
 
 
 
-void processSnsInterpolateScf_fx(Word16 *scf_q, Word16 mdct_scf[], Word16 mdct_scf_exp[], Word16 inv_scf,
-                                 Word16 n_bands, Word8 *scratchBuffer)
+static inline void processSnsInterpolateScf_body(Word16 *scf_q, Word16 mdct_scf[], Word16 mdct_scf_exp[],
+                                                 Word16 inv_scf, Word16 n_bands, Word8 *scratchBuffer)
 {
     Dyn_Mem_Deluxe_In(
         Word16  i, tmp2;
@@ -83,11 +83,25 @@ void processSnsInterpolateScf_fx(Word16 *scf_q, Word16 mdct_scf[], Word16 mdct_s
     }
 
 /* Linear Domain */
-    FOR (i = 0; i < n_bands; i++)
-    {
-        mdct_scf[i] = BASOP_Util_InvLog2_16(scf_int[i], &mdct_scf_exp[i]);
-    }
+    BASOP_Util_InvLog2_16_vec(scf_int, mdct_scf, mdct_scf_exp, n_bands);
 
     Dyn_Mem_Deluxe_Out();
 }
 
+/* generic version for configurations without specialized kernels, see kernels_cfg.h */
+void processSnsInterpolateScf_fx(Word16 *scf_q, Word16 mdct_scf[], Word16 mdct_scf_exp[], Word16 inv_scf,
+                                 Word16 n_bands, Word8 *scratchBuffer)
+{
+    processSnsInterpolateScf_body(scf_q, mdct_scf, mdct_scf_exp, inv_scf, n_bands, scratchBuffer);
+}
+
+/* one instance per configuration, fs_idx, frame_dms and bands_number are constants */
+#define SNS_INTERPOLATE_SCF_CFG(cfg, cfg_fs_idx, cfg_frame_dms, cfg_bands_number)                                      \
+    void processSnsInterpolateScf_##cfg##_fx(Word16 *scf_q, Word16 mdct_scf[], Word16 mdct_scf_exp[],                  \
+                                             Word16 inv_scf, Word16 n_bands, Word8 *scratchBuffer)                     \
+    {                                                                                                                  \
+        UNUSED(n_bands);                                                                                               \
+        processSnsInterpolateScf_body(scf_q, mdct_scf, mdct_scf_exp, inv_scf, cfg_bands_number, scratchBuffer);        \
+    }
+
+LC3_KERNEL_CONFIGS(SNS_INTERPOLATE_SCF_CFG)
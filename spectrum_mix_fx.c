@@ -0,0 +1,90 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+#include "functions.h"
+
+
+/* copy an external spectrum to the encoder spectrum, leaving the headroom of processMdct_fx() output */
+void processSpectrumInput_fx(Word32 x[], Word16 x_exp, Word32 y[], Word16 *y_exp, Word16 len)
+{
+    Dyn_Mem_Deluxe_In(
+        Counter i;
+        Word16  s;
+    );
+
+    s = getScaleFactor32(x, len);
+    s = sub(s, SPEC_IN_HEADROOM);
+
+    FOR (i = 0; i < len; i++)
+    {
+        y[i] = L_shl(x[i], s);
+    }
+    *y_exp = sub(x_exp, s);
+
+    Dyn_Mem_Deluxe_Out();
+}
+
+/* y = y + gain * 2^gain_exp * x, y is renormalized. The exponents of zero or not normalized inputs
+   do not limit the precision, e.g. of a mix that was set to zero with any exponent to start it */
+void processSpectrumMix_fx(Word32 y[], Word16 *y_exp, const Word32 x[], Word16 x_exp, Word16 gain, Word16 gain_exp,
+                           Word16 len)
+{
+    Dyn_Mem_Deluxe_In(
+        Counter i;
+        Word16  e, ey, sx, sy, nx, s;
+        Word32  L_peak, L_peak_x;
+    );
+
+    L_peak   = 0;
+    L_peak_x = 0;
+    FOR (i = 0; i < len; i++)
+    {
+        L_peak   = L_max(L_peak, L_abs(y[i]));
+        L_peak_x = L_max(L_peak_x, L_abs(x[i]));
+    }
+
+    test();
+    IF (L_peak_x == 0 || gain == 0)
+    {
+        Dyn_Mem_Deluxe_Out();
+        return; /* nothing to add */
+    }
+
+    /* exponents of the normalized inputs, one bit of headroom for the sum */
+    nx    = norm_l(L_peak_x);
+    x_exp = sub(add(x_exp, gain_exp), nx);
+    ey    = x_exp;
+    if (L_peak != 0)
+    {
+        ey = sub(*y_exp, norm_l(L_peak));
+    }
+    e  = add(s_max(ey, x_exp), 1);
+    sy = s_max(s_min(sub(e, *y_exp), 31), -31); /* negative shifts up a not normalized y, the limits only apply to a zero y */
+    sx = s_min(sub(e, x_exp), 31);
+    L_peak = 0;
+
+    FOR (i = 0; i < len; i++)
+    {
+        y[i]   = L_add(L_shr(y[i], sy), L_shr(Mpy_32_16(L_shl(x[i], nx), gain), sx));
+        L_peak = L_max(L_peak, L_abs(y[i]));
+    }
+
+    s = norm_l(L_peak);
+    if (L_peak == 0)
+    {
+        s = 0;
+    }
+    FOR (i = 0; i < len; i++)
+    {
+        y[i] = L_shl(y[i], s);
+    }
+    *y_exp = sub(e, s);
+
+    Dyn_Mem_Deluxe_Out();
+}
@@ -17,9 +17,9 @@ static Word32 FIRLattice(Word16 order, const Word16 *parCoeff /*Q15*/, Word32 *s
 
 /*************************************************************************/
 
-void processTnsCoder_fx(Word16 *bits, Word16 indexes[], Word32 x[], Word16 BW_cutoff_idx, Word16 order[],
-                        Word16 *numfilters, Word16 enable_lpc_weighting, Word16 nSubdivisions, Word16 frame_dms,
-                        Word16 maxLen, Word8 *scratchBuffer)
+static inline void processTnsCoder_body(Word16 *bits, Word16 indexes[], Word32 x[], Word16 BW_cutoff_idx,
+                                        Word16 order[], Word16 *numfilters, Word16 enable_lpc_weighting,
+                                        Word16 nSubdivisions, Word16 frame_dms, Word16 maxLen, Word8 *scratchBuffer)
 {
     Dyn_Mem_Deluxe_In(
         Word16 *      tmpbuf;
@@ -239,6 +239,31 @@ void processTnsCoder_fx(Word16 *bits, Word16 indexes[], Word32 x[], Word16 BW_cu
     Dyn_Mem_Deluxe_Out();
 }
 
+/* generic version for configurations without specialized kernels, see kernels_cfg.h */
+void processTnsCoder_fx(Word16 *bits, Word16 indexes[], Word32 x[], Word16 BW_cutoff_idx, Word16 order[],
+                        Word16 *numfilters, Word16 enable_lpc_weighting, Word16 nSubdivisions, Word16 frame_dms,
+                        Word16 maxLen, Word8 *scratchBuffer)
+{
+    processTnsCoder_body(bits, indexes, x, BW_cutoff_idx, order, numfilters, enable_lpc_weighting, nSubdivisions,
+                         frame_dms, maxLen, scratchBuffer);
+}
+
+/* one instance per configuration, frame_dms, the subdivision count and the frame length are constants */
+#define TNS_CODER_CFG(cfg, cfg_fs_idx, cfg_frame_dms, cfg_bands_number)                                                \
+    void processTnsCoder_##cfg##_fx(Word16 *bits, Word16 indexes[], Word32 x[], Word16 BW_cutoff_idx, Word16 order[],  \
+                                    Word16 *numfilters, Word16 enable_lpc_weighting, Word16 nSubdivisions,             \
+                                    Word16 frame_dms, Word16 maxLen, Word8 *scratchBuffer)                             \
+    {                                                                                                                  \
+        UNUSED(nSubdivisions);                                                                                         \
+        UNUSED(frame_dms);                                                                                             \
+        UNUSED(maxLen);                                                                                                \
+        processTnsCoder_body(bits, indexes, x, BW_cutoff_idx, order, numfilters, enable_lpc_weighting,                 \
+                             cfg_frame_dms == 100 ? 3 : 2, cfg_frame_dms,                                              \
+                             LC3_CFG_FRAME_LENGTH(cfg_fs_idx, cfg_frame_dms), scratchBuffer);                          \
+    }
+
+LC3_KERNEL_CONFIGS(TNS_CODER_CFG)
+
 /*************************************************************************/
 
 static void Parcor2Index(const Word16 parCoeff[] /*Q15*/, Word16 index[], Word16 order)
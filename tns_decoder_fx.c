@@ -15,8 +15,8 @@ static Word32 IIRLattice(Word16 order, const Word16 *parCoeff, Word32 *state, Wo
 
 /*************************************************************************/
 
-void processTnsDecoder_fx(Word16 rc_idx[], Word32 x[], Word16 xLen, Word16 order[], Word16 *x_e, Word16 BW_stopband_idx,
-                          Word16 frame_dms, Word8 *scratchBuffer)
+static inline void processTnsDecoder_body(Word16 rc_idx[], Word32 x[], Word16 xLen, Word16 order[], Word16 *x_e,
+                                          Word16 BW_stopband_idx, Word16 frame_dms, Word8 *scratchBuffer)
 {
     Dyn_Mem_Deluxe_In(
         Word32 *state;
@@ -130,3 +130,20 @@ static Word32 IIRLattice(Word16 order, const Word16 *parCoeff, Word32 *state, Wo
     return x;
 }
 
+/* generic version for configurations without specialized kernels, see kernels_cfg.h */
+void processTnsDecoder_fx(Word16 rc_idx[], Word32 x[], Word16 xLen, Word16 order[], Word16 *x_e, Word16 BW_stopband_idx,
+                          Word16 frame_dms, Word8 *scratchBuffer)
+{
+    processTnsDecoder_body(rc_idx, x, xLen, order, x_e, BW_stopband_idx, frame_dms, scratchBuffer);
+}
+
+/* one instance per configuration, fs_idx, frame_dms and bands_number are constants */
+#define TNS_DECODER_CFG(cfg, cfg_fs_idx, cfg_frame_dms, cfg_bands_number)                                              \
+    void processTnsDecoder_##cfg##_fx(Word16 rc_idx[], Word32 x[], Word16 xLen, Word16 order[], Word16 *x_e,           \
+                                      Word16 BW_stopband_idx, Word16 frame_dms, Word8 *scratchBuffer)                  \
+    {                                                                                                                  \
+        UNUSED(frame_dms);                                                                                             \
+        processTnsDecoder_body(rc_idx, x, xLen, order, x_e, BW_stopband_idx, cfg_frame_dms, scratchBuffer);            \
+    }
+
+LC3_KERNEL_CONFIGS(TNS_DECODER_CFG)
@@ -0,0 +1,189 @@
+/******************************************************************************
+*                        ETSI TS 103 634 V1.1.1                               *
+*              Low Complexity Communication Codec Plus (LC3plus)              *
+*                                                                             *
+* Copyright licence is solely granted through ETSI Intellectual Property      *
+* Rights Policy, 3rd April 2019. No patent licence is granted by implication, *
+* estoppel or otherwise.                                                      *
+******************************************************************************/
+
+
+#include "functions.h"
+
+
+/* bits of the TNS side information, same count as processTnsCoder_fx() */
+static Word16 transrate_tns_bits(Word16 tns_numfilters, const Word16 *tns_order, const Word16 *indexes,
+                                 Word16 enable_lpc_weighting)
+{
+    Dyn_Mem_Deluxe_In(
+        Counter i, j;
+        Word16  bits;
+        Word32  L_tmp;
+    );
+
+    bits = 0;
+    FOR (j = 0; j < tns_numfilters; j++)
+    {
+        IF (tns_order[j] > 0)
+        {
+            L_tmp = L_deposit_l(ac_tns_order_bits[enable_lpc_weighting][tns_order[j] - 1]);
+            FOR (i = 0; i < tns_order[j]; i++)
+            {
+                L_tmp = L_add(L_tmp, L_deposit_l(ac_tns_coef_bits[i][indexes[MAXLAG * j + i]]));
+            }
+            bits = add(bits, add(2, extract_l(L_shr_pos(L_sub(L_tmp, 1), 11))));
+        }
+        ELSE
+        {
+            bits = add(bits, 1);
+        }
+    }
+
+    Dyn_Mem_Deluxe_Out();
+    return bits;
+}
+
+/* returns 0 or 1 if the frame could not be decoded and bytes_out was not written */
+static Word16 Transrate_LC3_Channel(LC3_Enc *encoder, LC3_Dec *decoder, int channel, UWord8 *bytes_in,
+                                    UWord8 *bytes_out, Word8 *scratchBuffer)
+{
+    Dyn_Mem_Deluxe_In(
+        Word16    d_fx_exp, scale, fill_bits, nf_seed, gg_idx, fac_ns_idx;
+        Word16    bp_side, mask_side;
+        Word16    tns_numfilters, lsbMode, lastnz, BW_cutoff_idx, zero_frame, bfi, spec_inv_idx;
+        Word16    ltpf_bits;
+        Word16    tns_order[TNS_NUMFILTERS_MAX], ltpf_idx[3];
+        Word32 *  d_fx, *L_scf_idx;
+        Word16 *  indexes, *sqQdec, *resBitBuf;
+        Word8 *   codingScratch, *currentScratch;
+        EncSetup *h_EncSetup;
+        DecSetup *h_DecSetup;
+    );
+
+    h_EncSetup   = encoder->channel_setup[channel];
+    h_DecSetup   = decoder->channel_setup[channel];
+    bfi          = 0;
+    spec_inv_idx = 0;
+    d_fx_exp     = 0;
+
+    /* BUFFER INITIALISATION. Same layout as Enc_LC3_Channel(), the decoder buffers overlap the coding scratch */
+    d_fx      = scratchAlign(scratchBuffer, 0); /* Size = 4 * MAX_LEN bytes */
+    L_scf_idx = scratchAlign(
+        d_fx, sizeof(*d_fx) * s_max(80, encoder->frame_length)); /* Size = 4 * SCF_MAX_PARAM -> aligned to 32 bytes */
+    indexes       = scratchAlign(L_scf_idx,
+                           sizeof(*L_scf_idx) * SCF_MAX_PARAM); /* Size = 2 * TNS_NUMFILTERS_MAX * MAXLAG = 32 bytes */
+    codingScratch = scratchAlign(indexes, sizeof(*indexes) * (TNS_NUMFILTERS_MAX * MAXLAG)); /* Size = 10 * MAX_LEN */
+    sqQdec        = scratchAlign(codingScratch, 0);                                /* Size = 2 * MAX_LEN bytes */
+    resBitBuf     = scratchAlign(sqQdec, sizeof(*sqQdec) * decoder->frame_length); /* Size = 2 * MAX_LEN bytes */
+    currentScratch = scratchAlign(resBitBuf, sizeof(*resBitBuf) * decoder->frame_length); /* Size = 4 * MAX_LEN */
+
+    BASOP_sub_start("Transrater");
+
+    BASOP_sub_start("Entropy dec");
+    processDecoderEntropy_fx(bytes_in, &bp_side, &mask_side, h_DecSetup->total_bits, decoder->yLen, decoder->fs_idx,
+                             decoder->BW_cutoff_bits, &tns_numfilters, &lsbMode, &lastnz, &bfi, tns_order, &fac_ns_idx,
+                             &gg_idx, &BW_cutoff_idx, ltpf_idx, L_scf_idx, decoder->frame_dms);
+    BASOP_sub_end();
+
+    BASOP_sub_start("Ari dec");
+    IF (bfi == 0)
+    {
+        processAriDecoder_fx(bytes_in, &bp_side, &mask_side, h_DecSetup->total_bits, decoder->yLen, decoder->fs_idx,
+                             h_DecSetup->enable_lpc_weighting, tns_numfilters, lsbMode, lastnz, &bfi, tns_order,
+                             fac_ns_idx, gg_idx, decoder->frame_dms, decoder->n_pc, decoder->be_bp_left,
+                             decoder->be_bp_right, 0, &spec_inv_idx, &scale, &fill_bits, sqQdec, &nf_seed, resBitBuf,
+                             indexes, &zero_frame, currentScratch);
+    }
+    BASOP_sub_end();
+
+    IF (bfi != 0)
+    {
+        /* nothing to carry over, the receiver conceals the frame */
+        BASOP_sub_end(); /* Transrater */
+        Dyn_Mem_Deluxe_Out();
+        return 1;
+    }
+
+    /* dequantized spectrum in the domain the encoder quantizes in, after shaping and TNS filtering */
+    BASOP_sub_start("Spectrum dec");
+    processAriDecoderScaling_fx(sqQdec, decoder->yLen, d_fx, &d_fx_exp);
+    processResidualDecoding_fx(d_fx, d_fx_exp, decoder->yLen, resBitBuf, fill_bits);
+    /* the noise factor is estimated again from the filled spectrum */
+    IF (zero_frame == 0)
+    {
+        decoder->kernels->noise_filling(d_fx, nf_seed, d_fx_exp, fac_ns_idx, BW_cutoff_idx, decoder->frame_dms, 0,
+                                        spec_inv_idx, currentScratch);
+    }
+    processApplyGlobalGain_fx(d_fx, &d_fx_exp, decoder->yLen, gg_idx, h_DecSetup->quantizedGainOff);
+    BASOP_sub_end();
+    /* end sqQdec, resBitBuf */
+
+    BASOP_sub_start("Side info");
+    h_EncSetup->tns_bits =
+        transrate_tns_bits(tns_numfilters, tns_order, indexes, h_EncSetup->enable_lpc_weighting);
+    ltpf_bits = 1;
+    IF (ltpf_idx[0] != 0)
+    {
+        ltpf_bits = 11;
+    }
+    IF (h_EncSetup->ltpf_enable == 0)
+    {
+        ltpf_idx[1] = 0;
+    }
+    BASOP_sub_end();
+
+    /* the coding memories follow the input frames */
+    h_EncSetup->silence_bytes = 0;
+
+    /* codingScratch Size = 10 * MAX_LEN bytes */
+    Enc_LC3_CodeSpectrum(encoder, h_EncSetup, d_fx, d_fx_exp, BW_cutoff_idx, tns_numfilters, tns_order, indexes,
+                         ltpf_idx, ltpf_bits, L_scf_idx, bytes_out, codingScratch, 0);
+
+    BASOP_sub_end(); /* Transrater */
+
+    Dyn_Mem_Deluxe_Out();
+    return 0;
+}
+
+/* re-quantize a frame to the bitrate of the encoder, decoder is only used for the bitrate setup of the input.
+   num_bytes_out is 0 if the input frame is lost or broken */
+LC3_Error Transrate_LC3(LC3_Enc *encoder, LC3_Dec *decoder, UWord8 *input, int num_bytes, UWord8 *output,
+                        int *num_bytes_out, void *scratch)
+{
+    int       ch = 0, bfi = 0, lc3_num_bytes = 0;
+    LC3_Error err = LC3_OK;
+
+    *num_bytes_out = 0;
+    if (num_bytes == 0)
+    {
+        return LC3_DECODE_ERROR;
+    }
+
+    for (ch = 0; ch < decoder->channels && !bfi; ch++)
+    {
+        lc3_num_bytes = num_bytes / decoder->channels + (ch < (num_bytes % decoder->channels));
+
+        if (lc3_num_bytes != decoder->channel_setup[ch]->last_size)
+        {
+            /* a frame size no encoder can produce is a broken frame, not a setup error */
+            err = update_dec_bitrate(decoder, ch, lc3_num_bytes);
+            if (err)
+            {
+                bfi = 1;
+                break;
+            }
+            decoder->channel_setup[ch]->last_size = lc3_num_bytes;
+        }
+
+        bfi = Transrate_LC3_Channel(encoder, decoder, ch, input, output + *num_bytes_out, scratch);
+        input += decoder->channel_setup[ch]->targetBytes;
+        *num_bytes_out += encoder->channel_setup[ch]->targetBytes;
+    }
+
+    if (bfi)
+    {
+        *num_bytes_out = 0;
+        return LC3_DECODE_ERROR;
+    }
+    return LC3_OK;
+}